@@ -0,0 +1,337 @@
+#!/usr/bin/env python3
+# Copyright 2022, Juan Manuel Cruz.
+# All rights reserved.
+#
+# This file is part of the freertos_app_Example projects.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+"""Token table builder and decoder for the tokenized console (log_Token.h).
+
+Build the table after each firmware build (the token of a string is its
+offset from _srodata, so the table belongs to one .elf):
+
+    log_token.py table Debug/freertos_app_Example001.elf -o tokens.json
+
+Decode a capture of the console (a file, a serial device set to raw
+115200 8N1, or stdin):
+
+    log_token.py decode --table tokens.json /dev/ttyACM0
+    log_token.py decode --elf Debug/freertos_app_Example001.elf capture.bin
+
+Ticks travel as deltas, so the absolute times are right when the capture
+starts at reset; a capture started later keeps the right spacing.
+
+Only the standard library is used.
+"""
+
+import argparse
+import bisect
+import json
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+SYMBOL_PATTERN = re.compile(r'^pcText')
+
+
+# ------ ELF reader ----------------------------------------------------
+
+class Elf:
+    """Minimal little endian ELF32/ELF64 reader: sections and symbols."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[5] != 1:
+            raise ValueError('%s: not a little endian ELF file' % path)
+        self.is64 = self.data[4] == 2
+        if self.is64:
+            shoff, = struct.unpack_from('<Q', self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x3A)
+        else:
+            shoff, = struct.unpack_from('<I', self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            off = shoff + i * shentsize
+            if self.is64:
+                name, stype, flags, addr, offset, size, link = \
+                    struct.unpack_from('<IIQQQQI', self.data, off)
+            else:
+                name, stype, flags, addr, offset, size, link = \
+                    struct.unpack_from('<IIIIIII', self.data, off)
+            self.sections.append(dict(name=name, type=stype, flags=flags,
+                                      addr=addr, offset=offset, size=size, link=link))
+        names = self.sections[shstrndx]
+        for s in self.sections:
+            s['name'] = self._cstring(names['offset'] + s['name'])
+
+    def _cstring(self, offset):
+        end = self.data.index(b'\0', offset)
+        return self.data[offset:end].decode('latin-1')
+
+    def _loaded(self):
+        # SHF_ALLOC sections that have file contents (not NOBITS).
+        return [s for s in self.sections if s['flags'] & 0x2 and s['type'] != 8 and s['addr']]
+
+    def read(self, addr, size):
+        for s in self._loaded():
+            if s['addr'] <= addr and addr + size <= s['addr'] + s['size']:
+                off = s['offset'] + addr - s['addr']
+                return self.data[off:off + size]
+        return None
+
+    def string_at(self, addr):
+        for s in self._loaded():
+            if s['addr'] <= addr < s['addr'] + s['size']:
+                off = s['offset'] + addr - s['addr']
+                end = self.data.find(b'\0', off, s['offset'] + s['size'])
+                if end < 0:
+                    return None
+                return self.data[off:end].decode('latin-1')
+        return None
+
+    def symbols(self, kinds=(1,)):
+        for s in self.sections:
+            if s['type'] != 2:   # SHT_SYMTAB
+                continue
+            strtab = self.sections[s['link']]
+            entsize = 24 if self.is64 else 16
+            for off in range(s['offset'], s['offset'] + s['size'], entsize):
+                if self.is64:
+                    name, info, _, _, value, size = struct.unpack_from('<IBBHQQ', self.data, off)
+                else:
+                    name, value, size, info = struct.unpack_from('<IIIB', self.data, off)
+                if info & 0xF in kinds:   # STT_OBJECT by default
+                    yield self._cstring(strtab['offset'] + name), value, size
+
+    def rodata_base(self):
+        """_srodata from the linker script, else the start of .rodata."""
+        for name, value, _ in self.symbols(kinds=(0, 1)):   # STT_NOTYPE
+            if name == '_srodata':
+                return value
+        for s in self._loaded():
+            if s['name'] == '.rodata':
+                return s['addr']
+        raise ValueError('no _srodata symbol or .rodata section')
+
+    def rodata_strings(self):
+        """Start address and text of every printable string in .rodata."""
+        for s in self._loaded():
+            if not s['name'].startswith('.rodata'):
+                continue
+            blob = self.data[s['offset']:s['offset'] + s['size']]
+            for m in re.finditer(rb'[\t\n\r\x20-\x7e]+\0', blob):
+                yield s['addr'] + m.start(), m.group()[:-1].decode('latin-1')
+
+
+# ------ table -----------------------------------------------------------
+
+def build_table(elf):
+    base = elf.rodata_base()
+    tokens, symbols = {}, {}
+    for addr, text in elf.rodata_strings():
+        tokens[addr - base] = text
+    pointer = 8 if elf.is64 else 4
+    for name, value, size in elf.symbols():
+        if not SYMBOL_PATTERN.match(name) or size != pointer:
+            continue
+        raw = elf.read(value, pointer)
+        if raw is None:
+            continue
+        target = int.from_bytes(raw, 'little')
+        text = elf.string_at(target)
+        if text is not None and 0 <= target - base <= 0xFFFF:
+            tokens[target - base] = text
+            symbols[target - base] = name
+    return {'base': '0x%08x' % base,
+            'tokens': {'0x%04x' % t: s for t, s in sorted(tokens.items()) if t <= 0xFFFF},
+            'symbols': {'0x%04x' % t: n for t, n in sorted(symbols.items())}}
+
+
+class Resolver:
+    def __init__(self, table=None, elf=None):
+        self.elf = elf
+        self.base = elf.rodata_base() if elf is not None else 0
+        self.tokens = {}
+        if table:
+            self.tokens = {int(a, 16): t for a, t in table['tokens'].items()}
+        self.starts = sorted(self.tokens)
+
+    def __call__(self, token):
+        if token in self.tokens:
+            return self.tokens[token]
+        if self.elf is not None:
+            text = self.elf.string_at(self.base + token)
+            if text is not None:
+                return text
+        # The linker may point a short literal into the tail of a longer one.
+        i = bisect.bisect_right(self.starts, token) - 1
+        if i >= 0:
+            start = self.starts[i]
+            text = self.tokens[start]
+            if token - start < len(text):
+                return text[token - start:]
+        return '<token 0x%04x>' % token
+
+
+# ------ decoder ---------------------------------------------------------
+
+def varint(buf, pos):
+    """Value and next position of the varint at buf[pos], None if cut."""
+    value = shift = 0
+    while pos < len(buf) and shift < 35:
+        byte = buf[pos]
+        value |= (byte & 0x7F) << shift
+        pos += 1
+        if not byte & 0x80:
+            return value & 0xFFFFFFFF, pos
+        shift += 7
+    return None
+
+
+def record_size(buf):
+    """Size of the record at buf[0], 0 if buf is cut short, -1 if bad."""
+    kind = chr(buf[1])
+    if kind == 'T':
+        return buf[2] + 4 if len(buf) >= 3 and len(buf) >= buf[2] + 4 else 0
+    if kind not in 'SNW':
+        return -1
+    pos = 4
+    fields = 2 if kind == 'N' else 1
+    for _ in range(fields):
+        if pos >= len(buf):
+            return 0
+        got = varint(buf, pos)
+        if got is None:
+            return 0 if len(buf) - pos < 5 else -1
+        pos = got[1]
+    if kind == 'W':
+        pos += 2
+    return pos + 1 if pos < len(buf) else 0
+
+
+def decode(stream, resolve, ticks=False):
+    """Yield (consumed bytes, text) for every valid record in stream."""
+    buf = bytearray()
+    tick = [0]
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            break
+        buf += chunk
+        while True:
+            start = buf.find(SYNC)
+            if start < 0:
+                buf.clear()
+                break
+            del buf[:start]
+            if len(buf) < 2:
+                break
+            size = record_size(buf)
+            if size == 0:
+                break
+            check = 0
+            if size > 0:
+                for b in buf[1:size - 1]:
+                    check ^= b
+            if size < 0 or check != buf[size - 1]:
+                del buf[:1]   # not a record start, resync on the next 0xA5
+                continue
+            record = bytes(buf[:size])
+            del buf[:size]
+            yield size, render(record, resolve, ticks, tick)
+
+
+def render(record, resolve, ticks, tick):
+    """Text of one record; tick[0] carries the running tick."""
+    kind = chr(record[1])
+    if kind == 'T':
+        return record[3:-1].decode('latin-1')
+    token, = struct.unpack_from('<H', record, 2)
+    delta, pos = varint(record, 4)
+    tick[0] = (tick[0] + delta) & 0xFFFFFFFF
+    prefix = '[%8u] ' % tick[0] if ticks else ''
+    if kind == 'S':
+        return prefix + resolve(token)
+    if kind == 'N':
+        arg, _ = varint(record, pos)
+        return '%s%s %u\r\n' % (prefix, resolve(token), arg)
+    arg, = struct.unpack_from('<H', record, pos)
+    return 'At time %u: %s %s\r\n' % (tick[0], resolve(token), resolve(arg))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest='command', required=True)
+
+    p = sub.add_parser('table', help='build the token table from an .elf')
+    p.add_argument('elf')
+    p.add_argument('-o', '--output', default='-')
+
+    p = sub.add_parser('decode', help='turn a token capture back into text')
+    p.add_argument('input', nargs='?', default='-')
+    p.add_argument('--table', help='table written by the table command')
+    p.add_argument('--elf', help='read the strings straight from the .elf')
+    p.add_argument('--ticks', action='store_true', help='prefix records with their tick')
+    p.add_argument('--stats', action='store_true',
+                   help='print wire bytes vs text bytes on stderr at the end')
+
+    args = parser.parse_args()
+
+    if args.command == 'table':
+        table = build_table(Elf(args.elf))
+        out = sys.stdout if args.output == '-' else open(args.output, 'w')
+        json.dump(table, out, indent=1)
+        out.write('\n')
+        return
+
+    if not args.table and not args.elf:
+        parser.error('decode needs --table or --elf')
+    table = json.load(open(args.table)) if args.table else None
+    resolve = Resolver(table, Elf(args.elf) if args.elf else None)
+    stream = sys.stdin.buffer if args.input == '-' else open(args.input, 'rb', buffering=0)
+
+    wire = text = 0
+    try:
+        for size, line in decode(stream, resolve, args.ticks):
+            wire += size
+            text += len(line)
+            sys.stdout.write(line.replace('\r\n', '\n'))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    if args.stats and wire:
+        sys.stderr.write('wire bytes: %u  text bytes: %u  ratio: %.2f\n'
+                         % (wire, text, float(text) / wire))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+# Copyright 2022, Juan Manuel Cruz.
+# All rights reserved.
+#
+# This file is part of the freertos_app_Example projects.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+"""Convert a trace recorder dump (trace_Recorder.h) to Chrome trace JSON.
+
+Dump xTraceBuffer from the debugger, or from the host simulation:
+
+    (gdb) dump binary value trace.bin xTraceBuffer
+    ./build/Example002/sim_Example002 -T trace.bin
+
+then convert it and open the result in ui.perfetto.dev or
+chrome://tracing:
+
+    trace_to_json.py trace.bin -o trace.json
+
+Each task becomes a thread with one slice per time it ran; queue,
+semaphore and mutex operations are instant events on the task that
+made them (or on "ISR"), and every queue gets a counter track with the
+number of items in it.
+
+Only the standard library is used.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = 0x31435254
+HEADER = struct.Struct('<8I')
+OBJECT = struct.Struct('<II32s')
+EVENT = struct.Struct('<III')
+
+# eTraceEvent_t
+SWITCHED_IN, SWITCHED_OUT, QUEUE_SEND, QUEUE_SEND_FAILED, QUEUE_RECEIVE, \
+    QUEUE_RECEIVE_FAILED, BLOCKING_ON_SEND, BLOCKING_ON_RECEIVE, \
+    QUEUE_SEND_FROM_ISR, QUEUE_RECEIVE_FROM_ISR, TASK_DELAY, TASK_DELETE = range(1, 13)
+
+# eTraceObject_t
+KIND_NAMES = {0: 'queue', 1: 'mutex', 2: 'semaphore', 3: 'semaphore', 4: 'mutex', 16: 'task'}
+
+# Verb used for a send/receive, by object kind.
+VERBS = {
+    'queue': ('send', 'receive'),
+    'mutex': ('give', 'take'),
+    'semaphore': ('give', 'take'),
+}
+
+PID = 1
+ISR_TID = 0
+
+
+# ------ dump reader -----------------------------------------------------
+
+def read_dump(data):
+    magic, clock, event_count, object_count, _recording, head, used, lost = \
+        HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError('not a trace recorder dump (magic 0x%08x)' % magic)
+    need = HEADER.size + object_count * OBJECT.size + event_count * EVENT.size
+    if len(data) < need:
+        raise ValueError('dump is %u bytes, expected %u' % (len(data), need))
+
+    objects = {}
+    offset = HEADER.size
+    for i in range(object_count):
+        handle, kind, name = OBJECT.unpack_from(data, offset + i * OBJECT.size)
+        if i < used:
+            name = name.split(b'\0', 1)[0].decode('latin-1')
+            objects[handle] = (KIND_NAMES.get(kind, 'queue'), name or '0x%08x' % handle)
+
+    offset += object_count * OBJECT.size
+    first = max(0, head - event_count)
+    events = []
+    for n in range(first, head):
+        slot = n & (event_count - 1)
+        events.append(EVENT.unpack_from(data, offset + slot * EVENT.size))
+
+    return clock or 1, objects, events, head - first, lost
+
+
+def unwrap(events):
+    """32-bit cycle stamps to a monotonic count. Deltas are taken as signed,
+    so an interrupt that stamped an event slightly out of order does not
+    look like a wrap."""
+    total = 0
+    previous = None
+    for stamp, handle, info in events:
+        if previous is not None:
+            delta = (stamp - previous) & 0xFFFFFFFF
+            if delta >= 0x80000000:
+                delta -= 0x100000000
+            total += delta
+        previous = stamp
+        yield total, handle, info >> 24, info & 0xFFFFFF
+
+
+# ------ converter -------------------------------------------------------
+
+def convert(clock, objects, events):
+    mhz = clock / 1e6
+    tids = {}
+    out = []
+
+    def tid_of(handle):
+        if handle not in tids:
+            tids[handle] = len(tids) + 1
+            kind, name = objects.get(handle, ('task', '0x%08x' % handle))
+            out.append({'ph': 'M', 'pid': PID, 'tid': tids[handle], 'name': 'thread_name',
+                        'args': {'name': name}})
+        return tids[handle]
+
+    def name_of(handle):
+        return objects.get(handle, ('queue', '0x%08x' % handle))
+
+    out.append({'ph': 'M', 'pid': PID, 'name': 'process_name', 'args': {'name': 'FreeRTOS'}})
+    out.append({'ph': 'M', 'pid': PID, 'tid': ISR_TID, 'name': 'thread_name',
+                'args': {'name': 'ISR / before scheduler'}})
+
+    current = None
+    running_since = None
+    first_ts = None
+    last_ts = 0.0
+
+    for cycles, handle, kind, arg in unwrap(events):
+        ts = cycles / mhz
+        if first_ts is None:
+            first_ts = ts
+        last_ts = ts
+
+        if kind == SWITCHED_IN:
+            current, running_since = handle, ts
+        elif kind == SWITCHED_OUT:
+            # A dump that starts mid-slice opens it at the first event.
+            start = running_since if current == handle else first_ts
+            out.append({'ph': 'X', 'pid': PID, 'tid': tid_of(handle), 'ts': start,
+                        'dur': max(ts - start, 0.0), 'name': objects.get(handle, ('', '0x%08x' % handle))[1]})
+            current = running_since = None
+        elif kind in (TASK_DELAY, TASK_DELETE):
+            out.append({'ph': 'i', 's': 't', 'pid': PID, 'tid': tid_of(handle), 'ts': ts,
+                        'name': 'delay' if kind == TASK_DELAY else 'delete'})
+        else:
+            obj_kind, obj_name = name_of(handle)
+            send, receive = VERBS.get(obj_kind, VERBS['queue'])
+            after = arg
+            if kind in (QUEUE_SEND, QUEUE_SEND_FROM_ISR):
+                label, after = send, arg + 1
+            elif kind in (QUEUE_RECEIVE, QUEUE_RECEIVE_FROM_ISR):
+                label, after = receive, arg - 1
+            elif kind == QUEUE_SEND_FAILED:
+                label = send + ' failed'
+            elif kind == QUEUE_RECEIVE_FAILED:
+                label = receive + ' failed'
+            elif kind == BLOCKING_ON_SEND:
+                label = 'block on ' + send
+            elif kind == BLOCKING_ON_RECEIVE:
+                label = 'block on ' + receive
+            else:
+                continue
+            isr = kind in (QUEUE_SEND_FROM_ISR, QUEUE_RECEIVE_FROM_ISR)
+            tid = ISR_TID if isr or current is None else tid_of(current)
+            out.append({'ph': 'i', 's': 't', 'pid': PID, 'tid': tid, 'ts': ts,
+                        'name': '%s %s' % (label, obj_name),
+                        'args': {'object': obj_name, 'kind': obj_kind, 'items before': arg}})
+            out.append({'ph': 'C', 'pid': PID, 'ts': ts, 'name': obj_name,
+                        'args': {'items': after}})
+
+    # Close the slice of the task that was running when the dump was taken.
+    if current is not None:
+        out.append({'ph': 'X', 'pid': PID, 'tid': tid_of(current), 'ts': running_since,
+                    'dur': last_ts - running_since, 'name': objects.get(current, ('', '0x%08x' % current))[1]})
+
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('dump', help='binary copy of xTraceBuffer')
+    parser.add_argument('-o', '--output', default='-')
+    args = parser.parse_args()
+
+    with open(args.dump, 'rb') as f:
+        clock, objects, events, count, lost = read_dump(f.read())
+
+    trace = convert(clock, objects, events)
+    out = sys.stdout if args.output == '-' else open(args.output, 'w')
+    json.dump({'traceEvents': trace, 'displayTimeUnit': 'ns'}, out)
+    out.write('\n')
+
+    sys.stderr.write('%u events, %u objects%s, %.0f MHz time stamps\n'
+                     % (count, len(objects),
+                        ' (%u not named, table full)' % lost if lost else '', clock / 1e6))
+
+
+if __name__ == '__main__':
+    main()
@@ -50,19 +50,23 @@
 #endif
 
 // ------ inclusions ---------------------------------------------------
+#include "task_Signal.h"
 
 // ------ macros -------------------------------------------------------
 
 // ------ typedef ------------------------------------------------------
 
 // ------ external data declaration ------------------------------------
-/* Declare a variable of type xSemaphoreHandle.  This is used to reference the
- * semaphore that is used to synchronize a task with other task. */
-extern xSemaphoreHandle xBinarySemaphoreEntry_A;
-extern xSemaphoreHandle xBinarySemaphoreExit_A;
+/* Declare a variable of type TaskSignal_t.  This is used to reference the
+ * signal that is used to synchronize a task with other task. */
+extern TaskSignal_t xSignalEntry_A;
+extern TaskSignal_t xSignalExit_A;
+
+extern TaskSignal_t xSignalEntry_B;
+extern TaskSignal_t xSignalExit_B;
 
-extern xSemaphoreHandle xBinarySemaphoreEntry_B;
-extern xSemaphoreHandle xBinarySemaphoreExit_B;
+/* Heap taken by the signals, none with taskSIGNAL_NOTIFY */
+extern size_t xSignalHeap;
 
 /* Declare a variable of type xSemaphoreHandle.  This is used to reference the
  * mutex type semaphore that is used to ensure mutual exclusive access to...*/
@@ -52,6 +52,73 @@
 // ------ inclusions ---------------------------------------------------
 
 // ------ macros -------------------------------------------------------
+/* Set to 1 to run every TEST_X scenario TEST_BENCHMARK_RUNS times, without
+ * the 5000 mS wait, and print the heap taken by the signals and their
+ * hand-off latency histograms instead of the demo. Build it with and
+ * without taskSIGNAL_NOTIFY to compare semaphores and notifications. */
+#ifndef TEST_BENCHMARK
+	#define TEST_BENCHMARK		( 0 )
+#endif
+
+#ifndef TEST_BENCHMARK_RUNS
+	#define TEST_BENCHMARK_RUNS	( 1000 )
+#endif
+
+/* Set to 1 to drive tasks A and B with TEST_TRAFFIC_EVENTS events of the
+ * traffic generator (traffic_Gen.h) instead of the demo, and print the
+ * events per second, the signals lost on a full signal and the
+ * give to take latency. Gate 0 is A and gate 1 is B. With
+ * TEST_TRAFFIC_SCRIPT 1 the events are the ones of the TEST_X scenario,
+ * in order, with the timing of the generator. */
+#ifndef TEST_TRAFFIC
+	#define TEST_TRAFFIC			( 0 )
+#endif
+
+#if( ( TEST_TRAFFIC != 0 ) && ( TEST_BENCHMARK != 0 ) )
+	#error TEST_TRAFFIC and TEST_BENCHMARK can not be used together
+#endif
+
+#ifndef TEST_TRAFFIC_EVENTS
+	#define TEST_TRAFFIC_EVENTS		( 10000 )
+#endif
+
+/* Mean events per second, 0 sends them back to back. */
+#ifndef TEST_TRAFFIC_RATE
+	#define TEST_TRAFFIC_RATE		( 2000 )
+#endif
+
+#ifndef TEST_TRAFFIC_PATTERN
+	#define TEST_TRAFFIC_PATTERN	trafficPOISSON
+#endif
+
+#ifndef TEST_TRAFFIC_BURST
+	#define TEST_TRAFFIC_BURST		( 8 )
+#endif
+
+/* trafficGATES_WEIGHTED takes TEST_TRAFFIC_WEIGHTS, e.g. { 3, 1 }, or
+ * gives A twice the weight of B. */
+#ifndef TEST_TRAFFIC_GATES
+	#define TEST_TRAFFIC_GATES		trafficGATES_UNIFORM
+#endif
+
+#ifndef TEST_TRAFFIC_ENTRY_PERCENT
+	#define TEST_TRAFFIC_ENTRY_PERCENT	( 50 )
+#endif
+
+#ifndef TEST_TRAFFIC_SEED
+	#define TEST_TRAFFIC_SEED		( 1 )
+#endif
+
+#ifndef TEST_TRAFFIC_SCRIPT
+	#define TEST_TRAFFIC_SCRIPT		( 0 )
+#endif
+
+/* Tasks A and B call this as soon as an Entry or Exit take returns. */
+#if( ( TEST_BENCHMARK == 1 ) || ( TEST_TRAFFIC == 1 ) )
+	#define TEST_HAND_OFF( pxSignal )		vTask_TestHandOff( pxSignal )
+#else
+	#define TEST_HAND_OFF( pxSignal )
+#endif
 
 // ------ typedef ------------------------------------------------------
 
@@ -60,6 +127,7 @@
 // ------ external functions declaration -------------------------------
 
 void vTask_Test( void *pvParameters );
+void vTask_TestHandOff( TaskSignal_t *pxSignal );
 
 #ifdef __cplusplus
 }
@@ -62,6 +62,7 @@
 
 /* Application & Tasks includes. */
 #include "app.h"
+#include "app_Resources.h"
 #include "task_A.h"
 #include "task_B.h"
 #include "task_Test.h"
@@ -69,12 +70,15 @@
 // ------ Macros and definitions ---------------------------------------
 
 // ------ internal data declaration ------------------------------------
-/* Declare a variable of type xSemaphoreHandle.  This is used to reference the
- * semaphore that is used to synchronize a task with other task. */
-xSemaphoreHandle xBinarySemaphoreEntry_A;
-xSemaphoreHandle xBinarySemaphoreEntry_B;
-xSemaphoreHandle xBinarySemaphoreExit_A;
-xSemaphoreHandle xBinarySemaphoreExit_B;
+/* Declare a variable of type TaskSignal_t.  This is used to reference the
+ * signal that is used to synchronize a task with other task. */
+TaskSignal_t xSignalEntry_A;
+TaskSignal_t xSignalEntry_B;
+TaskSignal_t xSignalExit_A;
+TaskSignal_t xSignalExit_B;
+
+/* Heap taken by the signals, none with taskSIGNAL_NOTIFY */
+size_t xSignalHeap;
 
 /* Declare a variable of type xSemaphoreHandle.  This is used to reference the
  * mutex type semaphore that is used to ensure mutual exclusive access to ........ */
@@ -104,27 +108,20 @@ void appInit( void )
 	/* Print out the name of this Example. */
   	vPrintString( pcTextForMain );
 
-    /* Before a semaphore is used it must be explicitly created.
-     * In this example a binary semaphore is created. */
-    vSemaphoreCreateBinary( xBinarySemaphoreEntry_A );
-    vSemaphoreCreateBinary( xBinarySemaphoreExit_A  );
-
-    vSemaphoreCreateBinary( xBinarySemaphoreEntry_B );
-    vSemaphoreCreateBinary( xBinarySemaphoreExit_B  );
-
-    /* Check the semaphore was created successfully. */
-	configASSERT( xBinarySemaphoreEntry_A !=  NULL );
-	configASSERT( xBinarySemaphoreExit_A  !=  NULL );
+    size_t xFree = xPortGetFreeHeapSize();
 
-	configASSERT( xBinarySemaphoreEntry_B !=  NULL );
-	configASSERT( xBinarySemaphoreExit_B  !=  NULL );
+    /* Before a signal is used it must be explicitly created.
+     * In this example a binary signal is created for the task whose handle
+     * is given: a binary semaphore, or the task notification with
+     * taskSIGNAL_NOTIFY (task_Signal.h). The creation is checked and the
+     * semaphore added to the registry by vTaskSignalCreate(). */
+    vTaskSignalCreate( &xSignalEntry_A, 1, &vTask_AHandle, "xBinarySemaphoreEntry_A" );
+    vTaskSignalCreate( &xSignalExit_A,  1, &vTask_AHandle, "xBinarySemaphoreExit_A" );
 
-    /* Add semaphore to registry. */
-	vQueueAddToRegistry(xBinarySemaphoreEntry_A, "xBinarySemaphoreEntry_A");
-    vQueueAddToRegistry(xBinarySemaphoreExit_A,  "xBinarySemaphoreExit_A");
+    vTaskSignalCreate( &xSignalEntry_B, 1, &vTask_BHandle, "xBinarySemaphoreEntry_B" );
+    vTaskSignalCreate( &xSignalExit_B,  1, &vTask_BHandle, "xBinarySemaphoreExit_B" );
 
-    vQueueAddToRegistry(xBinarySemaphoreEntry_B, "xBinarySemaphoreEntry_B");
-    vQueueAddToRegistry(xBinarySemaphoreExit_B,  "xBinarySemaphoreExit_B");
+    xSignalHeap = xFree - xPortGetFreeHeapSize();
 
     /* Before a semaphore is used it must be explicitly created.
      * In this example a mutex semaphore is created. */
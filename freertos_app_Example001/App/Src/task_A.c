@@ -63,6 +63,7 @@
 /* Application includes. */
 #include "app_Resources.h"
 #include "task_A.h"
+#include "task_Test.h"
 
 // ------ Macros and definitions ---------------------------------------
 
@@ -97,22 +98,23 @@ void vTask_A( void *pvParameters )
 
 	/* As per most tasks, this task is implemented within an infinite loop.
 	 *
-	 * Take the semaphore once to start with so the semaphore is empty before the
-	 * infinite loop is entered.  The semaphore was created before the scheduler
+	 * Take the signal once to start with so the signal is empty before the
+	 * infinite loop is entered.  The signal was created before the scheduler
 	 * was started so before this task ran for the first time.*/
-    xSemaphoreTake( xBinarySemaphoreEntry_A, (portTickType) 0 );
-    xSemaphoreTake( xBinarySemaphoreExit_A, (portTickType) 0 );
+    xTaskSignalTake( &xSignalEntry_A, (portTickType) 0 );
+    xTaskSignalTake( &xSignalExit_A, (portTickType) 0 );
     while( 1 )
     {
 	    /* Toggle LD3 state */
 		HAL_GPIO_TogglePin( LD3_GPIO_Port, LD3_Pin );
 
-        /* Use the semaphore to wait for the event.  The task blocks
+        /* Use the signal to wait for the event.  The task blocks
          * indefinitely meaning this function call will only return once the
-         * semaphore has been successfully obtained - so there is no need to check
+         * signal has been successfully obtained - so there is no need to check
          * the returned value. */
     	vPrintString( pcTextForTask_A_WaitEntry_A );
-    	xSemaphoreTake( xBinarySemaphoreEntry_A, portMAX_DELAY );
+    	xTaskSignalTake( &xSignalEntry_A, portMAX_DELAY );
+    	TEST_HAND_OFF( &xSignalEntry_A );
         {
     		/* The semaphore is created before the scheduler is started so already
     		 * exists by the time this task executes.
@@ -128,7 +130,8 @@ void vTask_A( void *pvParameters )
         		/* The following line will only execute once the semaphore has been
         		 * successfully obtained. */
     			vPrintString( pcTextForTask_A_WaitExit_A );
-        		xSemaphoreTake( xBinarySemaphoreExit_A,  portMAX_DELAY );
+        		xTaskSignalTake( &xSignalExit_A, portMAX_DELAY );
+        		TEST_HAND_OFF( &xSignalExit_A );
         		{
         			/* 'Give' the semaphore to unblock the tasks. */
         			vPrintString( pcTextForTask_A_SignalMutex );
@@ -63,6 +63,7 @@
 /* Application includes. */
 #include "app_Resources.h"
 #include "task_B.h"
+#include "task_Test.h"
 
 // ------ Macros and definitions ---------------------------------------
 
@@ -97,23 +98,24 @@ void vTask_B( void *pvParameters )
 
 	/* As per most tasks, this task is implemented within an infinite loop.
 	 *
-	 * Take the semaphore once to start with so the semaphore is empty before the
-	 * infinite loop is entered.  The semaphore was created before the scheduler
+	 * Take the signal once to start with so the signal is empty before the
+	 * infinite loop is entered.  The signal was created before the scheduler
 	 * was started so before this task ran for the first time.*/
-	xSemaphoreTake( xBinarySemaphoreEntry_B, (portTickType) 0 );
-    xSemaphoreTake( xBinarySemaphoreExit_B, (portTickType) 0 );
+	xTaskSignalTake( &xSignalEntry_B, (portTickType) 0 );
+    xTaskSignalTake( &xSignalExit_B, (portTickType) 0 );
 
     while( 1 )
     {
 	    /* Toggle LD2 state */
 		HAL_GPIO_TogglePin( LD2_GPIO_Port, LD2_Pin );
 
-		/* Use the semaphore to wait for the event.  The task blocks
+		/* Use the signal to wait for the event.  The task blocks
          * indefinitely meaning this function call will only return once the
-         * semaphore has been successfully obtained - so there is no need to check
+         * signal has been successfully obtained - so there is no need to check
          * the returned value. */
 		vPrintString( pcTextForTask_B_WaitEntry_B );
-        xSemaphoreTake( xBinarySemaphoreEntry_B, portMAX_DELAY );
+        xTaskSignalTake( &xSignalEntry_B, portMAX_DELAY );
+        TEST_HAND_OFF( &xSignalEntry_B );
         {
         	/* The semaphore is created before the scheduler is started so already
     		 * exists by the time this task executes.
@@ -129,7 +131,8 @@ void vTask_B( void *pvParameters )
         		/* The following line will only execute once the semaphore has been
         		 * successfully obtained. */
         		vPrintString( pcTextForTask_B_WaitExit_B );
-        		xSemaphoreTake( xBinarySemaphoreExit_B,  portMAX_DELAY );
+        		xTaskSignalTake( &xSignalExit_B, portMAX_DELAY );
+        		TEST_HAND_OFF( &xSignalExit_B );
            		{
         		 	/* 'Give' the semaphore to unblock the tasks. */
         			vPrintString( pcTextForTask_B_SignalMutex );
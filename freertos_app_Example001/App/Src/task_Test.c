@@ -59,6 +59,9 @@
 
 /* Demo includes. */
 #include "supporting_Functions.h"
+#include "cycle_Counter.h"
+#include "bench_Stats.h"
+#include "traffic_Gen.h"
 
 /* Application includes. */
 #include "app_Resources.h"
@@ -70,7 +73,25 @@
 /* Events to excite tasks */
 typedef enum eTask_Test {Error, Entry_A, Entry_B, Exit_A, Exit_B} eTask_Test_t;
 
+/* One TEST_X scenario: the events to excite tasks and how many there are */
+typedef struct
+{
+	const eTask_Test_t *peArray;
+	uint32_t ulLength;
+} eTask_TestScenario_t;
+
 // ------ internal functions declaration -------------------------------
+static BaseType_t prvTask_TestSignal( eTask_Test_t eEvent, bool bVerbose );
+#if( ( TEST_BENCHMARK == 1 ) || ( TEST_TRAFFIC == 1 ) )
+static int32_t prvTask_TestSignalIndex( TaskSignal_t *pxSignal );
+static void prvTask_TestDiscard( const char *pcData, size_t xLength );
+#endif
+#if( TEST_BENCHMARK == 1 )
+static void prvTask_TestBenchmark( void );
+#endif
+#if( TEST_TRAFFIC == 1 )
+static void prvTask_TestTraffic( void );
+#endif
 
 // ------ internal data definition -------------------------------------
 /* Define the strings that will be passed in as the Supporting Functions parameters.
@@ -91,54 +112,292 @@ const char *pcTextForTask_Test_Wait5000mS       	= "  <=> Task Test - Wait:   50
 
 #define TEST_X ( 1 )
 
-#if( TEST_X == 0 )
-/* Array of events to excite tasks */
-const eTask_Test_t eTask_TestArray[] = { Error, Exit_B+1, Exit_B+2 };
+/* Arrays of events to excite tasks, TEST_X selects one of them */
+const eTask_Test_t eTask_TestArray_0[] = { Error, Exit_B+1, Exit_B+2 };
+const eTask_Test_t eTask_TestArray_1[] = { Entry_A, Exit_A, Entry_A, Exit_A };
+const eTask_Test_t eTask_TestArray_2[] = { Entry_A, Entry_A, Exit_A, Exit_A };
+const eTask_Test_t eTask_TestArray_3[] = { Entry_B, Exit_B, Entry_B, Exit_B };
+const eTask_Test_t eTask_TestArray_4[] = { Entry_B, Entry_B, Exit_B, Exit_B };
+const eTask_Test_t eTask_TestArray_5[] = { Entry_A, Exit_A, Entry_B, Exit_B };
+const eTask_Test_t eTask_TestArray_6[] = { Entry_B, Exit_B, Entry_A, Exit_A };
+const eTask_Test_t eTask_TestArray_7[] = { Entry_A, Entry_B, Exit_A, Exit_B };
+const eTask_Test_t eTask_TestArray_8[] = { Entry_B, Entry_A, Exit_B, Exit_A };
+
+#define TEST_ARRAY( x )	{ eTask_TestArray_##x, sizeof( eTask_TestArray_##x ) / sizeof( eTask_Test_t ) }
+
+const eTask_TestScenario_t eTask_TestScenario[] = { TEST_ARRAY( 0 ), TEST_ARRAY( 1 ), TEST_ARRAY( 2 ),
+													TEST_ARRAY( 3 ), TEST_ARRAY( 4 ), TEST_ARRAY( 5 ),
+													TEST_ARRAY( 6 ), TEST_ARRAY( 7 ), TEST_ARRAY( 8 ) };
+
+#define TEST_SCENARIOS	( sizeof( eTask_TestScenario ) / sizeof( eTask_TestScenario_t ) )
+
+#if( TEST_BENCHMARK == 1 )
+const char *pcTextForTask_Test_Benchmark			= "  <=> Task Test - Benchmark: runs per TEST_X :";
+const char *pcTextForTask_Test_BenchmarkClock		= "  <=> Task Test - Benchmark: core clock (Hz) :";
+const char *pcTextForTask_Test_BenchmarkHeap		= "  <=> Task Test - Benchmark: signals heap (bytes) :";
+const char *pcTextForTask_Test_BenchmarkDone		= "  <=> Task Test - Benchmark: done\r\n\n";
 #endif
 
-#if( TEST_X == 1 )
-/* Array of events to excite tasks */
-const eTask_Test_t eTask_TestArray[] = { Entry_A, Exit_A, Entry_A, Exit_A };
+#if( TEST_TRAFFIC == 1 )
+const char *pcTextForTask_Test_Traffic				= "  <=> Task Test - Traffic: %s %lu/s burst %lu, gates %s, %lu%% entries, seed %lu\r\n";
+const char *pcTextForTask_Test_TrafficScript		= "  <=> Task Test - Traffic: events of TEST_X :";
+const char *pcTextForTask_Test_TrafficClock			= "  <=> Task Test - Traffic: core clock (Hz) :";
+const char *pcTextForTask_Test_TrafficRun			= "  <=> Task Test - Traffic: events %lu in %lu mS, %lu events/s\r\n";
+const char *pcTextForTask_Test_TrafficDrops			= "  <=> Task Test - Traffic: signals %lu, lost on a full signal %lu, errors %lu\r\n";
+const char *pcTextForTask_Test_TrafficDone			= "  <=> Task Test - Traffic: done\r\n\n";
+
+/* Gate weights for trafficGATES_WEIGHTED, A then B */
+#ifdef TEST_TRAFFIC_WEIGHTS
+static const uint8_t ucTask_TestWeights[] = TEST_TRAFFIC_WEIGHTS;
+	#define TEST_TRAFFIC_WEIGHT_TABLE	ucTask_TestWeights
+#else
+	#define TEST_TRAFFIC_WEIGHT_TABLE	NULL
 #endif
-
-#if( TEST_X == 2 )
-/* Array of events to excite tasks */
-const eTask_Test_t eTask_TestArray[] = { Entry_A, Entry_A, Exit_A, Exit_A };
 #endif
 
-#if( TEST_X == 3 )
-/* Array of events to excite tasks */
-const eTask_Test_t eTask_TestArray[] = { Entry_B, Exit_B, Entry_B, Exit_B };
+#if( ( TEST_BENCHMARK == 1 ) || ( TEST_TRAFFIC == 1 ) )
+/* Hand-off latency of each signal, indexed by ( signal - Entry_A ). */
+#define TEST_SIGNALS	( Exit_B - Entry_A + 1 )
+
+const char *pcTextForTask_Test_HandOff[ TEST_SIGNALS ] = { "Entry_A", "Entry_B", "Exit_A ", "Exit_B " };
+
+static BenchStats_t xTask_TestHandOff[ TEST_SIGNALS ];
+static uint32_t ulTask_TestGiveStamp[ TEST_SIGNALS ];
+static bool bTask_TestGivePending[ TEST_SIGNALS ];
 #endif
 
-#if( TEST_X == 4 )
-/* Array of events to excite tasks */
-const eTask_Test_t eTask_TestArray[] = { Entry_B, Entry_B, Exit_B, Exit_B };
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+/* 'Give' the signal that excites the task waiting for eEvent,
+ * pdFAIL for an error event or a signal that is still full */
+static BaseType_t prvTask_TestSignal( eTask_Test_t eEvent, bool bVerbose )
+{
+	TaskSignal_t *pxSignal;
+	const char *pcText;
+
+	switch( eEvent ) {
+
+		case Entry_A:
+
+			pcText = pcTextForTask_Test_SignalEntry_A;
+			pxSignal = &xSignalEntry_A;
+			break;
+
+		case Entry_B:
+
+			pcText = pcTextForTask_Test_SignalEntry_B;
+			pxSignal = &xSignalEntry_B;
+			break;
+
+		case Exit_A:
+
+			pcText = pcTextForTask_Test_SignalExit_A;
+			pxSignal = &xSignalExit_A;
+			break;
+
+		case Exit_B:
+
+			pcText = pcTextForTask_Test_SignalExit_B;
+			pxSignal = &xSignalExit_B;
+			break;
+
+		case Error:
+		default:
+
+			pcText = pcTextForTask_Test_SignalError;
+			pxSignal = NULL;
+			break;
+	}
+
+	if( bVerbose )
+	{
+		vPrintString( pcText );
+	}
+
+	if( pxSignal == NULL )
+	{
+		return pdFAIL;
+	}
+
+#if( ( TEST_BENCHMARK == 1 ) || ( TEST_TRAFFIC == 1 ) )
+	/* A give on a signal that is still full is lost, keep the stamp
+	 * of the one that is pending. */
+	if( uxTaskSignalCount( pxSignal ) == 0 )
+	{
+		ulTask_TestGiveStamp[ eEvent - Entry_A ] = ulCycleCounterGet();
+		bTask_TestGivePending[ eEvent - Entry_A ] = true;
+	}
 #endif
+	/* 'Give' the signal to unblock the task. */
+	return xTaskSignalGive( pxSignal );
+}
+
+#if( ( TEST_BENCHMARK == 1 ) || ( TEST_TRAFFIC == 1 ) )
+/*------------------------------------------------------------------*/
+static int32_t prvTask_TestSignalIndex( TaskSignal_t *pxSignal )
+{
+	if( pxSignal == &xSignalEntry_A ) return Entry_A - Entry_A;
+	if( pxSignal == &xSignalEntry_B ) return Entry_B - Entry_A;
+	if( pxSignal == &xSignalExit_A )  return Exit_A  - Entry_A;
+	if( pxSignal == &xSignalExit_B )  return Exit_B  - Entry_A;
+	return -1;
+}
 
-#if( TEST_X == 5 )
-/* Array of events to excite tasks */
-const eTask_Test_t eTask_TestArray[] = { Entry_A, Exit_A, Entry_B, Exit_B };
+/*------------------------------------------------------------------*/
+/* Console sink that throws away the task A and B lines while measuring */
+static void prvTask_TestDiscard( const char *pcData, size_t xLength )
+{
+	( void ) pcData;
+	( void ) xLength;
+}
 #endif
 
-#if (TEST_X == 6)
-/* Array of events to excite tasks */
-const eTask_Test_t eTask_TestArray[] = { Entry_B, Exit_B, Entry_A, Exit_A };
+#if( TEST_BENCHMARK == 1 )
+/*------------------------------------------------------------------*/
+/* Run every TEST_X scenario TEST_BENCHMARK_RUNS times and print the
+ * hand-off latency of each signal. Task Test blocks for one tick right
+ * after each give, as it does in the demo, so a sample covers the give,
+ * the context switch and the return of the matching take. */
+static void prvTask_TestBenchmark( void )
+{
+	uint32_t ulScenario, ulRun, i;
+
+	vCycleCounterInit();
+
+	vPrintStringAndNumber( pcTextForTask_Test_Benchmark, TEST_BENCHMARK_RUNS );
+	vPrintStringAndNumber( pcTextForTask_Test_BenchmarkClock, SystemCoreClock );
+
+	/* TEST_X 0 only sends errors, there is nothing to hand off. */
+	for( ulScenario = 1; ulScenario < TEST_SCENARIOS; ulScenario++ )
+	{
+		for( i = 0; i < TEST_SIGNALS; i++ )
+		{
+			vBenchStatsReset( &xTask_TestHandOff[ i ] );
+		}
+
+		vLogSetSink( prvTask_TestDiscard );
+		for( ulRun = 0; ulRun < TEST_BENCHMARK_RUNS; ulRun++ )
+		{
+			for ( i = 0; i < eTask_TestScenario[ ulScenario ].ulLength; i++ )
+			{
+				prvTask_TestSignal( eTask_TestScenario[ ulScenario ].peArray[ i ], false );
+				vTaskDelay( 1 );
+			}
+		}
+		vLogSetSink( NULL );
+
+		vPrintStringAndNumber( pcTextForTask_Test_TEST_X, ulScenario );
+		for( i = 0; i < TEST_SIGNALS; i++ )
+		{
+			vBenchStatsPrint( pcTextForTask_Test_HandOff[ i ], "cycles", &xTask_TestHandOff[ i ] );
+		}
+	}
+
+	vPrintStringAndNumber( pcTextForTask_Test_BenchmarkHeap, xSignalHeap );
+	vPrintString( pcTextForTask_Test_BenchmarkDone );
+}
 #endif
 
-#if (TEST_X == 7)
-/* Array of events to excite tasks */
-const eTask_Test_t eTask_TestArray[] = { Entry_A, Entry_B, Exit_A, Exit_B };
+#if( TEST_TRAFFIC == 1 )
+/*------------------------------------------------------------------*/
+/* Send TEST_TRAFFIC_EVENTS events of the traffic generator and print
+ * the rate achieved, the signals lost and the hand-off latency of each
+ * signal. Task Test runs below tasks A and B, so a give runs the task
+ * it wakes up before the next event is sent. */
+static void prvTask_TestTraffic( void )
+{
+	char cLine[ 96 ];
+	const TrafficConfig_t xConfig = { TEST_TRAFFIC_PATTERN, TEST_TRAFFIC_GATES, TEST_TRAFFIC_ENTRY_PERCENT,
+									  TEST_TRAFFIC_RATE, TEST_TRAFFIC_BURST, 2, TEST_TRAFFIC_WEIGHT_TABLE,
+									  TEST_TRAFFIC_SEED };
+	TrafficGen_t xGen;
+	TrafficEvent_t xEvent;
+	eTask_Test_t eEvent;
+	uint32_t ulEvent, ulNow, ulLast, ulSignals = 0, ulLost = 0, ulErrors = 0, i;
+	uint64_t ullCycles = 0;
+	UBaseType_t uxPriority = uxTaskPriorityGet( NULL );
+	TickType_t xStart;
+
+	vCycleCounterInit();
+
+	snprintf( cLine, sizeof( cLine ), pcTextForTask_Test_Traffic, pcTrafficGenPattern( xConfig.ucPattern ),
+			  ( unsigned long ) xConfig.ulRate, ( unsigned long ) xConfig.ulBurst, pcTrafficGenGates( xConfig.ucGates ),
+			  ( unsigned long ) xConfig.ucEntryPercent, ( unsigned long ) xConfig.ulSeed );
+	vPrintString( cLine );
+#if( TEST_TRAFFIC_SCRIPT == 1 )
+	vPrintStringAndNumber( pcTextForTask_Test_TrafficScript, TEST_X );
 #endif
+	vPrintStringAndNumber( pcTextForTask_Test_TrafficClock, SystemCoreClock );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	for( i = 0; i < TEST_SIGNALS; i++ )
+	{
+		vBenchStatsReset( &xTask_TestHandOff[ i ] );
+	}
+
+	vLogSetSink( prvTask_TestDiscard );
+	vTaskPrioritySet( NULL, tskIDLE_PRIORITY + 1UL );
 
-#if (TEST_X == 8)
-/* Array of events to excite tasks */
-const eTask_Test_t eTask_TestArray[] = { Entry_B, Entry_A, Exit_B, Exit_A };
+	vTrafficGenInit( &xGen, &xConfig );
+	xStart = xTaskGetTickCount();
+	ulLast = ulCycleCounterGet();
+	for( ulEvent = 0; ulEvent < TEST_TRAFFIC_EVENTS; ulEvent++ )
+	{
+		vTrafficGenNext( &xGen, &xEvent );
+#if( TEST_TRAFFIC_SCRIPT == 1 )
+		eEvent = eTask_TestScenario[ TEST_X ].peArray[ ulEvent % eTask_TestScenario[ TEST_X ].ulLength ];
+#else
+		eEvent = ( xEvent.ucEntry != 0 ) ? ( ( xEvent.ulGate == 0 ) ? Entry_A : Entry_B ) :
+										   ( ( xEvent.ulGate == 0 ) ? Exit_A : Exit_B );
 #endif
+		vTrafficGenWait( xStart, &xEvent );
 
-// ------ external data definition -------------------------------------
+		if( ( eEvent < Entry_A ) || ( eEvent > Exit_B ) )
+		{
+			ulErrors++;
+		}
+		else
+		{
+			ulSignals++;
+			if( prvTask_TestSignal( eEvent, false ) != pdPASS )
+			{
+				ulLost++;
+			}
+		}
 
-// ------ internal functions definition --------------------------------
+		/* Wall time, in steps shorter than a cycle counter wrap */
+		ulNow = ulCycleCounterGet();
+		ullCycles += ulNow - ulLast;
+		ulLast = ulNow;
+	}
+
+	/* The last takes come in, and the drain throws away their lines. */
+	vTaskDelay( pdMS_TO_TICKS( 100 ) );
+	vTaskPrioritySet( NULL, uxPriority );
+	vLogSetSink( NULL );
+
+	snprintf( cLine, sizeof( cLine ), pcTextForTask_Test_TrafficRun, ( unsigned long ) TEST_TRAFFIC_EVENTS,
+			  ( unsigned long )( ( ullCycles * 1000 ) / SystemCoreClock ),
+			  ( unsigned long )( ( ( uint64_t ) TEST_TRAFFIC_EVENTS * SystemCoreClock ) / ( ullCycles ? ullCycles : 1 ) ) );
+	vPrintString( cLine );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	snprintf( cLine, sizeof( cLine ), pcTextForTask_Test_TrafficDrops,
+			  ( unsigned long ) ulSignals, ( unsigned long ) ulLost, ( unsigned long ) ulErrors );
+	vPrintString( cLine );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	for( i = 0; i < TEST_SIGNALS; i++ )
+	{
+		vBenchStatsPrint( pcTextForTask_Test_HandOff[ i ], "cycles", &xTask_TestHandOff[ i ] );
+	}
+
+	vPrintString( pcTextForTask_Test_TrafficDone );
+}
+#endif
 
 // ------ external functions definition --------------------------------
 
@@ -173,10 +432,18 @@ void vTask_Test( void *pvParameters )
 	vPrintStringAndNumber( pcTextForTask_Test_priority, uxPriority );
 	vTaskPrioritySet( vTask_TestHandle, uxPriority );
 
+#if( TEST_BENCHMARK == 1 )
+	prvTask_TestBenchmark();
+	vTaskDelete( NULL );
+#elif( TEST_TRAFFIC == 1 )
+	prvTask_TestTraffic();
+	vTaskDelete( NULL );
+#endif
+
 	while( 1 )
 	{
 		/* Scanning the array of events to excite tasks */
-		for ( i = 0; i < (sizeof(eTask_TestArray)/sizeof(eTask_Test_t)); i++ )
+		for ( i = 0; i < eTask_TestScenario[ TEST_X ].ulLength; i++ )
 		{
 		    /* Toggle LD1 state */
 			HAL_GPIO_TogglePin( LD1_GPIO_Port, LD1_Pin );
@@ -184,42 +451,8 @@ void vTask_Test( void *pvParameters )
 			vPrintTwoStrings( pcTaskGetName( vTask_TestHandle ), "- Running" );
 			vPrintStringAndNumber( pcTextForTask_Test_eTask_TestArrayIndex, i);
 
-			switch( eTask_TestArray[i] ) {
-
-	    		case Entry_A:
-
-				    /* 'Give' the semaphore to unblock the task A. */
-	    			vPrintString( pcTextForTask_Test_SignalEntry_A );
-	    			xSemaphoreGive( xBinarySemaphoreEntry_A );
-	    			break;
-
-	    		case Entry_B:
-
-				    /* 'Give' the semaphore to unblock the task B. */
-	    			vPrintString( pcTextForTask_Test_SignalEntry_B );
-	    			xSemaphoreGive( xBinarySemaphoreEntry_B );
-	    			break;
-
-	    		case Exit_A:
-
-				    /* 'Give' the semaphore to unblock the task A. */
-	    			vPrintString( pcTextForTask_Test_SignalExit_A );
-	    			xSemaphoreGive( xBinarySemaphoreExit_A );
-	    			break;
-
-	    		case Exit_B:
+			prvTask_TestSignal( eTask_TestScenario[ TEST_X ].peArray[ i ], true );
 
-				    /* 'Give' the semaphore to unblock the task B. */
-	    			vPrintString( pcTextForTask_Test_SignalExit_B );
-	    			xSemaphoreGive( xBinarySemaphoreExit_B );
-	    			break;
-
-		    	case Error:
-		    	default:
-
-		    		vPrintString( pcTextForTask_Test_SignalError );
-		    		break;
-		    }
 		    /* About a 5000 mS delay here */
 			/* We want this task to execute exactly every 5000 milliseconds.  As per
 			 * the vTaskDelay() function, time is measured in ticks, and the
@@ -232,6 +465,29 @@ void vTask_Test( void *pvParameters )
 	}
 }
 
+#if( ( TEST_BENCHMARK == 1 ) || ( TEST_TRAFFIC == 1 ) )
+/*------------------------------------------------------------------*/
+/* Called by tasks A and B as soon as an Entry or Exit take returns */
+void vTask_TestHandOff( TaskSignal_t *pxSignal )
+{
+	uint32_t ulNow = ulCycleCounterGet();
+	int32_t lIndex = prvTask_TestSignalIndex( pxSignal );
+
+	configASSERT( lIndex >= 0 );
+
+	/* Task Test may preempt us and give the same signal again. */
+	taskENTER_CRITICAL();
+	{
+		if( bTask_TestGivePending[ lIndex ] )
+		{
+			bTask_TestGivePending[ lIndex ] = false;
+			vBenchStatsAdd( &xTask_TestHandOff[ lIndex ], ulNow - ulTask_TestGiveStamp[ lIndex ] );
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+#endif
+
 /*------------------------------------------------------------------*-
   ---- END OF FILE -------------------------------------------------
 -*------------------------------------------------------------------*/
@@ -138,6 +138,13 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Scheduler trace recorder, define traceRECORDER_ENABLE as 1 to record (see trace_Recorder.h). */
+#include "trace_Recorder.h"
+/* Run time stats clocked by the DWT cycle counter (see run_Stats.h). */
+#include "cycle_Counter.h"
+#define configGENERATE_RUN_TIME_STATS            1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vCycleCounterInit()
+#define portGET_RUN_TIME_COUNTER_VALUE()         ulCycleCounterGet()
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,81 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example001
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    cycle_Counter.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Cycle Counter Header file.
+
+    Free running core clock counter (DWT CYCCNT) for timing short code
+    paths. It wraps every 2^32 cycles (about 23 s at 180 MHz), so keep
+    the differences of two readings short.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __CYCLE_COUNTER_H
+#define __CYCLE_COUNTER_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+
+// ------ macros -------------------------------------------------------
+
+// ------ typedef ------------------------------------------------------
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Enable the counter. May be called more than once. */
+void vCycleCounterInit( void );
+
+/* Current count, in core clock cycles (SystemCoreClock per second). */
+uint32_t ulCycleCounterGet( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CYCLE_COUNTER_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
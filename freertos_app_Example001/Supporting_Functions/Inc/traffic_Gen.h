@@ -0,0 +1,134 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example001
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    traffic_Gen.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Traffic Generator Header file.
+
+    Vehicle events for Task Test, from a seeded xorshift32 generator so
+    a run can be repeated exactly. Each event has an arrival time, a
+    kind (entry or exit) and a gate:
+    - arrivals are Poisson (exponential gaps), bursts of back to back
+      events starting as a Poisson process, or periodic, at a mean
+      rate in events per second; rate 0 sends them back to back;
+    - gates are uniform, round robin or weighted (gate g gets weight
+      ulGates - g when no weights are given).
+
+    vTrafficGenWait() blocks until the tick of the arrival. Events that
+    fall in the same tick are sent back to back.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __TRAFFIC_GEN_H
+#define __TRAFFIC_GEN_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+
+// ------ macros -------------------------------------------------------
+/* Arrival patterns. */
+#define trafficPOISSON				0
+#define trafficBURST				1
+#define trafficPERIODIC				2
+
+/* Gate selection. */
+#define trafficGATES_UNIFORM		0
+#define trafficGATES_ROUND_ROBIN	1
+#define trafficGATES_WEIGHTED		2
+
+// ------ typedef ------------------------------------------------------
+typedef struct
+{
+	uint8_t ucPattern;				/* trafficPOISSON ... */
+	uint8_t ucGates;				/* trafficGATES_UNIFORM ... */
+	uint8_t ucEntryPercent;			/* Share of the events that are entries */
+	uint32_t ulRate;				/* Mean events per second, 0 = back to back */
+	uint32_t ulBurst;				/* Events per burst (trafficBURST) */
+	uint32_t ulGateCount;
+	const uint8_t *pucWeights;		/* ulGateCount weights, or NULL */
+	uint32_t ulSeed;
+} TrafficConfig_t;
+
+typedef struct
+{
+	TrafficConfig_t xConfig;
+	uint32_t ulState;
+	uint32_t ulBurstLeft;
+	uint32_t ulNextGate;
+	uint32_t ulWeightSum;
+	uint64_t ullTimeNs;
+} TrafficGen_t;
+
+typedef struct
+{
+	uint64_t ullTimeNs;				/* Arrival, from vTrafficGenInit() */
+	uint32_t ulGate;
+	uint8_t  ucEntry;				/* 1 entry, 0 exit */
+} TrafficEvent_t;
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+void vTrafficGenInit( TrafficGen_t *pxGen, const TrafficConfig_t *pxConfig );
+void vTrafficGenNext( TrafficGen_t *pxGen, TrafficEvent_t *pxEvent );
+
+/* Next 32 bit number of the generator, never 0. */
+uint32_t ulTrafficGenRandom( TrafficGen_t *pxGen );
+
+/* Block until the arrival tick of the event, xStart is the tick count
+ * taken with vTrafficGenInit(). Returns at once for a late event. */
+void vTrafficGenWait( TickType_t xStart, const TrafficEvent_t *pxEvent );
+
+/* "poisson", "burst" ... for the reports. */
+const char *pcTrafficGenPattern( uint32_t ulPattern );
+const char *pcTrafficGenGates( uint32_t ulGates );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TRAFFIC_GEN_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,94 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example001
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+/*--------------------------------------------------------------------*-
+
+    cycle_Counter.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    Cycle counter for FreeRTOS - Event Driven System (EDS) - Project
+    for STM32F429ZI_NUCLEO_144.
+
+    Uses the DWT unit of the Cortex-M4. The debugger also enables it,
+    so the counter keeps running when a debug session attaches.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+
+/* Demo includes. */
+#include "cycle_Counter.h"
+
+// ------ Macros and definitions ---------------------------------------
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+
+// ------ internal data definition -------------------------------------
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vCycleCounterInit( void )
+{
+	if( ( DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk ) == 0UL )
+	{
+		/* Power the trace blocks, then start the counter from zero. */
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CYCCNT = 0UL;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulCycleCounterGet( void )
+{
+	return DWT->CYCCNT;
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -50,51 +50,87 @@
 #endif
 
 // ------ inclusions ---------------------------------------------------
+#include "time_Stamp.h"
+#include "occupancy_Counter.h"
 
 // ------ macros -------------------------------------------------------
-#define Task_BQuantity			2
+/* Lots, up to 255, each one with its own Task A, Task B, gates and
+ * counter (parking_Lot.h). A lot takes about 2.5 KB of the heap, and
+ * adds 1 + Task_BQuantity tasks that runSTATS_MAX_TASKS has to make
+ * room for. parking_Lot.c stops the build when they do not fit: about
+ * 3 lots with the 15 KB heap. */
+#ifndef PARKING_LOTS
+	#define PARKING_LOTS			1
+#endif
+
+/* Exit gates of each lot, up to 255. Task B serves all of them, see task_B.h. */
+#ifndef EXIT_GATE_QUANTITY
+	#define EXIT_GATE_QUANTITY		2
+#endif
+
+/* How Task B waits for the gates: one Task B on a set of the gate
+ * signals, or Task_BQuantity Task B workers on one queue of gate events.
+ * The set costs a semaphore per gate (about 200 B per gate in the host
+ * sim, 12472 B for 64 gates), the pool about 10 B per gate plus one more
+ * Task B (about 1.2 KB on the target), so the set is only the cheaper
+ * one up to about 12 gates (TEST_BENCHMARK 1 measures it). */
+#define EXIT_GATE_QUEUE_SET		1
+#define EXIT_GATE_WORKER_POOL	2
+
+/* Gates above which the worker pool is the default mode. */
+#define EXIT_GATE_SET_MAX		8
+
+#ifndef EXIT_GATE_MODE
+	#if( EXIT_GATE_QUANTITY > EXIT_GATE_SET_MAX )
+		#define EXIT_GATE_MODE		EXIT_GATE_WORKER_POOL
+	#else
+		#define EXIT_GATE_MODE		EXIT_GATE_QUEUE_SET
+	#endif
+#endif
+
+#if( EXIT_GATE_MODE == EXIT_GATE_QUEUE_SET )
+	#define Task_BQuantity			1
+#else
+	#ifndef EXIT_GATE_WORKERS
+		#define EXIT_GATE_WORKERS	2
+	#endif
+	#define Task_BQuantity			EXIT_GATE_WORKERS
+#endif
+
 #define MAX_QUEUE_MONITOR_SIZE	10
-#define DATE_TIME_LENGTH		14
-#define NUM_VEHICLE_LENGTH		6
 
-// ------ typedef ------------------------------------------------------
+/* Overflow ring of a monitor queue with MONITOR_QUEUE_SPILL, see monitor_Queue.h */
+#ifndef MONITOR_QUEUE_SPILL_SIZE
+	#define MONITOR_QUEUE_SPILL_SIZE	16
+#endif
 
-typedef struct {
-	char taskName[15];
-	xSemaphoreHandle xBinarySemaphoreExit;
-	uint32_t lTask_BFlag;
-} Task_B_Param;
+#define NUM_VEHICLE_LENGTH		7
 
+// ------ typedef ------------------------------------------------------
+
+/* Time stamp taken at the exit gate, as text only when printed, and
+ * time in the lot (mS) from the occupancy index */
 typedef struct {
+	TimeStamp_t xTimeStamp;
+	uint32_t dwellTime;
+	uint8_t exitGate;
+	uint8_t parkingLot;
 	char numVehicle[NUM_VEHICLE_LENGTH];
-	xTaskHandle xTask_BXHandle;
-	char DateTime[DATE_TIME_LENGTH];
 } MonitorQueueStruct;
 
 // ------ external data declaration ------------------------------------
-/* Declare a variable of type xSemaphoreHandle.  This is used to reference the
- * semaphore that is used to synchronize a task with other task. */
-extern xSemaphoreHandle xBinarySemaphoreEntry;
-extern xSemaphoreHandle xBinarySemaphoreExit[Task_BQuantity];
-extern xSemaphoreHandle xCountingSemaphoreContinue;
-
-/* Declare a variable of type xSemaphoreHandle.  This is used to reference the
- * mutex type semaphore that is used to ensure mutual exclusive access to...*/
-extern xSemaphoreHandle xMutex;
-
 /* Queue Handles for Monitor task */
 extern QueueHandle_t xQueueVehicle;
 extern QueueHandle_t xQueueVehicleDateTime;
 
 /* Used to hold the handle of Tasks. */
-extern xTaskHandle vTask_AHandle;
-extern xTaskHandle vTask_BHandle[Task_BQuantity];
 extern xTaskHandle vTask_TestHandle;
 extern xTaskHandle vTask_MonitorHandle;
+extern xTaskHandle vTask_JournalHandle;
 
-/* Task A & B Counter	*/
+/* Task A & B Counter capacity of each lot, the counters are in
+ * parking_Lot.h */
 #define lTasksCntMAX	3
-extern uint32_t	lTasksCnt;
 
 // ------ external functions declaration -------------------------------
 
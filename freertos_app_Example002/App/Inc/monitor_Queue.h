@@ -0,0 +1,147 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    monitor_Queue.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Monitor Queue Header file.
+
+    Back-pressure policy around xQueueVehicle (Task B to Task Monitor)
+    and xQueueVehicleDateTime (Task Monitor to Task Journal), and the
+    counters to size them from data. What a send does on a full queue:
+    - MONITOR_QUEUE_BLOCK: waits up to MONITOR_QUEUE_BLOCK_MS, then
+      drops the new record.
+    - MONITOR_QUEUE_DROP_OLDEST: drops the oldest record in the queue.
+    - MONITOR_QUEUE_DROP_NEWEST: drops the new record.
+    - MONITOR_QUEUE_SPILL: keeps the new record in an overflow ring of
+      MONITOR_QUEUE_SPILL_SIZE records, moved to the queue in order as
+      the receiver takes records. Drops the new record once it is full.
+
+    xMonitorQueueSend() always takes the record over, a dropped record
+    is given back to the pool. A queue with MONITOR_QUEUE_SPILL must be
+    received with xMonitorQueueReceive().
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __MONITOR_QUEUE_H
+#define __MONITOR_QUEUE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+
+// ------ macros -------------------------------------------------------
+#define MONITOR_QUEUE_BLOCK			1
+#define MONITOR_QUEUE_DROP_OLDEST	2
+#define MONITOR_QUEUE_DROP_NEWEST	3
+#define MONITOR_QUEUE_SPILL			4
+
+/* Policy of xQueueVehicle and of xQueueVehicleDateTime */
+#ifndef MONITOR_QUEUE_VEHICLE_POLICY
+	#define MONITOR_QUEUE_VEHICLE_POLICY	MONITOR_QUEUE_DROP_NEWEST
+#endif
+
+#ifndef MONITOR_QUEUE_DATETIME_POLICY
+	#define MONITOR_QUEUE_DATETIME_POLICY	MONITOR_QUEUE_DROP_NEWEST
+#endif
+
+/* Longest wait of a send with MONITOR_QUEUE_BLOCK */
+#ifndef MONITOR_QUEUE_BLOCK_MS
+	#define MONITOR_QUEUE_BLOCK_MS			100
+#endif
+
+// ------ typedef ------------------------------------------------------
+/* Counters of a queue since the last reset. ulHighWater counts the
+ * records in the queue and in the overflow ring. */
+typedef struct
+{
+	uint32_t ulSends;
+	uint32_t ulDrops;
+	uint32_t ulSpills;
+	uint32_t ulBlocks;
+	uint32_t ulHighWater;
+	uint64_t ullBlockedCycles;
+} MonitorQueueStats_t;
+
+typedef struct
+{
+	QueueHandle_t xQueue;
+	const char *pcName;
+	uint32_t ulLength;
+	uint8_t ucPolicy;
+	TickType_t xBlockTicks;
+
+	/* Overflow ring of MONITOR_QUEUE_SPILL */
+	MonitorQueueStruct *pxSpill[ MONITOR_QUEUE_SPILL_SIZE ];
+	uint32_t ulSpillHead;
+	uint32_t ulSpillCount;
+
+	MonitorQueueStats_t xStats;
+} MonitorQueue_t;
+
+// ------ external data declaration ------------------------------------
+/* Policies of xQueueVehicle and xQueueVehicleDateTime */
+extern MonitorQueue_t xMonitorQueueVehicle;
+extern MonitorQueue_t xMonitorQueueDateTime;
+
+// ------ external functions declaration -------------------------------
+
+void vMonitorQueueInit( MonitorQueue_t *pxQueue, QueueHandle_t xQueue, const char *pcName, uint8_t ucPolicy );
+
+/* pdPASS if the record is in the queue or in the overflow ring, pdFAIL
+ * if it was dropped. Either way the caller no longer owns it. */
+BaseType_t xMonitorQueueSend( MonitorQueue_t *pxQueue, MonitorQueueStruct *pxVehicle );
+BaseType_t xMonitorQueueReceive( MonitorQueue_t *pxQueue, MonitorQueueStruct **ppxVehicle, TickType_t xTicksToWait );
+
+void vMonitorQueueGetStats( MonitorQueue_t *pxQueue, MonitorQueueStats_t *pxStats );
+void vMonitorQueueResetStats( MonitorQueue_t *pxQueue );
+
+/* Capacity of the queue, overflow ring included */
+uint32_t ulMonitorQueueCapacity( const MonitorQueue_t *pxQueue );
+const char *pcMonitorQueuePolicy( uint8_t ucPolicy );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MONITOR_QUEUE_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,112 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    occupancy_Counter.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Occupancy Counter Header file.
+
+    Vehicles in the lot, counted without a mutex: a vehicle is admitted
+    with a compare and swap that only succeeds while the count is below
+    the capacity, and released with an atomic decrement. No task blocks
+    on the counter and there is no priority inheritance on the gate path.
+
+    With C11 atomics (GCC -std=gnu11, as STM32CubeIDE builds) the
+    Cortex-M4 compare and swap is an LDREX/STREX loop, and the counter
+    can be used from interrupts too. Without them each operation runs
+    in a short critical section, task context only.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __OCCUPANCY_COUNTER_H
+#define __OCCUPANCY_COUNTER_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+
+#if( defined( __STDC_VERSION__ ) && ( __STDC_VERSION__ >= 201112L ) && !defined( __STDC_NO_ATOMICS__ ) )
+	#include <stdatomic.h>
+	#define OCCUPANCY_COUNTER_ATOMIC	1
+#else
+	#define OCCUPANCY_COUNTER_ATOMIC	0
+#endif
+
+// ------ macros -------------------------------------------------------
+
+// ------ typedef ------------------------------------------------------
+typedef struct
+{
+#if( OCCUPANCY_COUNTER_ATOMIC == 1 )
+	_Atomic uint32_t ulCount;
+	_Atomic uint32_t ulRetries;	/* Compare and swap lost to another gate */
+#else
+	volatile uint32_t ulCount;
+	volatile uint32_t ulRetries;
+#endif
+	uint32_t ulCapacity;
+} OccupancyCounter_t;
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Empty counter, before the tasks that use it run. */
+void vOccupancyCounterInit( OccupancyCounter_t *pxCounter, uint32_t ulCapacity );
+
+/* Admit a vehicle if the count is below the capacity: pdTRUE and the new
+ * count in pulCount, or pdFALSE with the lot full. */
+BaseType_t xOccupancyCounterAdmit( OccupancyCounter_t *pxCounter, uint32_t *pulCount );
+
+/* Release an admitted vehicle, returns the new count. */
+uint32_t ulOccupancyCounterRelease( OccupancyCounter_t *pxCounter );
+
+uint32_t ulOccupancyCounterGet( OccupancyCounter_t *pxCounter );
+uint32_t ulOccupancyCounterRetries( OccupancyCounter_t *pxCounter );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OCCUPANCY_COUNTER_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
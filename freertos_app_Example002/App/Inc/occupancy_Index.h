@@ -0,0 +1,154 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    occupancy_Index.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Occupancy Index Header file.
+
+    Vehicles in the lot, keyed on the packed plate: open addressing
+    with linear probing in a table of at least twice the lot capacity
+    (a power of two, sized at compile time), so entry, exit and lookup
+    take O(1) probes on average. Exits shift the following entries back
+    instead of leaving tombstones, so probe chains never grow with time.
+
+    Each lot has an index of its own (parking_Lot.h). Each call runs in a
+    short critical section of its own. Task A calls it once the lot
+    counter (occupancy_Counter.h) has admitted the vehicle, and Task B
+    releases the counter once the vehicle has left the index.
+
+    A plate is up to OCCUPANCY_PLATE_LENGTH characters 0-9 and A-Z,
+    packed in base 36 into a uint32_t (0 is never a valid plate).
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __OCCUPANCY_INDEX_H
+#define __OCCUPANCY_INDEX_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include "test_Bench.h"
+
+// ------ macros -------------------------------------------------------
+/* Vehicles that fit in the lot. The exit gate benchmark parks one
+ * vehicle per gate, so it takes at least EXIT_GATE_QUANTITY. */
+#ifndef OCCUPANCY_CAPACITY
+	#if( ( TEST_BENCHMARK == 1 ) && ( EXIT_GATE_QUANTITY > lTasksCntMAX ) )
+		#define OCCUPANCY_CAPACITY	EXIT_GATE_QUANTITY
+	#else
+		#define OCCUPANCY_CAPACITY	lTasksCntMAX
+	#endif
+#endif
+
+#define OCCUPANCY_PLATE_LENGTH		( NUM_VEHICLE_LENGTH - 1 )
+
+/* Smallest power of two of at least twice the capacity (load <= 50 %). */
+#define OCCUPANCY_MIN_SLOTS		( 2 * ( OCCUPANCY_CAPACITY ) )
+#define OCCUPANCY_BITS			( ( OCCUPANCY_MIN_SLOTS <= 4 )    ? 2  : ( OCCUPANCY_MIN_SLOTS <= 8 )    ? 3  : \
+								  ( OCCUPANCY_MIN_SLOTS <= 16 )   ? 4  : ( OCCUPANCY_MIN_SLOTS <= 32 )   ? 5  : \
+								  ( OCCUPANCY_MIN_SLOTS <= 64 )   ? 6  : ( OCCUPANCY_MIN_SLOTS <= 128 )  ? 7  : \
+								  ( OCCUPANCY_MIN_SLOTS <= 256 )  ? 8  : ( OCCUPANCY_MIN_SLOTS <= 512 )  ? 9  : \
+								  ( OCCUPANCY_MIN_SLOTS <= 1024 ) ? 10 : 11 )
+#define OCCUPANCY_SLOTS			( 1UL << OCCUPANCY_BITS )
+#define OCCUPANCY_MASK			( OCCUPANCY_SLOTS - 1UL )
+
+#if( OCCUPANCY_MIN_SLOTS > 2048 )
+	#error OCCUPANCY_CAPACITY is too large for the occupancy index
+#endif
+
+// ------ typedef ------------------------------------------------------
+typedef enum
+{
+	OCCUPANCY_OK,
+	OCCUPANCY_DUPLICATE,	/* Enter: the plate is already in the lot */
+	OCCUPANCY_FULL,			/* Enter: OCCUPANCY_CAPACITY vehicles in the lot */
+	OCCUPANCY_NOT_FOUND,	/* Exit or lookup: the plate is not in the lot */
+	OCCUPANCY_BAD_PLATE		/* The plate can not be packed */
+} OccupancyResult_t;
+
+typedef struct
+{
+	uint64_t ullEntryTick;
+	uint8_t  entryGate;
+} OccupancyEntry_t;
+
+/* ulPlate 0 marks a free slot. */
+typedef struct
+{
+	uint32_t ulPlate;
+	OccupancyEntry_t xEntry;
+} OccupancySlot_t;
+
+/* Vehicles in one lot */
+typedef struct
+{
+	OccupancySlot_t xSlot[ OCCUPANCY_SLOTS ];
+	uint32_t ulUsed;
+} OccupancyIndex_t;
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+void vOccupancyInit( OccupancyIndex_t *pxIndex );
+
+OccupancyResult_t xOccupancyEnter( OccupancyIndex_t *pxIndex, uint32_t ulPlate, uint8_t entryGate, uint64_t ullTick );
+
+/* Removes the plate, and returns its entry in pxEntry when not NULL. */
+OccupancyResult_t xOccupancyExit( OccupancyIndex_t *pxIndex, uint32_t ulPlate, OccupancyEntry_t *pxEntry );
+
+OccupancyResult_t xOccupancyLookup( OccupancyIndex_t *pxIndex, uint32_t ulPlate, OccupancyEntry_t *pxEntry );
+
+uint32_t ulOccupancyCount( OccupancyIndex_t *pxIndex );
+
+/* Plate text to key and back, 0 if the text is not a valid plate.
+ * pcPlate holds at least NUM_VEHICLE_LENGTH characters. */
+uint32_t ulOccupancyPackPlate( const char *pcPlate );
+void vOccupancyUnpackPlate( uint32_t ulPlate, char *pcPlate );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OCCUPANCY_INDEX_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,127 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    parking_Lot.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Parking Lot Header file.
+
+    Everything one lot runs on: the entry signals (task_Signal.h) and
+    plate register of Task A, the lot counter (occupancy_Counter.h) and index
+    (occupancy_Index.h), the exit gates of Task B (task_B.h) and the
+    handles of its tasks. appInit() sets up PARKING_LOTS of them
+    (app_Resources.h), each one with its own Task A and Task B.
+
+    Lots share no signal, counter or index, only the Task Monitor and
+    Task Journal pipeline: xMonitorQueueVehicle (monitor_Queue.h) and the
+    vehicle pool (vehicle_Pool.h), and each record carries its lot.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __PARKING_LOT_H
+#define __PARKING_LOT_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include "occupancy_Index.h"
+#include "task_Signal.h"
+
+// ------ macros -------------------------------------------------------
+
+// ------ typedef ------------------------------------------------------
+struct ParkingLot;
+
+/* Task B parameters, one per Task B of each lot */
+typedef struct {
+	char taskName[15];
+	uint32_t lTask_BFlag;
+	struct ParkingLot *pxLot;
+} Task_B_Param;
+
+typedef struct ParkingLot {
+	uint8_t ucLot;
+
+	/* Entry: the signal is given with the plate in ulEntryPlate, and a
+	 * full lot waits on xSignalContinue for an exit. Both are taken by
+	 * Task A. */
+	TaskSignal_t xSignalEntry;
+	TaskSignal_t xSignalContinue;
+	uint32_t ulEntryPlate;
+
+	/* Task A & B Counter, lock-free, and the vehicles by plate */
+	OccupancyCounter_t xTasksCnt;
+	OccupancyIndex_t xIndex;
+
+	/* Exit gates, see task_B.h */
+#if( EXIT_GATE_MODE == EXIT_GATE_QUEUE_SET )
+	TaskSignal_t xSignalExit[EXIT_GATE_QUANTITY];
+	TaskSignalSet_t xSignalSetExit;
+	uint32_t ulExitPlate[EXIT_GATE_QUANTITY];
+#else
+	QueueHandle_t xQueueExit;
+#endif
+	size_t xGateHeap;
+
+	xTaskHandle vTask_AHandle;
+	xTaskHandle vTask_BHandle[Task_BQuantity];
+	Task_B_Param xTask_BParam[Task_BQuantity];
+
+	/* Heap taken by vParkingLotInit(), tasks included */
+	size_t xHeap;
+} ParkingLot_t;
+
+// ------ external data declaration ------------------------------------
+extern ParkingLot_t xParkingLot[PARKING_LOTS];
+
+// ------ external functions declaration -------------------------------
+
+/* Create the signals, gates and tasks of lot ulLot. Called by
+ * appInit() before the scheduler starts. */
+void vParkingLotInit( ParkingLot_t *pxLot, uint32_t ulLot );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PARKING_LOT_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
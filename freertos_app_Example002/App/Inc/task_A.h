@@ -59,6 +59,11 @@
 
  // ------ external functions declaration -------------------------------
 
+ /* Signal a vehicle with plate ulPlate (occupancy_Index.h) at the entry
+  * of a lot (parking_Lot.h). pdFAIL if the previous entry has not been
+  * taken by the Task A of the lot yet. */
+ BaseType_t xTask_ASignalEntry( ParkingLot_t *pxLot, uint32_t ulPlate );
+
  void vTask_A( void *pvParameters );
 
 #ifdef __cplusplus
@@ -39,6 +39,21 @@
 
     This is the Tasks Header file.
 
+    Task B serves the EXIT_GATE_QUANTITY exit gates (app_Resources.h) of
+    its lot (parking_Lot.h), so a gate costs a signal or a share of a
+    queue instead of a task and its stack (EXIT_GATE_MODE picks the
+    cheaper one for EXIT_GATE_QUANTITY, see app_Resources.h):
+    - EXIT_GATE_QUEUE_SET: one binary signal per gate (task_Signal.h),
+      all of them in a set that a single Task B waits on: a queue set
+      of semaphores, or with taskSIGNAL_NOTIFY the task notification of
+      Task B and no queue object per gate. The index of each signal in
+      the set is its gate.
+    - EXIT_GATE_WORKER_POOL: one queue of exit events (plate and gate)
+      served by Task_BQuantity Task B workers.
+
+    The vehicle leaves the occupancy index (occupancy_Index.h); a plate
+    that is not in the lot is reported and not counted.
+
 -*--------------------------------------------------------------------*/
 
 
@@ -59,6 +74,18 @@
 
 // ------ external functions declaration -------------------------------
 
+/* Create the gate signals and their set, or the gate event queue, of
+ * a lot. Called by vParkingLotInit() before the scheduler starts. */
+void vTask_BInit( ParkingLot_t *pxLot );
+
+/* Signal the vehicle with plate ulPlate at an exit gate of a lot. pdFAIL
+ * if it could not be queued (the gate is still busy, or the event queue
+ * is full). */
+BaseType_t xTask_BSignalExit( ParkingLot_t *pxLot, uint32_t ulGate, uint32_t ulPlate );
+
+/* Heap taken by vTask_BInit() for all the gates of a lot, in bytes. */
+size_t xTask_BGateHeap( ParkingLot_t *pxLot );
+
 void vTask_B( void *pvParameters );
 
 #ifdef __cplusplus
@@ -0,0 +1,85 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    task_Journal.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Tasks Header file.
+
+    Task Journal takes the vehicle records that Task Monitor hands over
+    on xQueueVehicleDateTime, gives them back to the pool and appends
+    them to the flash journal (vehicle_Journal.h). Records left in the
+    page buffer are written after JOURNAL_FLUSH_MS with no new record.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __TASK_JOURNAL_H
+#define __TASK_JOURNAL_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+
+// ------ macros -------------------------------------------------------
+/* Longest time a record waits in RAM for the rest of its page. */
+#ifndef JOURNAL_FLUSH_MS
+	#define JOURNAL_FLUSH_MS		1000
+#endif
+
+// ------ typedef ------------------------------------------------------
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+void vTask_Journal( void *pvParameters );
+
+/* Records taken and core cycles spent on them (cycle_Counter.h) since
+ * the start, flash erase and write included. */
+void vTask_JournalCounts( uint32_t *pulRecords, uint64_t *pullCycles );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TASK_JOURNAL_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -39,6 +39,12 @@
 
     This is the Tasks Header file.
 
+    Task Monitor takes the vehicle records of Task B in batches: the
+    first one with a blocking receive, up to MONITOR_BATCH_SIZE - 1 more
+    that are already queued with no wait. A batch is stamped once,
+    printed as one report and forwarded in one pass, so a burst of exits
+    costs one wake up instead of one per vehicle.
+
 -*--------------------------------------------------------------------*/
 
 
@@ -52,6 +58,10 @@
 // ------ inclusions ---------------------------------------------------
 
 // ------ macros -------------------------------------------------------
+/* Records per wake up, 1 keeps the report of four lines per vehicle. */
+#ifndef MONITOR_BATCH_SIZE
+	#define MONITOR_BATCH_SIZE		MAX_QUEUE_MONITOR_SIZE
+#endif
 
 // ------ typedef ------------------------------------------------------
 
@@ -61,6 +71,10 @@
 
 void vTask_Monitor( void *pvParameters );
 
+/* Wake ups, records served and core cycles spent on them (cycle_Counter.h)
+ * since the start, to compare batch sizes. */
+void vTask_MonitorCounts( uint32_t *pulWakes, uint32_t *pulRecords, uint64_t *pullCycles );
+
 #ifdef __cplusplus
 }
 #endif
@@ -50,8 +50,74 @@
 #endif
 
 // ------ inclusions ---------------------------------------------------
+#include "test_Bench.h"
 
 // ------ macros -------------------------------------------------------
+/* Set to 1 to drive Task A and Task B with TEST_TRAFFIC_EVENTS events of
+ * the traffic generator (traffic_Gen.h) instead of the demo, and print
+ * the events per second, the events lost at the gates and on full
+ * queues, and the latency from the signal to the end of the entry or
+ * exit. The gates of the generator are the exit gates. With
+ * TEST_TRAFFIC_SCRIPT 1 the events are the ones of TEST_X, in order,
+ * with the timing of the generator. */
+#ifndef TEST_TRAFFIC
+	#define TEST_TRAFFIC			( 0 )
+#endif
+
+#if( ( TEST_TRAFFIC != 0 ) && ( TEST_BENCHMARK != 0 ) )
+	#error TEST_TRAFFIC and TEST_BENCHMARK can not be used together
+#endif
+
+#ifndef TEST_TRAFFIC_EVENTS
+	#define TEST_TRAFFIC_EVENTS		( 10000 )
+#endif
+
+/* Mean events per second, 0 sends them back to back. */
+#ifndef TEST_TRAFFIC_RATE
+	#define TEST_TRAFFIC_RATE		( 2000 )
+#endif
+
+#ifndef TEST_TRAFFIC_PATTERN
+	#define TEST_TRAFFIC_PATTERN	trafficPOISSON
+#endif
+
+#ifndef TEST_TRAFFIC_BURST
+	#define TEST_TRAFFIC_BURST		( 8 )
+#endif
+
+/* trafficGATES_WEIGHTED takes TEST_TRAFFIC_WEIGHTS, one per exit gate,
+ * e.g. { 3, 1 }, or gives gate g the weight EXIT_GATE_QUANTITY - g. */
+#ifndef TEST_TRAFFIC_GATES
+	#define TEST_TRAFFIC_GATES		trafficGATES_UNIFORM
+#endif
+
+#ifndef TEST_TRAFFIC_ENTRY_PERCENT
+	#define TEST_TRAFFIC_ENTRY_PERCENT	( 50 )
+#endif
+
+#ifndef TEST_TRAFFIC_SEED
+	#define TEST_TRAFFIC_SEED		( 1 )
+#endif
+
+#ifndef TEST_TRAFFIC_SCRIPT
+	#define TEST_TRAFFIC_SCRIPT		( 0 )
+#endif
+
+/* Task A calls this when it is done with an entry, Task B when it is
+ * done with an exit. */
+#if( TEST_BENCHMARK == 1 )
+	#define TEST_ENTRY_DONE()
+	#define TEST_EXIT_DONE( ulGate )	vTestBenchDone()
+#elif( TEST_BENCHMARK == 4 )
+	#define TEST_ENTRY_DONE()			vTestBenchDone()
+	#define TEST_EXIT_DONE( ulGate )	vTestBenchDone()
+#elif( TEST_TRAFFIC == 1 )
+	#define TEST_ENTRY_DONE()			vTask_TestTrafficEntry()
+	#define TEST_EXIT_DONE( ulGate )	vTask_TestTrafficExit( ulGate )
+#else
+	#define TEST_ENTRY_DONE()
+	#define TEST_EXIT_DONE( ulGate )
+#endif
 
 // ------ typedef ------------------------------------------------------
 
@@ -60,6 +126,8 @@
 // ------ external functions declaration -------------------------------
 
 void vTask_Test( void *pvParameters );
+void vTask_TestTrafficEntry( void );
+void vTask_TestTrafficExit( uint32_t ulGate );
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,106 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    test_Bench.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Test Bench Header file.
+
+    Benchmarks of the parking lot code, run by Task Test instead of the
+    demo when TEST_BENCHMARK is set. Task A and Task B report the
+    entries and exits they serve through TEST_ENTRY_DONE() and
+    TEST_EXIT_DONE() (task_Test.h).
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __TEST_BENCH_H
+#define __TEST_BENCH_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+
+// ------ macros -------------------------------------------------------
+/* Set to a benchmark instead of the demo:
+ * 1: exit gate throughput. For 1, 2, 4 ... EXIT_GATE_QUANTITY gates,
+ *    TEST_BENCHMARK_ROUNDS rounds that signal every gate once and wait
+ *    until Task B has served them all.
+ * 2: occupancy counter contention. For 2, 8 and 32 gate tasks, each one
+ *    admits and releases a vehicle TEST_BENCHMARK_OPS times, with the
+ *    lock-free counter and then with a counter under a mutex.
+ * 3: flash journal throughput. TEST_BENCHMARK_RECORDS vehicle records
+ *    sent to Task Journal, enough to rotate through the sectors.
+ * 4: parking lot scaling. For 1, 2 and 3 lots (up to PARKING_LOTS, 3
+ *    is the most the 15 KB heap takes), TEST_BENCHMARK_ROUNDS rounds
+ *    that signal an entry and then an exit in every lot and wait until
+ *    all of them are served. */
+#ifndef TEST_BENCHMARK
+	#define TEST_BENCHMARK			( 0 )
+#endif
+
+#ifndef TEST_BENCHMARK_ROUNDS
+	#define TEST_BENCHMARK_ROUNDS	( 200 )
+#endif
+
+#ifndef TEST_BENCHMARK_OPS
+	#define TEST_BENCHMARK_OPS		( 1000 )
+#endif
+
+#ifndef TEST_BENCHMARK_RECORDS
+	#define TEST_BENCHMARK_RECORDS	( 2 * JOURNAL_SLOTS )
+#endif
+
+// ------ typedef ------------------------------------------------------
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+void vTestBenchRun( void );
+void vTestBenchDone( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TEST_BENCH_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
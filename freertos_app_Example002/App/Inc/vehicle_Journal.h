@@ -0,0 +1,152 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    vehicle_Journal.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Vehicle Journal Header file.
+
+    Log of the vehicle exits in the flash region (flash_Region.h), kept
+    over resets and power cuts. Records have a fixed size and a CRC-32;
+    they are gathered in RAM and written JOURNAL_PAGE_SIZE bytes at a
+    time, or when ulJournalFlush() is called.
+
+    Each sector starts with a header (magic, generation, CRC) and is
+    filled with records in order. When it is full the journal rotates
+    to the next sector of the region, erases it (dropping its oldest
+    records) and writes a header one generation higher.
+
+    vJournalInit() recovers the journal: the valid header with the
+    highest generation is the active sector, and its records are read
+    up to the first erased slot. A record cut by a power failure fails
+    its CRC, is counted as corrupt and its slot is skipped. The sequence
+    goes on from the highest one found.
+
+    Only one task appends and flushes, vJournalGetStatus() may be called
+    from any task.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __VEHICLE_JOURNAL_H
+#define __VEHICLE_JOURNAL_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include "flash_Region.h"
+
+// ------ macros -------------------------------------------------------
+/* Bytes written to the flash at a time, a multiple of the record size. */
+#ifndef JOURNAL_PAGE_SIZE
+	#define JOURNAL_PAGE_SIZE		256
+#endif
+
+#define JOURNAL_RECORD_SIZE			32
+#define JOURNAL_PAGE_RECORDS		( JOURNAL_PAGE_SIZE / JOURNAL_RECORD_SIZE )
+
+/* Record slots of a sector, slot 0 is the header. */
+#define JOURNAL_SLOTS				( flashREGION_SECTOR_SIZE / JOURNAL_RECORD_SIZE )
+
+#define JOURNAL_MAGIC				0x4A524E4CUL	/* "JRNL" */
+
+// ------ typedef ------------------------------------------------------
+/* One vehicle exit, JOURNAL_RECORD_SIZE bytes. ulCrc covers the rest. */
+typedef struct
+{
+	uint32_t ulSequence;
+	TimeStamp_t xTimeStamp;
+	uint32_t ulDwell;
+	uint32_t ulPlate;			/* ulOccupancyPackPlate() */
+	uint8_t  ucGate;
+	uint8_t  ucLot;				/* 0 .. PARKING_LOTS - 1 */
+	uint8_t  ucReserved[2];
+	uint32_t ulCrc;
+} JournalRecord_t;
+
+/* Slot 0 of a sector, JOURNAL_RECORD_SIZE bytes. */
+typedef struct
+{
+	uint32_t ulMagic;
+	uint32_t ulGeneration;
+	uint32_t ulRecordSize;
+	uint32_t ulReserved[4];
+	uint32_t ulCrc;
+} JournalHeader_t;
+
+typedef struct
+{
+	uint32_t ulSector;			/* Active sector and its generation */
+	uint32_t ulGeneration;
+	uint32_t ulSlot;			/* Next free slot of the active sector */
+	uint32_t ulNextSequence;
+	uint32_t ulRecovered;		/* Valid and corrupt records found by vJournalInit() */
+	uint32_t ulCorrupt;
+	uint32_t ulPending;			/* Records in RAM, not yet in the flash */
+	uint32_t ulWritten;			/* Records and pages written since vJournalInit() */
+	uint32_t ulPages;
+	uint32_t ulRotations;
+	uint32_t ulDropped;			/* Records lost with the page buffer full */
+	uint32_t ulErrors;			/* Flash erase or write failures */
+} JournalStatus_t;
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+void vJournalInit( void );
+
+/* Copies the record into the page buffer, and writes the page when it
+ * is full. pdFAIL if the record was dropped. */
+BaseType_t xJournalAppend( const MonitorQueueStruct *pxVehicle );
+
+/* Writes the records in the page buffer, returns how many. */
+uint32_t ulJournalFlush( void );
+
+uint32_t ulJournalPending( void );
+void vJournalGetStatus( JournalStatus_t *pxStatus );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __VEHICLE_JOURNAL_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,98 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    vehicle_Pool.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Vehicle Pool Header file.
+
+    Fixed size pool of MonitorQueueStruct records. xQueueVehicle and
+    xQueueVehicleDateTime carry pointers to these records, so a vehicle
+    event is written once and the queue item size does not grow with
+    the record.
+
+    Ownership is handed off explicitly:
+    - pxVehiclePoolAlloc() makes the caller the owner of the record.
+    - xMonitorQueueSend() of the pointer hands it to the receiver, or
+      gives it back if the queue policy drops it (monitor_Queue.h). The
+      sender must not touch the record any more.
+    - A plain xQueueSend() that fails leaves the sender the owner, it
+      must give the record back with vVehiclePoolFree().
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __VEHICLE_POOL_H
+#define __VEHICLE_POOL_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+
+// ------ macros -------------------------------------------------------
+/* Both queues and their overflow rings full plus one record in hand per
+ * producer (the Task B of every lot) and consumer: with this size an
+ * allocation only fails if a record is leaked. */
+#ifndef VEHICLE_POOL_SIZE
+	#define VEHICLE_POOL_SIZE	( ( 2 * ( MAX_QUEUE_MONITOR_SIZE + MONITOR_QUEUE_SPILL_SIZE ) ) + ( PARKING_LOTS * Task_BQuantity ) + 1 )
+#endif
+
+// ------ typedef ------------------------------------------------------
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+void vVehiclePoolInit( void );
+
+/* NULL, and one more allocation failure counted, if the pool is empty. */
+MonitorQueueStruct *pxVehiclePoolAlloc( void );
+void vVehiclePoolFree( MonitorQueueStruct *pxVehicle );
+
+uint32_t ulVehiclePoolFree( void );
+uint32_t ulVehiclePoolAllocFailures( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __VEHICLE_POOL_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
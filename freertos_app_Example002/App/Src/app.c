@@ -63,43 +63,25 @@
 /* Application & Tasks includes. */
 #include "app_Resources.h"
 #include "app.h"
-#include "task_A.h"
-#include "task_B.h"
 #include "task_Test.h"
 #include "task_Monitor.h"
+#include "task_Journal.h"
+#include "vehicle_Pool.h"
+#include "parking_Lot.h"
+#include "monitor_Queue.h"
 
 // ------ Macros and definitions ---------------------------------------
 
 // ------ internal data declaration ------------------------------------
-/* Declare a variable of type xSemaphoreHandle.  This is used to reference the
- * semaphore that is used to synchronize a task with other task. */
-xSemaphoreHandle xBinarySemaphoreEntry;
-xSemaphoreHandle xBinarySemaphoreExit[Task_BQuantity];
-// xSemaphoreHandle xBinarySemaphoreContinue;
-
-/* Replace binary semaphore with counting semaphore */
-xSemaphoreHandle xCountingSemaphoreContinue;
-
-/* Declare a variable of type xSemaphoreHandle.  This is used to reference the
- * mutex type semaphore that is used to ensure mutual exclusive access to ........ */
-xSemaphoreHandle xMutex;
-
 /* Declare a variable of type xTaskHandle. This is used to reference tasks. */
-xTaskHandle vTask_AHandle;
-xTaskHandle vTask_BHandle[Task_BQuantity];
 xTaskHandle vTask_TestHandle;
 xTaskHandle vTask_MonitorHandle;
+xTaskHandle vTask_JournalHandle;
 
 /* Queue Handles for Monitor task */
 QueueHandle_t xQueueVehicle;
 QueueHandle_t xQueueVehicleDateTime;
 
-/* Task B names */
-Task_B_Param Task_BParam[Task_BQuantity];
-
-/* Task A & B Counter	*/
-uint32_t	lTasksCnt;
-
 // ------ internal functions declaration -------------------------------
 
 // ------ internal data definition -------------------------------------
@@ -119,79 +101,27 @@ void appInit( void )
 	/* Print out the name of this Example. */
   	vPrintString( pcTextForMain );
 
-    /* Before a semaphore is used it must be explicitly created.
-     * In this example a binary semaphore is created. */
-    vSemaphoreCreateBinary( xBinarySemaphoreEntry );
-
-    /* Create counting semaphore */
-    xCountingSemaphoreContinue = xSemaphoreCreateCounting(Task_BQuantity, 0);
-
-    /* Check the semaphore was created successfully. */
-	configASSERT( xBinarySemaphoreEntry !=  NULL );
-	configASSERT( xCountingSemaphoreContinue !=  NULL );
-
-    /* Add semaphore to registry. */
-	vQueueAddToRegistry(xBinarySemaphoreEntry,    "xBinarySemaphoreEntry");
-    vQueueAddToRegistry(xCountingSemaphoreContinue, "xCountingSemaphoreContinue");
+    /* Records for the vehicle events, the queues only carry pointers */
+    vVehiclePoolInit();
 
     /* Create queues for Monitor task */
-    xQueueVehicle = xQueueCreate(MAX_QUEUE_MONITOR_SIZE, sizeof(MonitorQueueStruct));
-    xQueueVehicleDateTime = xQueueCreate(MAX_QUEUE_MONITOR_SIZE, sizeof(MonitorQueueStruct));
+    xQueueVehicle = xQueueCreate(MAX_QUEUE_MONITOR_SIZE, sizeof(MonitorQueueStruct *));
+    xQueueVehicleDateTime = xQueueCreate(MAX_QUEUE_MONITOR_SIZE, sizeof(MonitorQueueStruct *));
 
     /* Check the queue was created successfully. */
 	configASSERT( xQueueVehicle !=  NULL );
 	configASSERT( xQueueVehicleDateTime !=  NULL );
 
-    /* Before a semaphore is used it must be explicitly created.
-     * In this example a mutex semaphore is created. */
-    xMutex = xSemaphoreCreateMutex();
-
-    /* Check the mutex was created successfully. */
-    configASSERT( xMutex !=  NULL );
-
-    /* Add mutex to registry. */
-	vQueueAddToRegistry(xMutex, "xMutex");
+    /* What a send does when a queue is full, see monitor_Queue.h */
+    vMonitorQueueInit( &xMonitorQueueVehicle, xQueueVehicle, "vehicle", MONITOR_QUEUE_VEHICLE_POLICY );
+    vMonitorQueueInit( &xMonitorQueueDateTime, xQueueVehicleDateTime, "datetime", MONITOR_QUEUE_DATETIME_POLICY );
 
 	BaseType_t ret;
 
-    /* Task A thread at priority 2 */
-    ret = xTaskCreate( vTask_A,						/* Pointer to the function thats implement the task. */
-					   "Task A",					/* Text name for the task. This is to facilitate debugging only. */
-					   (2 * configMINIMAL_STACK_SIZE),	/* Stack depth in words. 				*/
-					   NULL,						/* We are not using the task parameter.		*/
-					   (tskIDLE_PRIORITY + 2UL),	/* This task will run at priority 1. 		*/
-					   &vTask_AHandle );				/* We are using a variable as task handle.	*/
-
-    /* Check the task was created successfully. */
-    configASSERT( ret == pdPASS );
-
-    /* Task B name */
-    char taskBName[15];
-
-    /* Task B thread at priority 2 */
-    for (uint8_t i = 0; i < Task_BQuantity; i++)
+    /* Each lot with its own semaphores, gates, Task A and Task B */
+    for (uint32_t i = 0; i < PARKING_LOTS; i++)
     {
-    	/* Create a binary semaphore for each exit task B */
-    	vSemaphoreCreateBinary( xBinarySemaphoreExit[i]     );
-    	configASSERT( xBinarySemaphoreExit[i]     !=  NULL );
-
-    	sprintf(taskBName, "Task B%d", i+1);
-    	/* Initialize parameters structure for task B */
-    	strcpy(Task_BParam[i].taskName, taskBName);
-    	Task_BParam[i].xBinarySemaphoreExit = xBinarySemaphoreExit[i];
-    	Task_BParam[i].lTask_BFlag = 0;
-
-    	//vQueueAddToRegistry(xBinarySemaphoreExit,     "xBinarySemaphoreExit");
-    	/* Create Task_BQuantity tasks vTaskB */
-    	ret = xTaskCreate( vTask_B,						/* Pointer to the function thats implement the task. */
-    						taskBName,					/* Text name for the task. This is to facilitate debugging only. */
-						   (2 * configMINIMAL_STACK_SIZE),	/* Stack depth in words. 				*/
-						   (void *)&Task_BParam[i],						/* Receive the semaphore as parameter.		*/
-						   (tskIDLE_PRIORITY + 2UL),	/* This task will run at priority 1. 		*/
-						   &vTask_BHandle[i] );				/* We are using a variable as task handle.	*/
-
-		/* Check the task was created successfully. */
-		configASSERT( ret == pdPASS );
+    	vParkingLotInit( &xParkingLot[i], i );
     }
 
 	/* Task Test at priority 1, periodically excites the other tasks */
@@ -215,6 +145,17 @@ void appInit( void )
 
     /* Check the task was created successfully. */
     configASSERT( ret == pdPASS );
+
+    /* Task Journal at priority 1, keeps the exits in flash */
+    ret = xTaskCreate( vTask_Journal,					/* Pointer to the function thats implement the task. */
+					   "Task Journal",					/* Text name for the task. This is to facilitate debugging only. */
+					   (2 * configMINIMAL_STACK_SIZE),	/* Stack depth in words. 				*/
+					   NULL,						/* We are not using the task parameter.		*/
+					   (tskIDLE_PRIORITY + 1UL),	/* This task will run at priority 1. 		*/
+					   &vTask_JournalHandle );			/* We are using a variable as task handle.	*/
+
+    /* Check the task was created successfully. */
+    configASSERT( ret == pdPASS );
 }
 
 /*------------------------------------------------------------------*-
@@ -0,0 +1,264 @@
+/* Copyright 2020, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    monitor_Queue.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    monitor queue file for FreeRTOS - Event Driven System (EDS) - Project
+    for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <string.h>
+
+/* Demo includes. */
+#include "cycle_Counter.h"
+
+/* Application includes. */
+#include "app_Resources.h"
+#include "vehicle_Pool.h"
+#include "monitor_Queue.h"
+
+// ------ Macros and definitions ---------------------------------------
+#if( MONITOR_QUEUE_SPILL_SIZE < 1 )
+	#error MONITOR_QUEUE_SPILL_SIZE must be 1 or more
+#endif
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+static void prvMonitorQueueRefill( MonitorQueue_t *pxQueue );
+
+// ------ internal data definition -------------------------------------
+static const char * const pcMonitorQueuePolicyNames[] = { "?", "block", "drop-oldest", "drop-newest", "spill" };
+
+// ------ external data definition -------------------------------------
+MonitorQueue_t xMonitorQueueVehicle;
+MonitorQueue_t xMonitorQueueDateTime;
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+/* Move the overflow ring to the queue, oldest first, while it has room.
+ * Called with the scheduler suspended. */
+static void prvMonitorQueueRefill( MonitorQueue_t *pxQueue )
+{
+	while( ( pxQueue->ulSpillCount != 0 ) &&
+		   ( xQueueSend( pxQueue->xQueue, &pxQueue->pxSpill[ pxQueue->ulSpillHead ], 0 ) == pdPASS ) )
+	{
+		pxQueue->ulSpillHead = ( pxQueue->ulSpillHead + 1 ) % MONITOR_QUEUE_SPILL_SIZE;
+		pxQueue->ulSpillCount--;
+	}
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vMonitorQueueInit( MonitorQueue_t *pxQueue, QueueHandle_t xQueue, const char *pcName, uint8_t ucPolicy )
+{
+	configASSERT( xQueue != NULL );
+	configASSERT( ( ucPolicy >= MONITOR_QUEUE_BLOCK ) && ( ucPolicy <= MONITOR_QUEUE_SPILL ) );
+
+	memset( pxQueue, 0, sizeof( MonitorQueue_t ) );
+	pxQueue->xQueue = xQueue;
+	pxQueue->pcName = pcName;
+	pxQueue->ucPolicy = ucPolicy;
+	pxQueue->xBlockTicks = pdMS_TO_TICKS( MONITOR_QUEUE_BLOCK_MS );
+	pxQueue->ulLength = ( uint32_t )( uxQueueMessagesWaiting( xQueue ) + uxQueueSpacesAvailable( xQueue ) );
+}
+
+/*------------------------------------------------------------------*/
+BaseType_t xMonitorQueueSend( MonitorQueue_t *pxQueue, MonitorQueueStruct *pxVehicle )
+{
+	MonitorQueueStruct *pxOldest;
+	BaseType_t xResult;
+	uint32_t ulStart, ulBlocked = 0, ulBlocks = 0, ulDrops = 0, ulSpills = 0, ulUsed, i;
+
+	switch( pxQueue->ucPolicy )
+	{
+		case MONITOR_QUEUE_BLOCK:
+			xResult = xQueueSend( pxQueue->xQueue, &pxVehicle, 0 );
+			if( xResult != pdPASS )
+			{
+				ulStart = ulCycleCounterGet();
+				xResult = xQueueSend( pxQueue->xQueue, &pxVehicle, pxQueue->xBlockTicks );
+				ulBlocked = ulCycleCounterGet() - ulStart;
+				ulBlocks = 1;
+			}
+			ulUsed = ( uint32_t ) uxQueueMessagesWaiting( pxQueue->xQueue );
+			break;
+
+		case MONITOR_QUEUE_DROP_OLDEST:
+			/* Another sender may take the room made, give up after as
+			 * many records as the queue holds. */
+			xResult = xQueueSend( pxQueue->xQueue, &pxVehicle, 0 );
+			for( i = 0; ( xResult != pdPASS ) && ( i < pxQueue->ulLength ); i++ )
+			{
+				if( xQueueReceive( pxQueue->xQueue, &pxOldest, 0 ) == pdPASS )
+				{
+					vVehiclePoolFree( pxOldest );
+					ulDrops++;
+				}
+				xResult = xQueueSend( pxQueue->xQueue, &pxVehicle, 0 );
+			}
+			ulUsed = ( uint32_t ) uxQueueMessagesWaiting( pxQueue->xQueue );
+			break;
+
+		case MONITOR_QUEUE_SPILL:
+			/* Only to the queue once the ring is empty, to keep the order */
+			vTaskSuspendAll();
+			{
+				prvMonitorQueueRefill( pxQueue );
+				if( ( pxQueue->ulSpillCount == 0 ) && ( xQueueSend( pxQueue->xQueue, &pxVehicle, 0 ) == pdPASS ) )
+				{
+					xResult = pdPASS;
+				}
+				else if( pxQueue->ulSpillCount < MONITOR_QUEUE_SPILL_SIZE )
+				{
+					pxQueue->pxSpill[ ( pxQueue->ulSpillHead + pxQueue->ulSpillCount ) % MONITOR_QUEUE_SPILL_SIZE ] = pxVehicle;
+					pxQueue->ulSpillCount++;
+					ulSpills = 1;
+					xResult = pdPASS;
+				}
+				else
+				{
+					xResult = pdFAIL;
+				}
+				ulUsed = ( uint32_t ) uxQueueMessagesWaiting( pxQueue->xQueue ) + pxQueue->ulSpillCount;
+			}
+			( void ) xTaskResumeAll();
+			break;
+
+		case MONITOR_QUEUE_DROP_NEWEST:
+		default:
+			xResult = xQueueSend( pxQueue->xQueue, &pxVehicle, 0 );
+			ulUsed = ( uint32_t ) uxQueueMessagesWaiting( pxQueue->xQueue );
+			break;
+	}
+
+	if( xResult != pdPASS )
+	{
+		vVehiclePoolFree( pxVehicle );
+		ulDrops++;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		pxQueue->xStats.ulSends++;
+		pxQueue->xStats.ulDrops += ulDrops;
+		pxQueue->xStats.ulSpills += ulSpills;
+		pxQueue->xStats.ulBlocks += ulBlocks;
+		pxQueue->xStats.ullBlockedCycles += ulBlocked;
+		if( ulUsed > pxQueue->xStats.ulHighWater )
+		{
+			pxQueue->xStats.ulHighWater = ulUsed;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xResult;
+}
+
+/*------------------------------------------------------------------*/
+BaseType_t xMonitorQueueReceive( MonitorQueue_t *pxQueue, MonitorQueueStruct **ppxVehicle, TickType_t xTicksToWait )
+{
+	BaseType_t xResult;
+
+	xResult = xQueueReceive( pxQueue->xQueue, ppxVehicle, xTicksToWait );
+
+	/* The record taken made room for the oldest one of the ring */
+	if( ( xResult == pdPASS ) && ( pxQueue->ulSpillCount != 0 ) )
+	{
+		vTaskSuspendAll();
+		{
+			prvMonitorQueueRefill( pxQueue );
+		}
+		( void ) xTaskResumeAll();
+	}
+
+	return xResult;
+}
+
+/*------------------------------------------------------------------*/
+void vMonitorQueueGetStats( MonitorQueue_t *pxQueue, MonitorQueueStats_t *pxStats )
+{
+	taskENTER_CRITICAL();
+	{
+		*pxStats = pxQueue->xStats;
+	}
+	taskEXIT_CRITICAL();
+}
+
+/*------------------------------------------------------------------*/
+void vMonitorQueueResetStats( MonitorQueue_t *pxQueue )
+{
+	taskENTER_CRITICAL();
+	{
+		memset( &pxQueue->xStats, 0, sizeof( MonitorQueueStats_t ) );
+		pxQueue->xStats.ulHighWater = ( uint32_t ) uxQueueMessagesWaiting( pxQueue->xQueue ) + pxQueue->ulSpillCount;
+	}
+	taskEXIT_CRITICAL();
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulMonitorQueueCapacity( const MonitorQueue_t *pxQueue )
+{
+	return pxQueue->ulLength + ( ( pxQueue->ucPolicy == MONITOR_QUEUE_SPILL ) ? MONITOR_QUEUE_SPILL_SIZE : 0 );
+}
+
+/*------------------------------------------------------------------*/
+const char *pcMonitorQueuePolicy( uint8_t ucPolicy )
+{
+	if( ucPolicy > MONITOR_QUEUE_SPILL )
+	{
+		ucPolicy = 0;
+	}
+	return pcMonitorQueuePolicyNames[ ucPolicy ];
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
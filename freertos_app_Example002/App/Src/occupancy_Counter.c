@@ -0,0 +1,170 @@
+/* Copyright 2020, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    occupancy_Counter.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    occupancy counter file for FreeRTOS - Event Driven System (EDS) -
+    Project for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Application includes. */
+#include "occupancy_Counter.h"
+
+// ------ Macros and definitions ---------------------------------------
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+
+// ------ internal data definition -------------------------------------
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vOccupancyCounterInit( OccupancyCounter_t *pxCounter, uint32_t ulCapacity )
+{
+	configASSERT( ulCapacity > 0 );
+
+	pxCounter->ulCapacity = ulCapacity;
+#if( OCCUPANCY_COUNTER_ATOMIC == 1 )
+	atomic_init( &pxCounter->ulCount, 0 );
+	atomic_init( &pxCounter->ulRetries, 0 );
+#else
+	pxCounter->ulCount = 0;
+	pxCounter->ulRetries = 0;
+#endif
+}
+
+/*------------------------------------------------------------------*/
+BaseType_t xOccupancyCounterAdmit( OccupancyCounter_t *pxCounter, uint32_t *pulCount )
+{
+#if( OCCUPANCY_COUNTER_ATOMIC == 1 )
+	uint32_t ulCount = atomic_load_explicit( &pxCounter->ulCount, memory_order_relaxed );
+
+	/* A failed compare and swap (another gate, or an interrupt between
+	 * LDREX and STREX) reloads ulCount: check it again and retry. */
+	for( ;; )
+	{
+		if( ulCount >= pxCounter->ulCapacity )
+		{
+			return pdFALSE;
+		}
+		if( atomic_compare_exchange_weak_explicit( &pxCounter->ulCount, &ulCount, ulCount + 1,
+												   memory_order_acq_rel, memory_order_relaxed ) )
+		{
+			break;
+		}
+		atomic_fetch_add_explicit( &pxCounter->ulRetries, 1, memory_order_relaxed );
+	}
+
+	*pulCount = ulCount + 1;
+	return pdTRUE;
+#else
+	BaseType_t xResult = pdFALSE;
+
+	taskENTER_CRITICAL();
+	{
+		if( pxCounter->ulCount < pxCounter->ulCapacity )
+		{
+			*pulCount = ++pxCounter->ulCount;
+			xResult = pdTRUE;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xResult;
+#endif
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulOccupancyCounterRelease( OccupancyCounter_t *pxCounter )
+{
+	uint32_t ulCount;
+
+#if( OCCUPANCY_COUNTER_ATOMIC == 1 )
+	ulCount = atomic_fetch_sub_explicit( &pxCounter->ulCount, 1, memory_order_acq_rel );
+#else
+	taskENTER_CRITICAL();
+	{
+		ulCount = pxCounter->ulCount--;
+	}
+	taskEXIT_CRITICAL();
+#endif
+
+	/* Only an admitted vehicle can be released. */
+	configASSERT( ulCount > 0 );
+
+	return ulCount - 1;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulOccupancyCounterGet( OccupancyCounter_t *pxCounter )
+{
+#if( OCCUPANCY_COUNTER_ATOMIC == 1 )
+	return atomic_load_explicit( &pxCounter->ulCount, memory_order_relaxed );
+#else
+	return pxCounter->ulCount;
+#endif
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulOccupancyCounterRetries( OccupancyCounter_t *pxCounter )
+{
+#if( OCCUPANCY_COUNTER_ATOMIC == 1 )
+	return atomic_load_explicit( &pxCounter->ulRetries, memory_order_relaxed );
+#else
+	return pxCounter->ulRetries;
+#endif
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,271 @@
+/* Copyright 2020, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    occupancy_Index.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    occupancy index file for FreeRTOS - Event Driven System (EDS) -
+    Project for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <string.h>
+
+/* Application includes. */
+#include "app_Resources.h"
+#include "occupancy_Index.h"
+
+// ------ Macros and definitions ---------------------------------------
+/* Fibonacci hashing: the top bits of the key times 2^32 / phi. */
+#define OCCUPANCY_HASH( x )		( ( uint32_t )( ( uint32_t )( x ) * 2654435769UL ) >> ( 32 - OCCUPANCY_BITS ) )
+
+#define OCCUPANCY_BASE			36UL
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+static uint32_t prvOccupancyFind( OccupancyIndex_t *pxIndex, uint32_t ulPlate );
+
+// ------ internal data definition -------------------------------------
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+/* Slot of the plate, or the free slot that ends its probe chain */
+static uint32_t prvOccupancyFind( OccupancyIndex_t *pxIndex, uint32_t ulPlate )
+{
+	uint32_t ulSlot = OCCUPANCY_HASH( ulPlate );
+
+	/* Never more than half full, a free slot is always found. */
+	while( ( pxIndex->xSlot[ ulSlot ].ulPlate != 0 ) && ( pxIndex->xSlot[ ulSlot ].ulPlate != ulPlate ) )
+	{
+		ulSlot = ( ulSlot + 1UL ) & OCCUPANCY_MASK;
+	}
+
+	return ulSlot;
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vOccupancyInit( OccupancyIndex_t *pxIndex )
+{
+	memset( pxIndex, 0, sizeof( OccupancyIndex_t ) );
+}
+
+/*------------------------------------------------------------------*/
+OccupancyResult_t xOccupancyEnter( OccupancyIndex_t *pxIndex, uint32_t ulPlate, uint8_t entryGate, uint64_t ullTick )
+{
+	OccupancyResult_t xResult = OCCUPANCY_OK;
+	uint32_t ulSlot;
+
+	if( ulPlate == 0 )
+	{
+		return OCCUPANCY_BAD_PLATE;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		ulSlot = prvOccupancyFind( pxIndex, ulPlate );
+
+		if( pxIndex->xSlot[ ulSlot ].ulPlate == ulPlate )
+		{
+			xResult = OCCUPANCY_DUPLICATE;
+		}
+		else if( pxIndex->ulUsed >= OCCUPANCY_CAPACITY )
+		{
+			xResult = OCCUPANCY_FULL;
+		}
+		else
+		{
+			pxIndex->xSlot[ ulSlot ].ulPlate = ulPlate;
+			pxIndex->xSlot[ ulSlot ].xEntry.ullEntryTick = ullTick;
+			pxIndex->xSlot[ ulSlot ].xEntry.entryGate = entryGate;
+			pxIndex->ulUsed++;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xResult;
+}
+
+/*------------------------------------------------------------------*/
+OccupancyResult_t xOccupancyExit( OccupancyIndex_t *pxIndex, uint32_t ulPlate, OccupancyEntry_t *pxEntry )
+{
+	OccupancyResult_t xResult = OCCUPANCY_OK;
+	uint32_t ulSlot, ulNext, ulHome;
+
+	if( ulPlate == 0 )
+	{
+		return OCCUPANCY_BAD_PLATE;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		ulSlot = prvOccupancyFind( pxIndex, ulPlate );
+
+		if( pxIndex->xSlot[ ulSlot ].ulPlate != ulPlate )
+		{
+			xResult = OCCUPANCY_NOT_FOUND;
+		}
+		else
+		{
+			if( pxEntry != NULL )
+			{
+				*pxEntry = pxIndex->xSlot[ ulSlot ].xEntry;
+			}
+			pxIndex->ulUsed--;
+
+			/* Backward shift: move back every following entry of the chain
+			 * whose home slot is not between the hole and itself. */
+			ulNext = ( ulSlot + 1UL ) & OCCUPANCY_MASK;
+			while( pxIndex->xSlot[ ulNext ].ulPlate != 0 )
+			{
+				ulHome = OCCUPANCY_HASH( pxIndex->xSlot[ ulNext ].ulPlate );
+				if( ( ( ulNext - ulHome ) & OCCUPANCY_MASK ) >= ( ( ulNext - ulSlot ) & OCCUPANCY_MASK ) )
+				{
+					pxIndex->xSlot[ ulSlot ] = pxIndex->xSlot[ ulNext ];
+					ulSlot = ulNext;
+				}
+				ulNext = ( ulNext + 1UL ) & OCCUPANCY_MASK;
+			}
+			pxIndex->xSlot[ ulSlot ].ulPlate = 0;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xResult;
+}
+
+/*------------------------------------------------------------------*/
+OccupancyResult_t xOccupancyLookup( OccupancyIndex_t *pxIndex, uint32_t ulPlate, OccupancyEntry_t *pxEntry )
+{
+	OccupancyResult_t xResult = OCCUPANCY_OK;
+	uint32_t ulSlot;
+
+	if( ulPlate == 0 )
+	{
+		return OCCUPANCY_BAD_PLATE;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		ulSlot = prvOccupancyFind( pxIndex, ulPlate );
+
+		if( pxIndex->xSlot[ ulSlot ].ulPlate != ulPlate )
+		{
+			xResult = OCCUPANCY_NOT_FOUND;
+		}
+		else if( pxEntry != NULL )
+		{
+			*pxEntry = pxIndex->xSlot[ ulSlot ].xEntry;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xResult;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulOccupancyCount( OccupancyIndex_t *pxIndex )
+{
+	return pxIndex->ulUsed;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulOccupancyPackPlate( const char *pcPlate )
+{
+	uint32_t ulPlate = 0, ulDigit, i;
+
+	/* Shorter plates are padded with '0' on the left. */
+	for( i = 0; ( i < OCCUPANCY_PLATE_LENGTH ) && ( pcPlate[ i ] != '\0' ); i++ )
+	{
+		if( ( pcPlate[ i ] >= '0' ) && ( pcPlate[ i ] <= '9' ) )
+		{
+			ulDigit = ( uint32_t )( pcPlate[ i ] - '0' );
+		}
+		else if( ( pcPlate[ i ] >= 'A' ) && ( pcPlate[ i ] <= 'Z' ) )
+		{
+			ulDigit = ( uint32_t )( pcPlate[ i ] - 'A' ) + 10UL;
+		}
+		else
+		{
+			return 0;
+		}
+		ulPlate = ulPlate * OCCUPANCY_BASE + ulDigit;
+	}
+
+	if( ( i == 0 ) || ( pcPlate[ i ] != '\0' ) )
+	{
+		return 0;
+	}
+
+	/* 36^6 - 1 + 1 still fits: keep 0 for the free slots. */
+	return ulPlate + 1UL;
+}
+
+/*------------------------------------------------------------------*/
+void vOccupancyUnpackPlate( uint32_t ulPlate, char *pcPlate )
+{
+	uint32_t ulDigit;
+	int32_t i;
+
+	ulPlate = ( ulPlate == 0 ) ? 0 : ( ulPlate - 1UL );
+
+	for( i = OCCUPANCY_PLATE_LENGTH - 1; i >= 0; i-- )
+	{
+		ulDigit = ulPlate % OCCUPANCY_BASE;
+		ulPlate /= OCCUPANCY_BASE;
+		pcPlate[ i ] = ( char )( ( ulDigit < 10UL ) ? ( '0' + ulDigit ) : ( 'A' + ulDigit - 10UL ) );
+	}
+	pcPlate[ OCCUPANCY_PLATE_LENGTH ] = '\0';
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
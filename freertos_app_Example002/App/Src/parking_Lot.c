@@ -0,0 +1,173 @@
+/* Copyright 2020, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    parking_Lot.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    parking lot file for FreeRTOS - Event Driven System (EDS) - Project
+    for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Demo includes. */
+#include "run_Stats.h"
+
+/* Application includes. */
+#include "app_Resources.h"
+#include "parking_Lot.h"
+#include "task_A.h"
+#include "task_B.h"
+
+// ------ Macros and definitions ---------------------------------------
+#if( ( PARKING_LOTS < 1 ) || ( PARKING_LOTS > 255 ) )
+	#error PARKING_LOTS must be 1 .. 255
+#endif
+
+/* Tasks of a lot, and the ones created besides the lots: IDLE, Task
+ * Test, Task Monitor, Task Journal, the console drain and Task Stats */
+#define PARKING_LOT_TASKS		( 1 + Task_BQuantity )
+#define PARKING_LOT_APP_TASKS	( 5 + runSTATS_ENABLE )
+
+/* Least heap a task takes: its TCB and a 2 * configMINIMAL_STACK_SIZE stack */
+#define PARKING_LOT_TASK_HEAP	( ( 2 * configMINIMAL_STACK_SIZE * sizeof( StackType_t ) ) + sizeof( StaticTask_t ) )
+
+#if( ( runSTATS_ENABLE == 1 ) && ( ( PARKING_LOT_APP_TASKS + ( PARKING_LOTS * PARKING_LOT_TASKS ) ) > runSTATS_MAX_TASKS ) )
+	#error The tasks of PARKING_LOTS lots are more than runSTATS_MAX_TASKS: raise it or lower PARKING_LOTS
+#endif
+
+/* The tasks alone, without signals, gates and the pool, must fit */
+_Static_assert( ( ( PARKING_LOT_APP_TASKS + ( PARKING_LOTS * PARKING_LOT_TASKS ) ) * PARKING_LOT_TASK_HEAP ) <= configTOTAL_HEAP_SIZE,
+				"The tasks of PARKING_LOTS lots do not fit in configTOTAL_HEAP_SIZE" );
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+
+// ------ internal data definition -------------------------------------
+
+// ------ external data definition -------------------------------------
+ParkingLot_t xParkingLot[PARKING_LOTS];
+
+// ------ internal functions definition --------------------------------
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vParkingLotInit( ParkingLot_t *pxLot, uint32_t ulLot )
+{
+	size_t xFree = xPortGetFreeHeapSize();
+	char taskName[configMAX_TASK_NAME_LEN];
+	BaseType_t ret;
+
+	memset( pxLot, 0, sizeof( ParkingLot_t ) );
+	pxLot->ucLot = (uint8_t) ulLot;
+
+    /* Before a signal is used it must be explicitly created.
+     * In this example a binary and a counting signal are created for
+     * Task A: semaphores, or its task notification with taskSIGNAL_NOTIFY
+     * (task_Signal.h). The creation is checked and the semaphores added
+     * to the registry by vTaskSignalCreate(). */
+    vTaskSignalCreate( &pxLot->xSignalEntry, 1, &pxLot->vTask_AHandle, "xBinarySemaphoreEntry" );
+    vTaskSignalCreate( &pxLot->xSignalContinue, EXIT_GATE_QUANTITY, &pxLot->vTask_AHandle, "xCountingSemaphoreContinue" );
+
+    /* Vehicles in the lot, by plate, and their lock-free count */
+    vOccupancyInit( &pxLot->xIndex );
+    vOccupancyCounterInit( &pxLot->xTasksCnt, OCCUPANCY_CAPACITY );
+
+    /* Task A thread at priority 2, the names only tell the lots apart
+     * when there are more than one */
+#if( PARKING_LOTS == 1 )
+    strcpy(taskName, "Task A");
+#else
+    snprintf(taskName, sizeof(taskName), "Task A%u", (unsigned)(pxLot->ucLot + 1U));
+#endif
+    ret = xTaskCreate( vTask_A,						/* Pointer to the function thats implement the task. */
+					   taskName,					/* Text name for the task. This is to facilitate debugging only. */
+					   (2 * configMINIMAL_STACK_SIZE),	/* Stack depth in words. 				*/
+					   (void *)pxLot,				/* Receive the lot as parameter.		*/
+					   (tskIDLE_PRIORITY + 2UL),	/* This task will run at priority 2. 		*/
+					   &pxLot->vTask_AHandle );		/* We are using a variable as task handle.	*/
+
+    /* Check the task was created successfully. */
+    configASSERT( ret == pdPASS );
+
+    /* Exit gates served by Task B, see task_B.h */
+    vTask_BInit( pxLot );
+
+    /* Task B thread at priority 2 */
+    for (uint8_t i = 0; i < Task_BQuantity; i++)
+    {
+#if( PARKING_LOTS == 1 )
+    	snprintf(taskName, sizeof(taskName), "Task B%d", i+1);
+#else
+    	snprintf(taskName, sizeof(taskName), "Task B%u.%u", (unsigned)(pxLot->ucLot + 1U), (unsigned)(i + 1U));
+#endif
+    	/* Initialize parameters structure for task B */
+    	strcpy(pxLot->xTask_BParam[i].taskName, taskName);
+    	pxLot->xTask_BParam[i].lTask_BFlag = 0;
+    	pxLot->xTask_BParam[i].pxLot = pxLot;
+
+    	/* Create Task_BQuantity tasks vTaskB */
+    	ret = xTaskCreate( vTask_B,						/* Pointer to the function thats implement the task. */
+    						taskName,					/* Text name for the task. This is to facilitate debugging only. */
+						   (2 * configMINIMAL_STACK_SIZE),	/* Stack depth in words. 				*/
+						   (void *)&pxLot->xTask_BParam[i],	/* Receive the task name and lot as parameter.	*/
+						   (tskIDLE_PRIORITY + 2UL),	/* This task will run at priority 2. 		*/
+						   &pxLot->vTask_BHandle[i] );	/* We are using a variable as task handle.	*/
+
+		/* Check the task was created successfully. */
+		configASSERT( ret == pdPASS );
+    }
+
+    pxLot->xHeap = xFree - xPortGetFreeHeapSize();
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
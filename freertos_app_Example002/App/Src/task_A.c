@@ -62,13 +62,13 @@
 
 /* Application includes. */
 #include "app_Resources.h"
+#include "parking_Lot.h"
 #include "task_A.h"
+#include "task_Test.h"
 
 // ------ Macros and definitions ---------------------------------------
 
 // ------ internal data declaration ------------------------------------
-/* Task a Flag */
-uint32_t lTask_AFlag;
 
 // ------ internal functions declaration -------------------------------
 
@@ -79,36 +79,63 @@ uint32_t lTask_AFlag;
 const char *pcTextForTask_A    				= "  ==> Task    A - Running\r\n";
 
 const char *pcTextForTask_A_lTasksCnt		= "  <=> Task    A - lTasksCnt :";
+const char *pcTextForTask_A_Plate			= "  <=> Task    A - Plate :";
+const char *pcTextForTask_A_Duplicate		= "  <=> Task    A - Duplicate plate, not counted\r\n";
+const char *pcTextForTask_A_BadPlate		= "  <=> Task    A - Invalid plate, not counted\r\n";
 
 const char *pcTextForTask_A_WaitEntry		= "  ==> Task    A - Wait:   Entry       \r\n\n";
 const char *pcTextForTask_A_WaitContinue	= "  ==> Task    A - Wait:   Continue    \r\n\n";
 
-const char *pcTextForTask_A_WaitMutex    	= "  ==> Task    A - Wait:   Mutex       \r\n\n";
-const char *pcTextForTask_A_SignalMutex  	= "  ==> Task    A - Signal: Mutex    ==>\r\n\n";
-
 // ------ external data definition -------------------------------------
 
 // ------ internal functions definition --------------------------------
 
 // ------ external functions definition --------------------------------
 
+/*------------------------------------------------------------------*/
+BaseType_t xTask_ASignalEntry( ParkingLot_t *pxLot, uint32_t ulPlate )
+{
+	BaseType_t xResult = pdFAIL;
+
+	/* The signal is only given with the plate register empty, so
+	 * each 'take' by Task A finds the plate of its own entry. */
+	taskENTER_CRITICAL();
+	{
+		if( pxLot->ulEntryPlate == 0 )
+		{
+			pxLot->ulEntryPlate = ulPlate;
+			xResult = xTaskSignalGive( &pxLot->xSignalEntry );
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xResult;
+}
+
 /*------------------------------------------------------------------*/
 /* Task A thread */
 void vTask_A( void *pvParameters )
 {
+	/* Lot of this Task A, and its Task A Flag */
+	ParkingLot_t *pxLot = (ParkingLot_t *) pvParameters;
+	uint32_t lTask_AFlag;
+
+	char numVehicle[NUM_VEHICLE_LENGTH];
+	uint32_t ulPlate, ulCount;
+	OccupancyResult_t xEntry;
+
 	/* Print out the name of this task. */
 	vPrintString( pcTextForTask_A );
 
 	/* As per most tasks, this task is implemented within an infinite loop.
 	 *
-	 * Take the semaphore once to start with so the semaphore is empty before the
-	 * infinite loop is entered.  The semaphore was created before the scheduler
+	 * Take the signals once to start with so they are empty before the
+	 * infinite loop is entered.  The signals were created before the scheduler
 	 * was started so before this task ran for the first time.*/
-    xSemaphoreTake( xBinarySemaphoreEntry, (portTickType) 0 );
-    xSemaphoreTake( xCountingSemaphoreContinue, (portTickType) 0 );
+    xTaskSignalTake( &pxLot->xSignalEntry, (portTickType) 0 );
+    xTaskSignalTake( &pxLot->xSignalContinue, (portTickType) 0 );
 
-    /* Init Task A & B Counter and Reset Task A Flag	*/
-    lTasksCnt = 0;
+    /* Reset Task A Flag, the Task A & B Counter starts empty (appInit) */
     lTask_AFlag = 0;
 
     while( 1 )
@@ -116,59 +143,73 @@ void vTask_A( void *pvParameters )
 	    /* Toggle LD3 state */
 		HAL_GPIO_TogglePin( LD3_GPIO_Port, LD3_Pin );
 
-        /* Use the semaphore to wait for the event.  The task blocks
+        /* Use the signal to wait for the event.  The task blocks
          * indefinitely meaning this function call will only return once the
-         * semaphore has been successfully obtained - so there is no need to check
+         * signal has been successfully obtained - so there is no need to check
          * the returned value. */
     	vPrintString( pcTextForTask_A_WaitEntry );
-    	xSemaphoreTake( xBinarySemaphoreEntry, portMAX_DELAY );
+    	xTaskSignalTake( &pxLot->xSignalEntry, portMAX_DELAY );
         {
-    		/* The semaphore is created before the scheduler is started so already
-    		 * exists by the time this task executes.
-    		 *
-    		 * Attempt to take the semaphore, blocking indefinitely if the mutex is not
-    		 * available immediately.  The call to xSemaphoreTake() will only return when
-    		 * the semaphore has been successfully obtained so there is no need to check
-    		 * the return value.  If any other delay period was used then the code must
-    		 * check that xSemaphoreTake() returns pdTRUE before accessing the resource. */
-        	vPrintString( pcTextForTask_A_WaitMutex );
-    		xSemaphoreTake( xMutex, portMAX_DELAY );
-        	{
-        		/* The following line will only execute once the semaphore has been
-        		 * successfully obtained. */
-
-        		/* Update Task A & B Counter */
-    			lTasksCnt++;
-    			vPrintStringAndNumber( pcTextForTask_A_lTasksCnt, lTasksCnt);
-
-   			    /* Check Task A & B Counter	*/
-    			if( lTasksCnt == lTasksCntMAX )
+    		taskENTER_CRITICAL();
+    		{
+    			ulPlate = pxLot->ulEntryPlate;
+    			pxLot->ulEntryPlate = 0;
+    		}
+    		taskEXIT_CRITICAL();
+
+    		vOccupancyUnpackPlate( ulPlate, numVehicle );
+    		vPrintTwoStrings( pcTextForTask_A_Plate, numVehicle );
+
+    		/* Admit the vehicle: the counter only goes up while the lot is
+    		 * not full, with no mutex. A full lot waits for an exit. */
+    		while( xOccupancyCounterAdmit( &pxLot->xTasksCnt, &ulCount ) == pdFALSE )
+    		{
+    			vPrintString( pcTextForTask_A_WaitContinue );
+    			xTaskSignalTake( &pxLot->xSignalContinue, portMAX_DELAY );
+    		}
+
+    		/* Park the vehicle in the occupancy index, a plate already in
+    		 * the lot gives its admission back. The counter never admits
+    		 * more than OCCUPANCY_CAPACITY vehicles, so the index is not full. */
+    		xEntry = xOccupancyEnter( &pxLot->xIndex, ulPlate, 0, ullTimeStampTicks() );
+    		configASSERT( xEntry != OCCUPANCY_FULL );
+
+    		if( xEntry == OCCUPANCY_OK )
+    		{
+    			vPrintStringAndNumber( pcTextForTask_A_lTasksCnt, ulCount );
+
+    			/* Check Task A & B Counter	*/
+    			if( ulCount == OCCUPANCY_CAPACITY )
     			{
-       			    /* Set Task A Flag	*/
+    				/* Set Task A Flag	*/
     				lTask_AFlag = 1;
     			}
-       			/* 'Give' the semaphore to unblock the tasks. */
-       			vPrintString( pcTextForTask_A_SignalMutex );
-       			xSemaphoreGive( xMutex );
-
-   			    /* Check Task A Flag	*/
-       			if( lTask_AFlag == 1 )
-       			{
-       			    /* Reset Task A Flag	*/
-       			    lTask_AFlag = 0;
-
-       		        /* Use the semaphore to wait for the event.  The task blocks
-       		         * indefinitely meaning this function call will only return once the
-       		         * semaphore has been successfully obtained - so there is no need to check
-       		         * the returned value. */
-       			    vPrintString( pcTextForTask_A_WaitContinue );
-       	        	xSemaphoreTake( xCountingSemaphoreContinue, portMAX_DELAY );
-       	        	{
-       	        		/* The following line will only execute once the semaphore has been
-       	        		 * successfully obtained. */
-       	        	}
-       			}
-        	}
+    		}
+    		else
+    		{
+    			ulOccupancyCounterRelease( &pxLot->xTasksCnt );
+    			vPrintString( ( xEntry == OCCUPANCY_DUPLICATE ) ? pcTextForTask_A_Duplicate : pcTextForTask_A_BadPlate );
+    		}
+
+    		TEST_ENTRY_DONE();
+
+    		/* Check Task A Flag	*/
+    		if( lTask_AFlag == 1 )
+    		{
+    			/* Reset Task A Flag	*/
+    			lTask_AFlag = 0;
+
+    			/* Use the signal to wait for the event.  The task blocks
+    			 * indefinitely meaning this function call will only return once the
+    			 * signal has been successfully obtained - so there is no need to check
+    			 * the returned value. */
+    			vPrintString( pcTextForTask_A_WaitContinue );
+    			xTaskSignalTake( &pxLot->xSignalContinue, portMAX_DELAY );
+    			{
+    				/* The following line will only execute once the signal has been
+    				 * successfully obtained. */
+    			}
+    		}
         }
 	}
 }
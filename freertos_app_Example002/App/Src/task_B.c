@@ -62,15 +62,37 @@
 
 /* Application includes. */
 #include "app_Resources.h"
+#include "parking_Lot.h"
 #include "task_B.h"
+#include "vehicle_Pool.h"
+#include "monitor_Queue.h"
+#include "task_Test.h"
 
 // ------ Macros and definitions ---------------------------------------
+#if( EXIT_GATE_QUANTITY > 255 )
+	#error EXIT_GATE_QUANTITY must fit in a uint8_t
+#endif
+
+#if( ( EXIT_GATE_MODE == EXIT_GATE_QUEUE_SET ) && ( taskSIGNAL_NOTIFY == 0 ) && ( configUSE_QUEUE_SETS != 1 ) )
+	#error EXIT_GATE_QUEUE_SET needs configUSE_QUEUE_SETS, or taskSIGNAL_NOTIFY
+#endif
+
+/* Gate events that can wait in the worker pool queue. */
+#ifndef EXIT_GATE_EVENTS
+	#define EXIT_GATE_EVENTS	EXIT_GATE_QUANTITY
+#endif
 
 // ------ internal data declaration ------------------------------------
-/* Task B Flag */
-// uint32_t lTask_BFlag;
+#if( EXIT_GATE_MODE == EXIT_GATE_WORKER_POOL )
+/* Exit event of the worker pool queue of a lot */
+typedef struct {
+	uint32_t ulPlate;
+	uint8_t exitGate;
+} ExitEventStruct;
+#endif
 
 // ------ internal functions declaration -------------------------------
+static void prvTask_BExit( ParkingLot_t *pxLot, const char *taskName, uint32_t ulGate, uint32_t ulPlate );
 
 // ------ internal data definition -------------------------------------
 /* Define the strings that will be passed in as the Supporting Functions parameters.
@@ -80,107 +102,200 @@
 const char *pcTextForTask_B    					= "- Running\r\n";
 
 const char *pcTextForTask_B_lTasksCnt			= "Task B - lTasksCnt :";
+const char *pcTextForTask_B_ExitGate			= "Task B - Exit gate :";
+const char *pcTextForTask_B_Plate				= "Task B - Plate :";
+const char *pcTextForTask_B_NotFound			= "Task B - Plate not in the lot, not counted\r\n";
 
 const char *pcTextForTask_B_WaitExit			= "- Wait:   Exit\r\n\n";
 const char *pcTextForTask_B_SignalContinue   	= "- Signal: Continue\r\n\n";
 
-const char *pcTextForTask_B_WaitMutex        	= "- Wait:   Mutex\r\n\n";
-const char *pcTextForTask_B_SignalMutex      	= "- Signal: Mutex\r\n\n";
-
-MonitorQueueStruct vehicle_log;
-
 // ------ external data definition -------------------------------------
 
 // ------ internal functions definition --------------------------------
 
+/*------------------------------------------------------------------*/
+/* The vehicle with plate ulPlate leaves the lot through gate ulGate */
+static void prvTask_BExit( ParkingLot_t *pxLot, const char *taskName, uint32_t ulGate, uint32_t ulPlate )
+{
+	/* Task B Flag and Task A & B Counter after the exit */
+	uint32_t lTask_BFlag = 0;
+	uint32_t ulCount;
+
+	/* Vehicle log record, taken from the pool for each exit */
+	MonitorQueueStruct *vehicle_log;
+
+	/* Entry of the vehicle and time of its exit */
+	OccupancyEntry_t xEntry;
+	OccupancyResult_t xExit;
+	TimeStamp_t xTimeStamp;
+	uint64_t ullTick;
+	char numVehicle[NUM_VEHICLE_LENGTH];
+
+	vOccupancyUnpackPlate( ulPlate, numVehicle );
+	vPrintStringAndNumber( pcTextForTask_B_ExitGate, ulGate + 1 );
+	vPrintTwoStrings( pcTextForTask_B_Plate, numVehicle );
+
+	/* Take the vehicle out of the occupancy index, only a vehicle that
+	 * is in the lot is counted out. */
+	xExit = xOccupancyExit( &pxLot->xIndex, ulPlate, &xEntry );
+	vTimeStampGet( &xTimeStamp );
+
+	if( xExit == OCCUPANCY_OK )
+	{
+		/* Update Task A & B Counter, no mutex: each release sees its own
+		 * count, so one exit only sees the full lot become free. */
+		ulCount = ulOccupancyCounterRelease( &pxLot->xTasksCnt );
+		vPrintStringAndNumber( pcTextForTask_B_lTasksCnt, ulCount);
+
+		/* Check Task A & B Counter	*/
+		if( ulCount == (OCCUPANCY_CAPACITY - 1) )
+		{
+			/* Set Task B Flag	*/
+			lTask_BFlag = 1;
+		}
+	}
+	else
+	{
+		vPrintString( pcTextForTask_B_NotFound );
+	}
+
+	/* Check Task B Flag	*/
+	if( lTask_BFlag == 1 )
+	{
+		/* Reset Task B Flag	*/
+		lTask_BFlag = 0;
+
+		/* 'Give' the signal to unblock the task A. */
+		vPrintTwoStrings(taskName, pcTextForTask_B_SignalContinue );
+		xTaskSignalGive( &pxLot->xSignalContinue );
+	}
+
+	/* Fill a pool record and hand it over to Task Monitor, the queue
+	 * policy gives it back to the pool if it is dropped. */
+	vehicle_log = ( xExit == OCCUPANCY_OK ) ? pxVehiclePoolAlloc() : NULL;
+	if( vehicle_log != NULL )
+	{
+		ullTick = ( (uint64_t) xTimeStamp.ulTickHigh << 32 ) | xTimeStamp.ulTickLow;
+
+		vehicle_log->xTimeStamp = xTimeStamp;
+		vehicle_log->dwellTime = (uint32_t)( ( ullTick - xEntry.ullEntryTick ) * portTICK_RATE_MS );
+		vehicle_log->exitGate = (uint8_t) ulGate;
+		vehicle_log->parkingLot = pxLot->ucLot;
+		strcpy(vehicle_log->numVehicle, numVehicle);
+		( void ) xMonitorQueueSend( &xMonitorQueueVehicle, vehicle_log );
+	}
+
+	TEST_EXIT_DONE( ulGate );
+}
+
 // ------ external functions definition --------------------------------
 
 /*------------------------------------------------------------------*/
-/* Task B thread */
-void vTask_B( void *pvParameters )
+void vTask_BInit( ParkingLot_t *pxLot )
+{
+	size_t xFree = xPortGetFreeHeapSize();
+
+#if( EXIT_GATE_MODE == EXIT_GATE_QUEUE_SET )
+	/* One binary signal per gate, all of them taken by the single Task B:
+	 * semaphores in a queue set, or its task notification with
+	 * taskSIGNAL_NOTIFY and no heap at all. */
+	for( uint32_t i = 0; i < EXIT_GATE_QUANTITY; i++ )
+	{
+		vTaskSignalCreate( &pxLot->xSignalExit[i], 1, &pxLot->vTask_BHandle[0], "xBinarySemaphoreExit" );
+	}
+
+	/* The index in the set tells Task B which gate it is. */
+	vTaskSignalSetCreate( &pxLot->xSignalSetExit, pxLot->xSignalExit, EXIT_GATE_QUANTITY, "xQueueSetExit" );
+#else
+	pxLot->xQueueExit = xQueueCreate( EXIT_GATE_EVENTS, sizeof(ExitEventStruct) );
+	configASSERT( pxLot->xQueueExit != NULL );
+	vQueueAddToRegistry(pxLot->xQueueExit, "xQueueExit");
+#endif
+
+	pxLot->xGateHeap = xFree - xPortGetFreeHeapSize();
+}
+
+/*------------------------------------------------------------------*/
+BaseType_t xTask_BSignalExit( ParkingLot_t *pxLot, uint32_t ulGate, uint32_t ulPlate )
 {
+	configASSERT( ulGate < EXIT_GATE_QUANTITY );
+
+#if( EXIT_GATE_MODE == EXIT_GATE_QUEUE_SET )
+	BaseType_t xResult = pdFAIL;
+
+	/* 'Give' the signal of the gate, it wakes Task B through the set.
+	 * It is only given with the gate plate register empty, so Task B
+	 * finds the plate of this exit. */
+	taskENTER_CRITICAL();
+	{
+		if( pxLot->ulExitPlate[ulGate] == 0 )
+		{
+			pxLot->ulExitPlate[ulGate] = ulPlate;
+			xResult = xTaskSignalGive( &pxLot->xSignalExit[ulGate] );
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xResult;
+#else
+	ExitEventStruct xExitEvent = { ulPlate, (uint8_t) ulGate };
 
-	TaskHandle_t xOwnTaskHandle = xTaskGetCurrentTaskHandle();
+	return xQueueSend( pxLot->xQueueExit, &xExitEvent, 0 );
+#endif
+}
+
+/*------------------------------------------------------------------*/
+size_t xTask_BGateHeap( ParkingLot_t *pxLot )
+{
+	return pxLot->xGateHeap;
+}
 
+/*------------------------------------------------------------------*/
+/* Task B thread */
+void vTask_B( void *pvParameters )
+{
 	/* Receive parameters structure */
 	char taskName[15];
 	Task_B_Param *task_param;
 	task_param = (Task_B_Param *)pvParameters;
 	strcpy(taskName, task_param->taskName);
-	uint32_t lTask_BFlag = task_param->lTask_BFlag;
-
-	/* Print out the name of this task. */
-	vPrintTwoStrings(taskName, pcTextForTask_B );
-
-	xSemaphoreHandle xBinarySemaphoreExit = task_param->xBinarySemaphoreExit;
 
-	/* As per most tasks, this task is implemented within an infinite loop.
-	 *
-	 * Take the semaphore once to start with so the semaphore is empty before the
-	 * infinite loop is entered.  The semaphore was created before the scheduler
-	 * was started so before this task ran for the first time.*/
-    xSemaphoreTake( xBinarySemaphoreExit, (portTickType) 0 );
+	/* Lot of this Task B */
+	ParkingLot_t *pxLot = task_param->pxLot;
 
-    /* Initialize vehicle log info */
-    strcpy(vehicle_log.numVehicle, "ABC123");
-    vehicle_log.xTask_BXHandle = xOwnTaskHandle;
+	uint32_t ulGate, ulPlate;
+#if( EXIT_GATE_MODE == EXIT_GATE_WORKER_POOL )
+	ExitEventStruct xExitEvent;
+#endif
 
-    /* Reset Task B Flag	*/
-    lTask_BFlag = 0;
+	/* Print out the name of this task. */
+	vPrintTwoStrings(taskName, pcTextForTask_B );
 
     while( 1 )
     {
 	    /* Toggle LD2 state */
 		HAL_GPIO_TogglePin( LD2_GPIO_Port, LD2_Pin );
 
-		/* Use the semaphore to wait for the event.  The task blocks
-         * indefinitely meaning this function call will only return once the
-         * semaphore has been successfully obtained - so there is no need to check
-         * the returned value. */
+		/* Wait for a vehicle at any exit gate.  The task blocks indefinitely
+		 * meaning this function call will only return once a gate has been
+		 * signaled - so there is no need to check the returned value. */
 		vPrintTwoStrings(taskName, pcTextForTask_B_WaitExit );
-        xSemaphoreTake( xBinarySemaphoreExit, portMAX_DELAY );
-        {
-        	/* The semaphore is created before the scheduler is started so already
-    		 * exists by the time this task executes.
-    		 *
-    		 * Attempt to take the semaphore, blocking indefinitely if the mutex is not
-    		 * available immediately.  The call to xSemaphoreTake() will only return when
-    		 * the semaphore has been successfully obtained so there is no need to check
-    		 * the return value.  If any other delay period was used then the code must
-    		 * check that xSemaphoreTake() returns pdTRUE before accessing the resource. */
-        	vPrintTwoStrings(taskName, pcTextForTask_B_WaitMutex );
-        	xSemaphoreTake( xMutex, portMAX_DELAY );
-        	{
-        		/* The following line will only execute once the semaphore has been
-        		 * successfully obtained. */
-
-        		/* Update Task A & B Counter */
-        		lTasksCnt--;
-    			vPrintStringAndNumber( pcTextForTask_B_lTasksCnt, lTasksCnt);
-
-   			    /* Check Task A & B Counter	*/
-    			if( lTasksCnt == (lTasksCntMAX - 1) )
-    			{
-       			    /* Set Task B Flag	*/
-    				lTask_BFlag = 1;
-    			}
-    			/* 'Give' the semaphore to unblock the tasks. */
-    			vPrintTwoStrings(taskName, pcTextForTask_B_SignalMutex );
-        		xSemaphoreGive( xMutex );
-
-   			    /* Check Task B Flag	*/
-       			if( lTask_BFlag == 1 )
-       			{
-       			    /* Reset Task B Flag	*/
-       			    lTask_BFlag = 0;
-
-        			/* 'Give' the semaphore to unblock the task A. */
-       			    vPrintTwoStrings(taskName, pcTextForTask_B_SignalContinue );
-       	        	xSemaphoreGive( xCountingSemaphoreContinue );
-       			}
-        	}
-        	xQueueSend(xQueueVehicle, &vehicle_log, 0);
-        }
+#if( EXIT_GATE_MODE == EXIT_GATE_QUEUE_SET )
+		ulGate = (uint32_t) xTaskSignalSelect( &pxLot->xSignalSetExit, portMAX_DELAY );
+
+		taskENTER_CRITICAL();
+		{
+			ulPlate = pxLot->ulExitPlate[ulGate];
+			pxLot->ulExitPlate[ulGate] = 0;
+		}
+		taskEXIT_CRITICAL();
+#else
+		xQueueReceive( pxLot->xQueueExit, &xExitEvent, portMAX_DELAY );
+		ulGate = xExitEvent.exitGate;
+		ulPlate = xExitEvent.ulPlate;
+#endif
+
+		prvTask_BExit( pxLot, taskName, ulGate, ulPlate );
 	}
 }
 
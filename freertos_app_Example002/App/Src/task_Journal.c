@@ -0,0 +1,168 @@
+/* Copyright 2020, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    task_Journal.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    task file for FreeRTOS - Event Driven System (EDS) - Project for
+    STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/* Demo includes. */
+#include "supporting_Functions.h"
+#include "cycle_Counter.h"
+
+/* Application includes. */
+#include "app_Resources.h"
+#include "vehicle_Pool.h"
+#include "monitor_Queue.h"
+#include "vehicle_Journal.h"
+#include "task_Journal.h"
+
+// ------ Macros and definitions ---------------------------------------
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+
+// ------ internal data definition -------------------------------------
+/* Define the strings that will be passed in as the Supporting Functions parameters.
+ * These are defined const and off the stack to ensure they remain valid when the
+ * tasks are executing. */
+const char *pcTextForTask_Journal          = "  ==> Task Journal - Running\r\n";
+const char *pcTextForTask_Journal_Recovery = "  ==> Task Journal - Sector %lu gen %lu: %lu records, %lu corrupt, next #%lu\r\n";
+const char *pcTextForTask_Journal_Rotation = "  ==> Task Journal - Sector %lu gen %lu%s\r\n";
+
+/* Records taken by Task Journal and cycles it took */
+static uint32_t ulJournalRecords;
+static uint64_t ullJournalCycles;
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+/* Task Journal thread */
+void vTask_Journal( void *pvParameters )
+{
+	/* Pool record received from Task Monitor */
+	MonitorQueueStruct *vehicle_jnl;
+	JournalStatus_t xStatus;
+	uint32_t ulRotations, ulStart, ulCount;
+	TickType_t xWait;
+	char cLine[96];
+
+	/* Print out the name of this task. */
+	vPrintString( pcTextForTask_Journal );
+
+	/* Recover the journal left by the last run. */
+	vJournalInit();
+	vJournalGetStatus( &xStatus );
+	snprintf( cLine, sizeof( cLine ), pcTextForTask_Journal_Recovery, ( unsigned long ) xStatus.ulSector,
+			  ( unsigned long ) xStatus.ulGeneration, ( unsigned long ) xStatus.ulRecovered,
+			  ( unsigned long ) xStatus.ulCorrupt, ( unsigned long ) xStatus.ulNextSequence );
+	vPrintString( cLine );
+	ulRotations = xStatus.ulRotations;
+
+    while( 1 )
+    {
+    	/* Wait for ever only with nothing left to write. */
+    	xWait = ( ulJournalPending() != 0 ) ? pdMS_TO_TICKS( JOURNAL_FLUSH_MS ) : portMAX_DELAY;
+
+	    if( xMonitorQueueReceive(&xMonitorQueueDateTime, &vehicle_jnl, xWait) == pdPASS )
+	    {
+	    	ulStart = ulCycleCounterGet();
+	    	( void ) xJournalAppend( vehicle_jnl );
+	    	vVehiclePoolFree( vehicle_jnl );
+	    	ulCount = 1;
+	    }
+	    else
+	    {
+	    	ulStart = ulCycleCounterGet();
+	    	( void ) ulJournalFlush();
+	    	ulCount = 0;
+	    }
+
+	    taskENTER_CRITICAL();
+	    {
+	    	ulJournalRecords += ulCount;
+	    	ullJournalCycles += ulCycleCounterGet() - ulStart;
+	    }
+	    taskEXIT_CRITICAL();
+
+	    vJournalGetStatus( &xStatus );
+	    if( xStatus.ulRotations != ulRotations )
+	    {
+	    	ulRotations = xStatus.ulRotations;
+	    	snprintf( cLine, sizeof( cLine ), pcTextForTask_Journal_Rotation, ( unsigned long ) xStatus.ulSector,
+	    			  ( unsigned long ) xStatus.ulGeneration, ( xStatus.ulErrors != 0 ) ? ", flash errors" : "" );
+	    	vPrintString( cLine );
+	    }
+	}
+}
+
+/*------------------------------------------------------------------*/
+void vTask_JournalCounts( uint32_t *pulRecords, uint64_t *pullCycles )
+{
+	taskENTER_CRITICAL();
+	{
+		*pulRecords = ulJournalRecords;
+		*pullCycles = ullJournalCycles;
+	}
+	taskEXIT_CRITICAL();
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
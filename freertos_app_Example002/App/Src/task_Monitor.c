@@ -59,11 +59,18 @@
 
 /* Demo includes. */
 #include "supporting_Functions.h"
+#include "cycle_Counter.h"
 
 /* Application includes. */
 #include "app_Resources.h"
+#include "vehicle_Pool.h"
+#include "monitor_Queue.h"
+#include "task_Monitor.h"
 
 // ------ Macros and definitions ---------------------------------------
+#if( ( MONITOR_BATCH_SIZE < 1 ) || ( MONITOR_BATCH_SIZE > MAX_QUEUE_MONITOR_SIZE ) )
+	#error MONITOR_BATCH_SIZE must be 1 .. MAX_QUEUE_MONITOR_SIZE
+#endif
 
 // ------ internal data declaration ------------------------------------
 
@@ -75,6 +82,15 @@
  * tasks are executing. */
 const char *pcTextForTask_Monitor = "  ==> Task Monitor - Running\r\n";
 
+#if( MONITOR_BATCH_SIZE > 1 )
+const char *pcTextForTask_Monitor_Batch   = "  ==> Task Monitor - Batch: %lu vehicles at %s\r\n";
+const char *pcTextForTask_Monitor_Vehicle = "  Vehicle %-6s lot %3u gate %3u dwell %7lu mS exit %s\r\n";
+#endif
+
+/* Wake ups of Task Monitor, records it served and cycles it took */
+static uint32_t ulMonitorWakes, ulMonitorRecords;
+static uint64_t ullMonitorCycles;
+
 // ------ external data definition -------------------------------------
 
 // ------ internal functions definition --------------------------------
@@ -85,20 +101,104 @@ const char *pcTextForTask_Monitor = "  ==> Task Monitor - Running\r\n";
 /* Task A thread */
 void vTask_Monitor( void *pvParameters )
 {
+	/* Cycle count at the wake up */
+	uint32_t ulStart;
+
 	/* Print out the name of this task. */
 	vPrintString( pcTextForTask_Monitor );
 
-	MonitorQueueStruct vehicle_mon;
+#if( MONITOR_BATCH_SIZE == 1 )
+	/* Pool record received from Task B, edited in place */
+	MonitorQueueStruct *vehicle_mon;
+	char DateTime[TIME_STAMP_TEXT_LENGTH];
 
     while( 1 )
     {
-	    xQueueReceive(xQueueVehicle, &vehicle_mon, portMAX_DELAY);
+	    xMonitorQueueReceive(&xMonitorQueueVehicle, &vehicle_mon, portMAX_DELAY);
+	    ulStart = ulCycleCounterGet();
+
 	    vPrintString( pcTextForTask_Monitor );
-	    strcpy(vehicle_mon.DateTime, "20230613211240");
-	    vPrintTwoStrings("Vehicle Number: ", vehicle_mon.numVehicle);
-	    vPrintTwoStrings("Vehicle Date: ", vehicle_mon.DateTime);
-	    xQueueSend(xQueueVehicleDateTime, &vehicle_mon, 0);
+	    xTimeStampFormat(&vehicle_mon->xTimeStamp, DateTime, sizeof(DateTime));
+	    vPrintTwoStrings("Vehicle Number: ", vehicle_mon->numVehicle);
+	    vPrintStringAndNumber("Vehicle Lot: ", vehicle_mon->parkingLot + 1);
+	    vPrintStringAndNumber("Vehicle Gate: ", vehicle_mon->exitGate + 1);
+	    vPrintStringAndNumber("Vehicle Dwell (mS): ", vehicle_mon->dwellTime);
+	    vPrintTwoStrings("Vehicle Date: ", DateTime);
+
+	    /* Hand the record over, the queue policy decides if it is kept. */
+	    ( void ) xMonitorQueueSend(&xMonitorQueueDateTime, vehicle_mon);
+
+	    taskENTER_CRITICAL();
+	    {
+	    	ulMonitorWakes++;
+	    	ulMonitorRecords++;
+	    	ullMonitorCycles += ulCycleCounterGet() - ulStart;
+	    }
+	    taskEXIT_CRITICAL();
+	}
+#else
+	/* Pool records received from Task B in one wake up */
+	MonitorQueueStruct *vehicle_mon[MONITOR_BATCH_SIZE];
+	uint32_t ulCount, i;
+	TimeStamp_t xBatchStamp;
+	char DateTime[TIME_STAMP_TEXT_LENGTH];
+	char cLine[96];
+
+    while( 1 )
+    {
+    	/* Block for the first record, then take what is already queued. */
+	    xMonitorQueueReceive(&xMonitorQueueVehicle, &vehicle_mon[0], portMAX_DELAY);
+	    ulStart = ulCycleCounterGet();
+	    for( ulCount = 1; ulCount < MONITOR_BATCH_SIZE; ulCount++ )
+	    {
+	    	if( xMonitorQueueReceive(&xMonitorQueueVehicle, &vehicle_mon[ulCount], 0) != pdPASS )
+	    	{
+	    		break;
+	    	}
+	    }
+	    /* One stamp and one report for the whole batch */
+	    vTimeStampGet(&xBatchStamp);
+	    xTimeStampFormat(&xBatchStamp, DateTime, sizeof(DateTime));
+	    snprintf(cLine, sizeof(cLine), pcTextForTask_Monitor_Batch, (unsigned long) ulCount, DateTime);
+	    vPrintString( cLine );
+
+	    for( i = 0; i < ulCount; i++ )
+	    {
+	    	xTimeStampFormat(&vehicle_mon[i]->xTimeStamp, DateTime, sizeof(DateTime));
+	    	snprintf(cLine, sizeof(cLine), pcTextForTask_Monitor_Vehicle, vehicle_mon[i]->numVehicle,
+	    			 (unsigned int)(vehicle_mon[i]->parkingLot + 1), (unsigned int)(vehicle_mon[i]->exitGate + 1),
+	    			 (unsigned long) vehicle_mon[i]->dwellTime, DateTime);
+	    	vPrintString( cLine );
+	    }
+
+	    /* Hand the records over in order, the queue policy decides which
+	     * of them are kept. */
+	    for( i = 0; i < ulCount; i++ )
+	    {
+	    	( void ) xMonitorQueueSend(&xMonitorQueueDateTime, vehicle_mon[i]);
+	    }
+
+	    taskENTER_CRITICAL();
+	    {
+	    	ulMonitorWakes++;
+	    	ulMonitorRecords += ulCount;
+	    	ullMonitorCycles += ulCycleCounterGet() - ulStart;
+	    }
+	    taskEXIT_CRITICAL();
+	}
+#endif
+}
+
+/*------------------------------------------------------------------*/
+void vTask_MonitorCounts( uint32_t *pulWakes, uint32_t *pulRecords, uint64_t *pullCycles )
+{
+	taskENTER_CRITICAL();
+	{
+		*pulWakes = ulMonitorWakes;
+		*pulRecords = ulMonitorRecords;
+		*pullCycles = ullMonitorCycles;
 	}
+	taskEXIT_CRITICAL();
 }
 
 /*------------------------------------------------------------------*-
@@ -59,18 +59,47 @@
 
 /* Demo includes. */
 #include "supporting_Functions.h"
+#include "cycle_Counter.h"
+#include "bench_Stats.h"
+#include "traffic_Gen.h"
 
 /* Application includes. */
 #include "app_Resources.h"
+#include "parking_Lot.h"
+#include "task_A.h"
+#include "task_B.h"
+#include "vehicle_Pool.h"
+#include "monitor_Queue.h"
+#include "vehicle_Journal.h"
+#include "occupancy_Index.h"
 #include "task_Test.h"
 
 // ------ Macros and definitions ---------------------------------------
 
 // ------ internal data declaration ------------------------------------
-/* Events to excite tasks */
-typedef enum eTask_Test{ Error, Entry, Exit, Exit2 } eTask_Test_t;
+/* Events to excite tasks, a vehicle at exit gate g is ( Exit + g ) */
+typedef enum eTask_Test{ Error, Entry, Exit } eTask_Test_t;
+
+#define Exit2	( Exit + 1 )
+
+/* Lot of the demo and the traffic test */
+#define TEST_LOT		( &xParkingLot[0] )
+
+/* Plates signaled at the entry and not at an exit yet, oldest first */
+#define TEST_PLATES		( 2 * OCCUPANCY_CAPACITY )
 
 // ------ internal functions declaration -------------------------------
+static uint32_t prvTask_TestNewPlate( void );
+static uint32_t prvTask_TestOldPlate( void );
+
+#if( TEST_TRAFFIC == 1 )
+static void prvTask_TestDiscard( const char *pcData, size_t xLength );
+#endif
+
+#if( TEST_TRAFFIC == 1 )
+static void prvTask_TestTraffic( void );
+static void prvTask_TestQueueStats( MonitorQueue_t *pxQueue );
+#endif
 
 // ------ internal data definition -------------------------------------
 /* Define the strings that will be passed in as the Supporting Functions parameters.
@@ -83,8 +112,8 @@ const char *pcTextForTask_Test_priority			 	= "  <=> Tesk Test - priority:";
 const char *pcTextForTask_Test_eTask_TestArrayIndex	= "  <=> Task Test - eTask_TestArray Index :";
 
 const char *pcTextForTask_Test_SignalEntry 			= "  <=> Task Test - Signal: Entry  <=>\r\n";
-const char *pcTextForTask_Test_SignalExit			= "  ==> Task Test - Signal: Exit   <=>\r\n";
-const char *pcTextForTask_Test_SignalExit2			= "  ==> Task Test - Signal: Exit 2  <=>\r\n";
+const char *pcTextForTask_Test_SignalExit			= "  ==> Task Test - Signal: Exit gate :";
+const char *pcTextForTask_Test_Plate				= "  <=> Task Test - Plate :";
 const char *pcTextForTask_Test_SignalError			= "  <=> Task Test - Signal: Error  <=>\r\n";
 const char *pcTextForTask_Test_Wait5000mS			= "  <=> Task Test - Wait:   5000mS <=>\r\n\n";
 
@@ -120,10 +149,268 @@ const eTask_Test_t eTask_TestArray[] = { Entry, Entry, Entry, Entry, Entry, Exit
 const eTask_Test_t eTask_TestArray[] = { Entry, Entry, Entry, Entry, Entry, Entry, Exit, Exit, Exit, Exit, Exit, Exit };
 #endif
 
+#if( TEST_TRAFFIC == 1 )
+const char *pcTextForTask_Test_Traffic				= "  <=> Task Test - Traffic: %s %lu/s burst %lu, gates %s, %lu%% entries, seed %lu\r\n";
+const char *pcTextForTask_Test_TrafficScript		= "  <=> Task Test - Traffic: events of TEST_X :";
+const char *pcTextForTask_Test_TrafficClock			= "  <=> Task Test - Traffic: core clock (Hz) :";
+const char *pcTextForTask_Test_TrafficRun			= "  <=> Task Test - Traffic: events %lu in %lu mS, %lu events/s\r\n";
+const char *pcTextForTask_Test_TrafficGates			= "  <=> Task Test - Traffic: entries %lu exits %lu, lost at the gates %lu, errors %lu\r\n";
+const char *pcTextForTask_Test_TrafficPool			= "  <=> Task Test - Traffic: pool empty %lu, journal full %lu\r\n";
+const char *pcTextForTask_Test_TrafficQueue			= "  <=> Task Test - Queue %s %s: sent %lu dropped %lu, high water %lu of %lu\r\n";
+const char *pcTextForTask_Test_TrafficQueueWait		= "  <=> Task Test - Queue %s: spilled %lu, blocked %lu times %lu uS\r\n";
+const char *pcTextForTask_Test_TrafficDone			= "  <=> Task Test - Traffic: done\r\n\n";
+
+/* Gate weights for trafficGATES_WEIGHTED */
+#ifdef TEST_TRAFFIC_WEIGHTS
+static const uint8_t ucTask_TestWeights[ EXIT_GATE_QUANTITY ] = TEST_TRAFFIC_WEIGHTS;
+	#define TEST_TRAFFIC_WEIGHT_TABLE	ucTask_TestWeights
+#else
+	#define TEST_TRAFFIC_WEIGHT_TABLE	NULL
+#endif
+
+/* Signal to done latency, of the entry and of an exit at each gate. A
+ * signal is stamped only when the last one is done. */
+static BenchStats_t xTask_TestEntryLatency, xTask_TestExitLatency;
+static uint32_t ulTask_TestEntryStamp, ulTask_TestExitStamp[ EXIT_GATE_QUANTITY ];
+static bool bTask_TestEntryPending, bTask_TestExitPending[ EXIT_GATE_QUANTITY ];
+#endif
+
+/* Plates of the vehicles sent in, for the exits to send them out */
+static uint32_t ulTask_TestPlate[TEST_PLATES];
+static uint32_t ulTask_TestPlateHead, ulTask_TestPlateCount, ulTask_TestPlateNumber;
+
 // ------ external data definition -------------------------------------
 
 // ------ internal functions definition --------------------------------
 
+/*------------------------------------------------------------------*/
+/* Next test plate "TST000" ... "TST999" */
+static uint32_t prvTask_TestNewPlate( void )
+{
+	char numVehicle[NUM_VEHICLE_LENGTH];
+
+	snprintf( numVehicle, sizeof( numVehicle ), "TST%03lu", ( unsigned long )( ulTask_TestPlateNumber % 1000 ) );
+	ulTask_TestPlateNumber++;
+
+	return ulOccupancyPackPlate( numVehicle );
+}
+
+/*------------------------------------------------------------------*/
+/* Oldest plate sent in, or a plate that never came in */
+static uint32_t prvTask_TestOldPlate( void )
+{
+	uint32_t ulPlate;
+
+	if( ulTask_TestPlateCount == 0 )
+	{
+		return ulOccupancyPackPlate( "ZZZ999" );
+	}
+
+	ulPlate = ulTask_TestPlate[ulTask_TestPlateHead];
+	ulTask_TestPlateHead = ( ulTask_TestPlateHead + 1 ) % TEST_PLATES;
+	ulTask_TestPlateCount--;
+
+	return ulPlate;
+}
+
+#if( TEST_TRAFFIC == 1 )
+/*------------------------------------------------------------------*/
+/* Console sink that throws away the task A and B lines while measuring */
+static void prvTask_TestDiscard( const char *pcData, size_t xLength )
+{
+	( void ) pcData;
+	( void ) xLength;
+}
+#endif
+
+#if( TEST_TRAFFIC == 1 )
+/*------------------------------------------------------------------*/
+/* Send TEST_TRAFFIC_EVENTS events of the traffic generator: an entry
+ * with a new plate, or an exit of the oldest plate sent in. Print the
+ * rate achieved, the events lost at the gates (entry or gate still
+ * busy) and on the way to the journal, and the signal to done latency.
+ * Task Test runs below Task A and Task B, so a signal runs the task it
+ * wakes up before the next event is sent. */
+static void prvTask_TestTraffic( void )
+{
+	char cLine[ 96 ];
+	const TrafficConfig_t xConfig = { TEST_TRAFFIC_PATTERN, TEST_TRAFFIC_GATES, TEST_TRAFFIC_ENTRY_PERCENT,
+									  TEST_TRAFFIC_RATE, TEST_TRAFFIC_BURST, EXIT_GATE_QUANTITY,
+									  TEST_TRAFFIC_WEIGHT_TABLE, TEST_TRAFFIC_SEED };
+	TrafficGen_t xGen;
+	TrafficEvent_t xEvent;
+	JournalStatus_t xJournal;
+	eTask_Test_t eEvent;
+	uint32_t ulEvent, ulGate, ulPlate, ulNow, ulLast;
+	uint32_t ulEntries = 0, ulExits = 0, ulLost = 0, ulErrors = 0;
+	uint32_t ulJournalDrops, ulPoolFailures;
+	uint64_t ullCycles = 0;
+	UBaseType_t uxPriority = uxTaskPriorityGet( NULL );
+	TickType_t xStart;
+	BaseType_t xResult;
+	bool bStamp;
+
+	vCycleCounterInit();
+
+	snprintf( cLine, sizeof( cLine ), pcTextForTask_Test_Traffic, pcTrafficGenPattern( xConfig.ucPattern ),
+			  ( unsigned long ) xConfig.ulRate, ( unsigned long ) xConfig.ulBurst, pcTrafficGenGates( xConfig.ucGates ),
+			  ( unsigned long ) xConfig.ucEntryPercent, ( unsigned long ) xConfig.ulSeed );
+	vPrintString( cLine );
+#if( TEST_TRAFFIC_SCRIPT == 1 )
+	vPrintStringAndNumber( pcTextForTask_Test_TrafficScript, TEST_X );
+#endif
+	vPrintStringAndNumber( pcTextForTask_Test_TrafficClock, SystemCoreClock );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	vBenchStatsReset( &xTask_TestEntryLatency );
+	vBenchStatsReset( &xTask_TestExitLatency );
+	vMonitorQueueResetStats( &xMonitorQueueVehicle );
+	vMonitorQueueResetStats( &xMonitorQueueDateTime );
+	vJournalGetStatus( &xJournal );
+	ulJournalDrops = xJournal.ulDropped;
+	ulPoolFailures = ulVehiclePoolAllocFailures();
+
+	vLogSetSink( prvTask_TestDiscard );
+	vTaskPrioritySet( NULL, tskIDLE_PRIORITY + 1UL );
+
+	vTrafficGenInit( &xGen, &xConfig );
+	xStart = xTaskGetTickCount();
+	ulLast = ulCycleCounterGet();
+	for( ulEvent = 0; ulEvent < TEST_TRAFFIC_EVENTS; ulEvent++ )
+	{
+		vTrafficGenNext( &xGen, &xEvent );
+#if( TEST_TRAFFIC_SCRIPT == 1 )
+		eEvent = eTask_TestArray[ ulEvent % ( sizeof( eTask_TestArray ) / sizeof( eTask_Test_t ) ) ];
+#else
+		eEvent = ( xEvent.ucEntry != 0 ) ? Entry : ( eTask_Test_t )( Exit + xEvent.ulGate );
+#endif
+		vTrafficGenWait( xStart, &xEvent );
+
+		if( eEvent == Entry )
+		{
+			/* Task A is done with the entry before the signal returns. */
+			ulEntries++;
+			ulPlate = prvTask_TestNewPlate();
+			taskENTER_CRITICAL();
+			{
+				bStamp = !bTask_TestEntryPending;
+				if( bStamp )
+				{
+					bTask_TestEntryPending = true;
+					ulTask_TestEntryStamp = ulCycleCounterGet();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xTask_ASignalEntry( TEST_LOT, ulPlate ) == pdPASS )
+			{
+				if( ulTask_TestPlateCount < TEST_PLATES )
+				{
+					ulTask_TestPlate[( ulTask_TestPlateHead + ulTask_TestPlateCount ) % TEST_PLATES] = ulPlate;
+					ulTask_TestPlateCount++;
+				}
+			}
+			else
+			{
+				ulLost++;
+				if( bStamp )
+				{
+					bTask_TestEntryPending = false;
+				}
+			}
+		}
+		else if( ( eEvent >= Exit ) && ( ( uint32_t )( eEvent - Exit ) < EXIT_GATE_QUANTITY ) )
+		{
+			ulExits++;
+			ulGate = eEvent - Exit;
+			taskENTER_CRITICAL();
+			{
+				bStamp = !bTask_TestExitPending[ ulGate ];
+				if( bStamp )
+				{
+					bTask_TestExitPending[ ulGate ] = true;
+					ulTask_TestExitStamp[ ulGate ] = ulCycleCounterGet();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			xResult = xTask_BSignalExit( TEST_LOT, ulGate, prvTask_TestOldPlate() );
+			if( xResult != pdPASS )
+			{
+				ulLost++;
+				if( bStamp )
+				{
+					bTask_TestExitPending[ ulGate ] = false;
+				}
+			}
+		}
+		else
+		{
+			ulErrors++;
+		}
+
+		/* Wall time, in steps shorter than a cycle counter wrap */
+		ulNow = ulCycleCounterGet();
+		ullCycles += ulNow - ulLast;
+		ulLast = ulNow;
+	}
+
+	/* The last records reach the journal, and the drain throws away
+	 * the task lines. */
+	vTaskDelay( pdMS_TO_TICKS( 100 ) );
+	vTaskPrioritySet( NULL, uxPriority );
+	vLogSetSink( NULL );
+
+	snprintf( cLine, sizeof( cLine ), pcTextForTask_Test_TrafficRun, ( unsigned long ) TEST_TRAFFIC_EVENTS,
+			  ( unsigned long )( ( ullCycles * 1000 ) / SystemCoreClock ),
+			  ( unsigned long )( ( ( uint64_t ) TEST_TRAFFIC_EVENTS * SystemCoreClock ) / ( ullCycles ? ullCycles : 1 ) ) );
+	vPrintString( cLine );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	snprintf( cLine, sizeof( cLine ), pcTextForTask_Test_TrafficGates, ( unsigned long ) ulEntries,
+			  ( unsigned long ) ulExits, ( unsigned long ) ulLost, ( unsigned long ) ulErrors );
+	vPrintString( cLine );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	vJournalGetStatus( &xJournal );
+	snprintf( cLine, sizeof( cLine ), pcTextForTask_Test_TrafficPool,
+			  ( unsigned long )( ulVehiclePoolAllocFailures() - ulPoolFailures ),
+			  ( unsigned long )( xJournal.ulDropped - ulJournalDrops ) );
+	vPrintString( cLine );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	prvTask_TestQueueStats( &xMonitorQueueVehicle );
+	prvTask_TestQueueStats( &xMonitorQueueDateTime );
+
+	vBenchStatsPrint( "Entry", "cycles", &xTask_TestEntryLatency );
+	vBenchStatsPrint( "Exit ", "cycles", &xTask_TestExitLatency );
+
+	vPrintString( pcTextForTask_Test_TrafficDone );
+}
+
+/*------------------------------------------------------------------*/
+/* Print the counters of a monitor queue since the run started */
+static void prvTask_TestQueueStats( MonitorQueue_t *pxQueue )
+{
+	char cLine[ 96 ];
+	MonitorQueueStats_t xStats;
+
+	vMonitorQueueGetStats( pxQueue, &xStats );
+	snprintf( cLine, sizeof( cLine ), pcTextForTask_Test_TrafficQueue, pxQueue->pcName,
+			  pcMonitorQueuePolicy( pxQueue->ucPolicy ), ( unsigned long ) xStats.ulSends,
+			  ( unsigned long ) xStats.ulDrops, ( unsigned long ) xStats.ulHighWater,
+			  ( unsigned long ) ulMonitorQueueCapacity( pxQueue ) );
+	vPrintString( cLine );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	snprintf( cLine, sizeof( cLine ), pcTextForTask_Test_TrafficQueueWait, pxQueue->pcName,
+			  ( unsigned long ) xStats.ulSpills, ( unsigned long ) xStats.ulBlocks,
+			  ( unsigned long )( ( xStats.ullBlockedCycles * 1000000 ) / SystemCoreClock ) );
+	vPrintString( cLine );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+}
+#endif
+
 // ------ external functions definition --------------------------------
 
 /*------------------------------------------------------------------*/
@@ -131,6 +418,8 @@ const eTask_Test_t eTask_TestArray[] = { Entry, Entry, Entry, Entry, Entry, Entr
 void vTask_Test( void *pvParameters )
 {
 	uint32_t i = TEST_X;
+	uint32_t ulPlate;
+	char numVehicle[NUM_VEHICLE_LENGTH];
 	portTickType xLastWakeTime;
 	UBaseType_t uxPriority;
 
@@ -157,6 +446,14 @@ void vTask_Test( void *pvParameters )
 	vPrintStringAndNumber( pcTextForTask_Test_priority, uxPriority );
 	vTaskPrioritySet( vTask_TestHandle, uxPriority );
 
+#if( TEST_BENCHMARK != 0 )
+	vTestBenchRun();
+	vTaskDelete( NULL );
+#elif( TEST_TRAFFIC == 1 )
+	prvTask_TestTraffic();
+	vTaskDelete( NULL );
+#endif
+
 	while( 1 )
 	{
 		/* Scanning the array of events to excite tasks */
@@ -172,28 +469,37 @@ void vTask_Test( void *pvParameters )
 
 	    		case Entry:
 
-				    /* 'Give' the semaphore to unblock the task A. */
+				    /* 'Give' the semaphore to unblock the task A, with a new
+				     * plate. It is kept for an exit only if Task A gets it. */
 		    		vPrintString( pcTextForTask_Test_SignalEntry );
-					xSemaphoreGive( xBinarySemaphoreEntry );
+		    		ulPlate = prvTask_TestNewPlate();
+		    		vOccupancyUnpackPlate( ulPlate, numVehicle );
+		    		vPrintTwoStrings( pcTextForTask_Test_Plate, numVehicle );
+					if( ( xTask_ASignalEntry( TEST_LOT, ulPlate ) == pdPASS ) && ( ulTask_TestPlateCount < TEST_PLATES ) )
+					{
+						ulTask_TestPlate[( ulTask_TestPlateHead + ulTask_TestPlateCount ) % TEST_PLATES] = ulPlate;
+						ulTask_TestPlateCount++;
+					}
 	    			break;
 
-	    		case Exit:
-
-				    /* 'Give' the semaphore to unblock the task B1. */
-		    		vPrintString( pcTextForTask_Test_SignalExit );
-		    		xSemaphoreGive( xBinarySemaphoreExit[0] );
-	    			break;
+		    	case Error:
 
-	    		case Exit2:
-	    			/* 'Give' the semaphore to unblock the task B2. */
-					vPrintString( pcTextForTask_Test_SignalExit2 );
-					xSemaphoreGive( xBinarySemaphoreExit[1] );
-					break;
+		    		vPrintString( pcTextForTask_Test_SignalError );
+		    		break;
 
-		    	case Error:
 		    	default:
 
-		    		vPrintString( pcTextForTask_Test_SignalError );
+		    		/* Exit at gate ( event - Exit ) of the oldest vehicle sent
+		    		 * in, unblocks Task B. */
+		    		if( (uint32_t)(eTask_TestArray[i] - Exit) < EXIT_GATE_QUANTITY )
+		    		{
+		    			vPrintStringAndNumber( pcTextForTask_Test_SignalExit, eTask_TestArray[i] - Exit + 1 );
+		    			xTask_BSignalExit( TEST_LOT, eTask_TestArray[i] - Exit, prvTask_TestOldPlate() );
+		    		}
+		    		else
+		    		{
+		    			vPrintString( pcTextForTask_Test_SignalError );
+		    		}
 		    		break;
 		    }
 		    /* About a 5000 mS delay here */
@@ -208,6 +514,43 @@ void vTask_Test( void *pvParameters )
 	}
 }
 
+#if( TEST_TRAFFIC == 1 )
+/*------------------------------------------------------------------*/
+/* Called by Task A once it is done with an entry */
+void vTask_TestTrafficEntry( void )
+{
+	uint32_t ulNow = ulCycleCounterGet();
+
+	taskENTER_CRITICAL();
+	{
+		if( bTask_TestEntryPending )
+		{
+			bTask_TestEntryPending = false;
+			vBenchStatsAdd( &xTask_TestEntryLatency, ulNow - ulTask_TestEntryStamp );
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
+/*------------------------------------------------------------------*/
+/* Called by Task B once it is done with an exit, the Task B workers
+ * share the exit latency histogram */
+void vTask_TestTrafficExit( uint32_t ulGate )
+{
+	uint32_t ulNow = ulCycleCounterGet();
+
+	taskENTER_CRITICAL();
+	{
+		if( bTask_TestExitPending[ ulGate ] )
+		{
+			bTask_TestExitPending[ ulGate ] = false;
+			vBenchStatsAdd( &xTask_TestExitLatency, ulNow - ulTask_TestExitStamp[ ulGate ] );
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+#endif
+
 /*------------------------------------------------------------------*-
   ---- END OF FILE -------------------------------------------------
 -*------------------------------------------------------------------*/
@@ -0,0 +1,659 @@
+/* Copyright 2020, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    test_Bench.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    test bench file for FreeRTOS - Event Driven System (EDS) - Project
+    for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdbool.h>
+
+/* Demo includes. */
+#include "supporting_Functions.h"
+#include "cycle_Counter.h"
+#include "bench_Stats.h"
+
+/* Application includes. */
+#include "app_Resources.h"
+#include "parking_Lot.h"
+#include "task_A.h"
+#include "task_B.h"
+#include "task_Monitor.h"
+#include "task_Journal.h"
+#include "vehicle_Pool.h"
+#include "vehicle_Journal.h"
+#include "occupancy_Index.h"
+#include "task_Test.h"
+#include "test_Bench.h"
+
+// ------ Macros and definitions ---------------------------------------
+/* Lot of the gate benchmark */
+#define TEST_LOT		( &xParkingLot[0] )
+
+#if( ( TEST_BENCHMARK == 1 ) && ( OCCUPANCY_CAPACITY < EXIT_GATE_QUANTITY ) )
+	#error The benchmark parks a vehicle per gate: OCCUPANCY_CAPACITY >= EXIT_GATE_QUANTITY
+#endif
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+#if( TEST_BENCHMARK == 1 )
+static void prvTestBenchGates( void );
+#endif
+
+#if( TEST_BENCHMARK == 2 )
+static void prvTestBenchGate( void *pvParameters );
+static void prvTestBenchContention( void );
+#endif
+
+#if( TEST_BENCHMARK == 3 )
+static void prvTestBenchJournal( void );
+#endif
+
+#if( TEST_BENCHMARK == 4 )
+static void prvTestBenchLots( void );
+static void prvTestBenchLotsRound( uint32_t ulLots, uint32_t ulRound, bool bEntry );
+#endif
+
+#if( ( TEST_BENCHMARK == 1 ) || ( TEST_BENCHMARK == 4 ) )
+static void prvTestBenchDiscard( const char *pcData, size_t xLength );
+#endif
+
+#if( TEST_BENCHMARK == 3 )
+static uint32_t prvTestBenchNewPlate( void );
+#endif
+
+// ------ internal data definition -------------------------------------
+/* Define the strings that will be passed in as the Supporting Functions parameters.
+ * These are defined const and off the stack to ensure they remain valid when the
+ * tasks are executing. */
+#if( TEST_BENCHMARK == 1 )
+const char *pcTextForTestBench_Benchmark			= "  <=> Task Test - Benchmark: rounds per gate count :";
+const char *pcTextForTestBench_BenchmarkClock		= "  <=> Task Test - Benchmark: core clock (Hz) :";
+const char *pcTextForTestBench_BenchmarkHeap		= "  <=> Task Test - Benchmark: exit gates %lu mode %lu heap %lu B (%lu B per gate)\r\n";
+const char *pcTextForTestBench_BenchmarkGates		= "  <=> Task Test - Benchmark: gates %3lu events %6lu cycles/event %7lu events/s %7lu\r\n";
+const char *pcTextForTestBench_BenchmarkMonitor		= "  <=> Task Test - Benchmark: monitor wakes %6lu records %6lu cycles/record %7lu\r\n";
+const char *pcTextForTestBench_BenchmarkDone		= "  <=> Task Test - Benchmark: done\r\n\n";
+#endif
+
+#if( TEST_BENCHMARK == 2 )
+const char *pcTextForTestBench_Counter				= "  <=> Task Test - Counter: admit and release per gate task :";
+const char *pcTextForTestBench_CounterClock			= "  <=> Task Test - Counter: core clock (Hz) :";
+const char *pcTextForTestBench_CounterRun			= "  <=> Task Test - Counter: tasks %2lu %-6s cycles/op %6lu full %7lu waits %7lu\r\n";
+const char *pcTextForTestBench_CounterHeap			= "  <=> Task Test - Counter: tasks %2lu not enough heap, %lu created\r\n";
+const char *pcTextForTestBench_CounterDone			= "  <=> Task Test - Counter: done\r\n\n";
+
+/* Gate tasks of each run, a run with the lock-free counter and one with
+ * xTestBenchMutex */
+static const uint32_t ulTestBenchGateTasks[] = { 2, 8, 32 };
+
+/* Counters under test, and the lot full and lock waits of the gate tasks */
+static OccupancyCounter_t xTestBenchCounter;
+static SemaphoreHandle_t xTestBenchMutex;
+static uint32_t ulTestBenchMutexCount;
+static BaseType_t xTestBenchUseMutex;
+static uint32_t ulTestBenchFull, ulTestBenchWaits;
+#endif
+
+#if( TEST_BENCHMARK == 3 )
+const char *pcTextForTestBench_Journal				= "  <=> Task Test - Journal: records :";
+const char *pcTextForTestBench_JournalClock			= "  <=> Task Test - Journal: core clock (Hz) :";
+const char *pcTextForTestBench_JournalPage			= "  <=> Task Test - Journal: page %lu B, %lu records per sector, %lu sectors\r\n";
+const char *pcTextForTestBench_JournalRun			= "  <=> Task Test - Journal: records %6lu pages %5lu rotations %3lu dropped %lu errors %lu\r\n";
+const char *pcTextForTestBench_JournalCycles		= "  <=> Task Test - Journal: cycles/record %7lu records/s %7lu\r\n";
+const char *pcTextForTestBench_JournalDone			= "  <=> Task Test - Journal: done\r\n\n";
+
+/* Plates of the records sent */
+static uint32_t ulTestBenchPlateNumber;
+#endif
+
+#if( TEST_BENCHMARK == 4 )
+const char *pcTextForTestBench_Lots					= "  <=> Task Test - Lots: rounds per lot count :";
+const char *pcTextForTestBench_LotsClock			= "  <=> Task Test - Lots: core clock (Hz) :";
+const char *pcTextForTestBench_LotsHeap				= "  <=> Task Test - Lots: %lu built, heap %lu B per lot, %lu B free\r\n";
+const char *pcTextForTestBench_LotsRun				= "  <=> Task Test - Lots %3lu: events %6lu cycles/event %6lu events/s %7lu\r\n";
+const char *pcTextForTestBench_LotsSkip				= "  <=> Task Test - Lots %3lu: more than PARKING_LOTS, skipped\r\n";
+const char *pcTextForTestBench_LotsDone				= "  <=> Task Test - Lots: done\r\n\n";
+
+/* Lots of each run */
+static const uint32_t ulTestBenchLots[] = { 1, 2, 3 };
+#endif
+
+#if( TEST_BENCHMARK != 0 )
+/* Entries and exits served by Task A and Task B (or gate tasks done),
+ * and how many the round is waiting for */
+static volatile uint32_t ulTestBenchDone;
+static uint32_t ulTestBenchTarget;
+#endif
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+#if( ( TEST_BENCHMARK == 1 ) || ( TEST_BENCHMARK == 4 ) )
+/*------------------------------------------------------------------*/
+/* Console sink that throws away the task A and B lines while measuring */
+static void prvTestBenchDiscard( const char *pcData, size_t xLength )
+{
+	( void ) pcData;
+	( void ) xLength;
+}
+#endif
+
+#if( TEST_BENCHMARK == 3 )
+/*------------------------------------------------------------------*/
+/* Next benchmark plate "TST000" ... "TST999" */
+static uint32_t prvTestBenchNewPlate( void )
+{
+	char numVehicle[NUM_VEHICLE_LENGTH];
+
+	snprintf( numVehicle, sizeof( numVehicle ), "TST%03lu", ( unsigned long )( ulTestBenchPlateNumber % 1000 ) );
+	ulTestBenchPlateNumber++;
+
+	return ulOccupancyPackPlate( numVehicle );
+}
+#endif
+
+#if( TEST_BENCHMARK == 1 )
+/*------------------------------------------------------------------*/
+/* Signal gates 0 .. n-1 once per round, for n = 1, 2, 4 ... and
+ * EXIT_GATE_QUANTITY, and wait for Task B and Task Monitor to serve
+ * each round. The vehicles are parked before the round starts. The
+ * time of a round covers the gives, the Task B wake ups, the full exit
+ * (mutex, occupancy index, vehicle record, queue to Task Monitor) and
+ * the Task Monitor reports (MONITOR_BATCH_SIZE per wake up). */
+static void prvTestBenchGates( void )
+{
+	char cLine[ 96 ];
+	uint32_t ulGates = 1, ulRound, ulGate, ulStart, ulEvents, ulCount;
+	uint32_t ulWakes, ulRecords, ulWakesEnd, ulRecordsEnd;
+	uint64_t ullCycles, ullMonitorCycles, ullMonitorCyclesEnd;
+	UBaseType_t uxPriority = uxTaskPriorityGet( NULL );
+	BaseType_t xResult;
+
+	vCycleCounterInit();
+
+	vPrintStringAndNumber( pcTextForTestBench_Benchmark, TEST_BENCHMARK_ROUNDS );
+	vPrintStringAndNumber( pcTextForTestBench_BenchmarkClock, SystemCoreClock );
+	snprintf( cLine, sizeof( cLine ), pcTextForTestBench_BenchmarkHeap,
+			  ( unsigned long ) EXIT_GATE_QUANTITY, ( unsigned long ) EXIT_GATE_MODE,
+			  ( unsigned long ) xTask_BGateHeap( TEST_LOT ), ( unsigned long )( xTask_BGateHeap( TEST_LOT ) / EXIT_GATE_QUANTITY ) );
+	vPrintString( cLine );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	for( ;; )
+	{
+		ullCycles = 0;
+		ulEvents = 0;
+		vTask_MonitorCounts( &ulWakes, &ulRecords, &ullMonitorCycles );
+
+		vLogSetSink( prvTestBenchDiscard );
+		for( ulRound = 0; ulRound < TEST_BENCHMARK_ROUNDS; ulRound++ )
+		{
+			ulTestBenchDone = 0;
+			ulTestBenchTarget = ulGates;
+
+			/* One vehicle per gate in the lot, plate ( gate + 1 ). */
+			for( ulGate = 0; ulGate < ulGates; ulGate++ )
+			{
+				xResult = xOccupancyCounterAdmit( &TEST_LOT->xTasksCnt, &ulCount );
+				configASSERT( xResult == pdTRUE );
+				xResult = ( xOccupancyEnter( &TEST_LOT->xIndex, ulGate + 1, 0, ullTimeStampTicks() ) == OCCUPANCY_OK ) ? pdPASS : pdFAIL;
+				configASSERT( xResult == pdPASS );
+			}
+
+			/* Task B has a lower priority: it runs once this task blocks.
+			 * At the idle priority this task gets the notification back
+			 * only when Task Monitor is done with the records too. */
+			ulStart = ulCycleCounterGet();
+			for( ulGate = 0; ulGate < ulGates; ulGate++ )
+			{
+				xResult = xTask_BSignalExit( TEST_LOT, ulGate, ulGate + 1 );
+				configASSERT( xResult == pdPASS );
+				( void ) xResult;
+			}
+			vTaskPrioritySet( NULL, tskIDLE_PRIORITY );
+			ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+			vTaskPrioritySet( NULL, uxPriority );
+			ullCycles += ulCycleCounterGet() - ulStart;
+			ulEvents += ulGates;
+		}
+
+		/* The drain task throws away the task B lines before the sink
+		 * is back, and sends the result before the next measure. */
+		vTaskDelay( benchREPORT_LINE_TICKS );
+		vLogSetSink( NULL );
+
+		snprintf( cLine, sizeof( cLine ), pcTextForTestBench_BenchmarkGates,
+				  ( unsigned long ) ulGates, ( unsigned long ) ulEvents,
+				  ( unsigned long )( ullCycles / ulEvents ),
+				  ( unsigned long )( ( ( uint64_t ) ulEvents * SystemCoreClock ) / ( ullCycles ? ullCycles : 1 ) ) );
+		vPrintString( cLine );
+		vTaskDelay( benchREPORT_LINE_TICKS );
+
+		/* Records beyond the Task Monitor queue are dropped by Task B. */
+		vTask_MonitorCounts( &ulWakesEnd, &ulRecordsEnd, &ullMonitorCyclesEnd );
+		ulRecords = ulRecordsEnd - ulRecords;
+		snprintf( cLine, sizeof( cLine ), pcTextForTestBench_BenchmarkMonitor,
+				  ( unsigned long )( ulWakesEnd - ulWakes ), ( unsigned long ) ulRecords,
+				  ( unsigned long )( ( ullMonitorCyclesEnd - ullMonitorCycles ) / ( ulRecords ? ulRecords : 1 ) ) );
+		vPrintString( cLine );
+		vTaskDelay( benchREPORT_LINE_TICKS );
+
+		if( ulGates == EXIT_GATE_QUANTITY )
+		{
+			break;
+		}
+		ulGates = ( ( ulGates * 2 ) < EXIT_GATE_QUANTITY ) ? ( ulGates * 2 ) : EXIT_GATE_QUANTITY;
+	}
+
+	vPrintString( pcTextForTestBench_BenchmarkDone );
+}
+#endif
+
+#if( TEST_BENCHMARK == 2 )
+/*------------------------------------------------------------------*/
+/* Gate task: admit and release a vehicle TEST_BENCHMARK_OPS times. The
+ * gate tasks share a priority, so the tick preempts them anywhere, also
+ * inside the mutex. A full lot yields to the gate tasks that hold it. */
+static void prvTestBenchGate( void *pvParameters )
+{
+	uint32_t ulOp, ulCount, ulFull = 0, ulWaits = 0;
+
+	( void ) pvParameters;
+
+	for( ulOp = 0; ulOp < TEST_BENCHMARK_OPS; ulOp++ )
+	{
+		if( xTestBenchUseMutex == pdFALSE )
+		{
+			while( xOccupancyCounterAdmit( &xTestBenchCounter, &ulCount ) == pdFALSE )
+			{
+				ulFull++;
+				taskYIELD();
+			}
+			ulOccupancyCounterRelease( &xTestBenchCounter );
+		}
+		else
+		{
+			/* The Task A & B code before the lock-free counter */
+			for( ;; )
+			{
+				if( xSemaphoreTake( xTestBenchMutex, 0 ) != pdPASS )
+				{
+					ulWaits++;
+					xSemaphoreTake( xTestBenchMutex, portMAX_DELAY );
+				}
+				if( ulTestBenchMutexCount < lTasksCntMAX )
+				{
+					ulTestBenchMutexCount++;
+					xSemaphoreGive( xTestBenchMutex );
+					break;
+				}
+				xSemaphoreGive( xTestBenchMutex );
+				ulFull++;
+				taskYIELD();
+			}
+
+			if( xSemaphoreTake( xTestBenchMutex, 0 ) != pdPASS )
+			{
+				ulWaits++;
+				xSemaphoreTake( xTestBenchMutex, portMAX_DELAY );
+			}
+			ulTestBenchMutexCount--;
+			xSemaphoreGive( xTestBenchMutex );
+		}
+	}
+
+	taskENTER_CRITICAL();
+	{
+		ulTestBenchFull += ulFull;
+		ulTestBenchWaits += ulWaits;
+	}
+	taskEXIT_CRITICAL();
+
+	vTestBenchDone();
+	vTaskDelete( NULL );
+}
+
+/*------------------------------------------------------------------*/
+/* For each entry of ulTestBenchGateTasks, run the gate tasks with the
+ * lock-free counter and then with the xTestBenchMutex one, lot capacity
+ * lTasksCntMAX. A run ends when the last gate task is done. */
+static void prvTestBenchContention( void )
+{
+	char cLine[ 96 ];
+	char cName[ configMAX_TASK_NAME_LEN ];
+	uint32_t ulRun, ulTasks, ulTask, ulStart, ulCycles, ulWaits;
+	UBaseType_t uxTasks = uxTaskGetNumberOfTasks();
+	BaseType_t xResult = pdPASS;
+
+	vCycleCounterInit();
+
+	/* The lock of the Task A & B code before the lock-free counter. */
+	xTestBenchMutex = xSemaphoreCreateMutex();
+	configASSERT( xTestBenchMutex != NULL );
+	vQueueAddToRegistry( xTestBenchMutex, "xTestBenchMutex" );
+
+	vPrintStringAndNumber( pcTextForTestBench_Counter, TEST_BENCHMARK_OPS );
+	vPrintStringAndNumber( pcTextForTestBench_CounterClock, SystemCoreClock );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	for( ulRun = 0; ( ulRun < 2 * ( sizeof( ulTestBenchGateTasks ) / sizeof( uint32_t ) ) ) && ( xResult == pdPASS ); ulRun++ )
+	{
+		ulTasks = ulTestBenchGateTasks[ ulRun / 2 ];
+		xTestBenchUseMutex = ( ( ulRun % 2 ) == 0 ) ? pdFALSE : pdTRUE;
+
+		/* The idle task frees the gate tasks of the last run. */
+		while( uxTaskGetNumberOfTasks() > uxTasks )
+		{
+			vTaskDelay( 1 );
+		}
+
+		vOccupancyCounterInit( &xTestBenchCounter, lTasksCntMAX );
+		ulTestBenchMutexCount = 0;
+		ulTestBenchFull = 0;
+		ulTestBenchWaits = 0;
+		ulTestBenchDone = 0;
+
+		/* The gate tasks have a lower priority: they start once this task
+		 * blocks, so a failed create can still shorten the run. */
+		for( ulTask = 0; ulTask < ulTasks; ulTask++ )
+		{
+			snprintf( cName, sizeof( cName ), "Gate %lu", ( unsigned long )( ulTask + 1 ) );
+			xResult = xTaskCreate( prvTestBenchGate, cName, configMINIMAL_STACK_SIZE, NULL,
+								   ( tskIDLE_PRIORITY + 2UL ), NULL );
+			if( xResult != pdPASS )
+			{
+				break;
+			}
+		}
+		ulTestBenchTarget = ulTask;
+
+		ulStart = ulCycleCounterGet();
+		if( ulTask > 0 )
+		{
+			ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		}
+		ulCycles = ulCycleCounterGet() - ulStart;
+
+		ulWaits = ( xTestBenchUseMutex == pdTRUE ) ? ulTestBenchWaits : ulOccupancyCounterRetries( &xTestBenchCounter );
+
+		if( xResult == pdPASS )
+		{
+			snprintf( cLine, sizeof( cLine ), pcTextForTestBench_CounterRun, ( unsigned long ) ulTasks,
+					  ( xTestBenchUseMutex == pdTRUE ) ? "mutex" : "atomic",
+					  ( unsigned long )( ulCycles / ( ulTasks * TEST_BENCHMARK_OPS ) ),
+					  ( unsigned long ) ulTestBenchFull, ( unsigned long ) ulWaits );
+		}
+		else
+		{
+			snprintf( cLine, sizeof( cLine ), pcTextForTestBench_CounterHeap,
+					  ( unsigned long ) ulTasks, ( unsigned long ) ulTask );
+		}
+		vPrintString( cLine );
+		vTaskDelay( benchREPORT_LINE_TICKS );
+	}
+
+	vPrintString( pcTextForTestBench_CounterDone );
+}
+#endif
+
+#if( TEST_BENCHMARK == 3 )
+/*------------------------------------------------------------------*/
+/* Send TEST_BENCHMARK_RECORDS records to Task Journal, as fast as the
+ * pool and xQueueVehicleDateTime take them, and wait until they are
+ * all in the flash (the last page after JOURNAL_FLUSH_MS). The cycles
+ * are the ones Task Journal spent: CRC, page buffer and flash busy
+ * waits, erases included. */
+static void prvTestBenchJournal( void )
+{
+	char cLine[ 96 ];
+	MonitorQueueStruct *vehicle_test;
+	JournalStatus_t xStart, xEnd;
+	uint32_t ulRecord, ulRecords, ulRecordsEnd;
+	uint64_t ullCycles, ullCyclesEnd;
+
+	vCycleCounterInit();
+
+	vPrintStringAndNumber( pcTextForTestBench_Journal, TEST_BENCHMARK_RECORDS );
+	vPrintStringAndNumber( pcTextForTestBench_JournalClock, SystemCoreClock );
+	snprintf( cLine, sizeof( cLine ), pcTextForTestBench_JournalPage, ( unsigned long ) JOURNAL_PAGE_SIZE,
+			  ( unsigned long )( JOURNAL_SLOTS - 1 ), ( unsigned long ) flashREGION_SECTORS );
+	vPrintString( cLine );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	/* Task Journal has recovered the journal once it blocks on the queue. */
+	vJournalGetStatus( &xStart );
+	vTask_JournalCounts( &ulRecords, &ullCycles );
+
+	for( ulRecord = 0; ulRecord < TEST_BENCHMARK_RECORDS; ulRecord++ )
+	{
+		while( ( vehicle_test = pxVehiclePoolAlloc() ) == NULL )
+		{
+			vTaskDelay( 1 );
+		}
+
+		vTimeStampGet( &vehicle_test->xTimeStamp );
+		vehicle_test->dwellTime = ulRecord;
+		vehicle_test->exitGate = ( uint8_t )( ulRecord % EXIT_GATE_QUANTITY );
+		vehicle_test->parkingLot = 0;
+		vOccupancyUnpackPlate( prvTestBenchNewPlate(), vehicle_test->numVehicle );
+
+		xQueueSend( xQueueVehicleDateTime, &vehicle_test, portMAX_DELAY );
+	}
+
+	/* All taken, and the last page written or given up on. */
+	do
+	{
+		vTaskDelay( pdMS_TO_TICKS( 10 ) );
+		vJournalGetStatus( &xEnd );
+	}
+	while( ( ( ( xEnd.ulNextSequence - xStart.ulNextSequence ) + ( xEnd.ulDropped - xStart.ulDropped ) ) < TEST_BENCHMARK_RECORDS ) ||
+		   ( ( xEnd.ulPending != 0 ) && ( xEnd.ulErrors == xStart.ulErrors ) ) );
+
+	vTask_JournalCounts( &ulRecordsEnd, &ullCyclesEnd );
+	ulRecords = ulRecordsEnd - ulRecords;
+	ullCycles = ullCyclesEnd - ullCycles;
+
+	snprintf( cLine, sizeof( cLine ), pcTextForTestBench_JournalRun,
+			  ( unsigned long )( xEnd.ulWritten - xStart.ulWritten ), ( unsigned long )( xEnd.ulPages - xStart.ulPages ),
+			  ( unsigned long )( xEnd.ulRotations - xStart.ulRotations ), ( unsigned long )( xEnd.ulDropped - xStart.ulDropped ),
+			  ( unsigned long )( xEnd.ulErrors - xStart.ulErrors ) );
+	vPrintString( cLine );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	snprintf( cLine, sizeof( cLine ), pcTextForTestBench_JournalCycles,
+			  ( unsigned long )( ullCycles / ( ulRecords ? ulRecords : 1 ) ),
+			  ( unsigned long )( ( ( uint64_t ) ulRecords * SystemCoreClock ) / ( ullCycles ? ullCycles : 1 ) ) );
+	vPrintString( cLine );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	vPrintString( pcTextForTestBench_JournalDone );
+}
+#endif
+
+#if( TEST_BENCHMARK == 4 )
+/*------------------------------------------------------------------*/
+/* Signal the entry, or the exit, of lots 0 .. ulLots-1 and wait until
+ * their Task A, or their Task B, have served them all. */
+static void prvTestBenchLotsRound( uint32_t ulLots, uint32_t ulRound, bool bEntry )
+{
+	UBaseType_t uxPriority = uxTaskPriorityGet( NULL );
+	BaseType_t xResult;
+	uint32_t ulLot;
+
+	ulTestBenchDone = 0;
+	ulTestBenchTarget = ulLots;
+
+	/* Plate 1 in every lot, it is out again at the end of the round. */
+	for( ulLot = 0; ulLot < ulLots; ulLot++ )
+	{
+		if( bEntry )
+		{
+			xResult = xTask_ASignalEntry( &xParkingLot[ulLot], 1 );
+		}
+		else
+		{
+			xResult = xTask_BSignalExit( &xParkingLot[ulLot], ulRound % EXIT_GATE_QUANTITY, 1 );
+		}
+		configASSERT( xResult == pdPASS );
+		( void ) xResult;
+	}
+
+	vTaskPrioritySet( NULL, tskIDLE_PRIORITY );
+	ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	vTaskPrioritySet( NULL, uxPriority );
+}
+
+/*------------------------------------------------------------------*/
+/* For 1, 2 and 3 lots, TEST_BENCHMARK_ROUNDS rounds that park a vehicle
+ * in every lot and take it out again. The lots share no semaphore or
+ * counter, so their Task A and Task B run back to back in a round and
+ * the switches to and from this task are spread over more events. */
+static void prvTestBenchLots( void )
+{
+	char cLine[ 96 ];
+	uint32_t ulRun, ulLots, ulRound, ulStart, ulEvents;
+	uint64_t ullCycles;
+
+	vCycleCounterInit();
+
+	vPrintStringAndNumber( pcTextForTestBench_Lots, TEST_BENCHMARK_ROUNDS );
+	vPrintStringAndNumber( pcTextForTestBench_LotsClock, SystemCoreClock );
+	snprintf( cLine, sizeof( cLine ), pcTextForTestBench_LotsHeap, ( unsigned long ) PARKING_LOTS,
+			  ( unsigned long ) xParkingLot[0].xHeap, ( unsigned long ) xPortGetFreeHeapSize() );
+	vPrintString( cLine );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	for( ulRun = 0; ulRun < ( sizeof( ulTestBenchLots ) / sizeof( ulTestBenchLots[0] ) ); ulRun++ )
+	{
+		ulLots = ulTestBenchLots[ulRun];
+		if( ulLots > PARKING_LOTS )
+		{
+			snprintf( cLine, sizeof( cLine ), pcTextForTestBench_LotsSkip, ( unsigned long ) ulLots );
+			vPrintString( cLine );
+			vTaskDelay( benchREPORT_LINE_TICKS );
+			continue;
+		}
+
+		ullCycles = 0;
+		ulEvents = 0;
+
+		vLogSetSink( prvTestBenchDiscard );
+		for( ulRound = 0; ulRound < TEST_BENCHMARK_ROUNDS; ulRound++ )
+		{
+			ulStart = ulCycleCounterGet();
+			prvTestBenchLotsRound( ulLots, ulRound, true );
+			prvTestBenchLotsRound( ulLots, ulRound, false );
+			ullCycles += ulCycleCounterGet() - ulStart;
+			ulEvents += 2 * ulLots;
+		}
+
+		/* The drain task throws away the task lines before the sink is
+		 * back, and sends the result before the next measure. */
+		vTaskDelay( benchREPORT_LINE_TICKS );
+		vLogSetSink( NULL );
+
+		snprintf( cLine, sizeof( cLine ), pcTextForTestBench_LotsRun,
+				  ( unsigned long ) ulLots, ( unsigned long ) ulEvents,
+				  ( unsigned long )( ullCycles / ulEvents ),
+				  ( unsigned long )( ( ( uint64_t ) ulEvents * SystemCoreClock ) / ( ullCycles ? ullCycles : 1 ) ) );
+		vPrintString( cLine );
+		vTaskDelay( benchREPORT_LINE_TICKS );
+	}
+
+	vPrintString( pcTextForTestBench_LotsDone );
+}
+#endif
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+/* Run the TEST_BENCHMARK benchmark, called by Task Test once it runs
+ * above Task A and Task B */
+void vTestBenchRun( void )
+{
+#if( TEST_BENCHMARK == 1 )
+	prvTestBenchGates();
+#elif( TEST_BENCHMARK == 2 )
+	prvTestBenchContention();
+#elif( TEST_BENCHMARK == 3 )
+	prvTestBenchJournal();
+#elif( TEST_BENCHMARK == 4 )
+	prvTestBenchLots();
+#endif
+}
+
+#if( TEST_BENCHMARK != 0 )
+/*------------------------------------------------------------------*/
+/* Called by Task A or Task B once an entry or exit is done (or by a
+ * gate task once it is done), wakes up the benchmark when the whole
+ * round has been served */
+void vTestBenchDone( void )
+{
+	bool bDone;
+
+	/* Task B workers and lots may run one after the other on the same round. */
+	taskENTER_CRITICAL();
+	{
+		bDone = ( ++ulTestBenchDone == ulTestBenchTarget );
+	}
+	taskEXIT_CRITICAL();
+
+	if( bDone )
+	{
+		xTaskNotifyGive( vTask_TestHandle );
+	}
+}
+#endif
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
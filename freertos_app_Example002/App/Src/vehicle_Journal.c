@@ -0,0 +1,408 @@
+/* Copyright 2020, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    vehicle_Journal.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    vehicle journal file for FreeRTOS - Event Driven System (EDS) -
+    Project for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <stddef.h>
+#include <string.h>
+
+/* Application includes. */
+#include "app_Resources.h"
+#include "occupancy_Index.h"
+#include "vehicle_Journal.h"
+
+// ------ Macros and definitions ---------------------------------------
+#if( ( JOURNAL_PAGE_SIZE % JOURNAL_RECORD_SIZE ) != 0 ) || ( JOURNAL_PAGE_RECORDS < 1 )
+	#error JOURNAL_PAGE_SIZE must be a multiple of JOURNAL_RECORD_SIZE
+#endif
+
+#if( JOURNAL_PAGE_RECORDS >= JOURNAL_SLOTS )
+	#error JOURNAL_PAGE_SIZE must be smaller than a flash region sector
+#endif
+
+#define JOURNAL_RECORD_CRC_SIZE		offsetof( JournalRecord_t, ulCrc )
+#define JOURNAL_HEADER_CRC_SIZE		offsetof( JournalHeader_t, ulCrc )
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+static uint32_t prvJournalCrc( const void *pvData, size_t xLength );
+static BaseType_t prvJournalErased( const void *pvData, size_t xLength );
+static BaseType_t prvJournalHeader( uint32_t ulSector, uint32_t *pulGeneration );
+static void prvJournalScan( uint32_t ulSector, uint32_t *pulSlot, uint32_t *pulValid,
+							uint32_t *pulCorrupt, uint32_t *pulMaxSequence );
+static BaseType_t prvJournalOpen( uint32_t ulSector, uint32_t ulGeneration );
+
+// ------ internal data definition -------------------------------------
+/* CRC-32 (IEEE 802.3, reflected), four bits at a time: a 64 byte table
+ * instead of 1 KB, at twice the table lookups. */
+static const uint32_t ulJournalCrcTable[ 16 ] =
+{
+	0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+	0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+	0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+	0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+};
+
+/* Records not yet written, in order */
+static JournalRecord_t xJournalPage[ JOURNAL_PAGE_RECORDS ];
+
+static JournalStatus_t xJournal;
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+static uint32_t prvJournalCrc( const void *pvData, size_t xLength )
+{
+	const uint8_t *pucData = ( const uint8_t * ) pvData;
+	uint32_t ulCrc = 0xFFFFFFFFUL;
+
+	while( xLength-- > 0 )
+	{
+		ulCrc ^= *pucData++;
+		ulCrc = ( ulCrc >> 4 ) ^ ulJournalCrcTable[ ulCrc & 0x0FUL ];
+		ulCrc = ( ulCrc >> 4 ) ^ ulJournalCrcTable[ ulCrc & 0x0FUL ];
+	}
+
+	return ~ulCrc;
+}
+
+/*------------------------------------------------------------------*/
+static BaseType_t prvJournalErased( const void *pvData, size_t xLength )
+{
+	const uint32_t *pulData = ( const uint32_t * ) pvData;
+	size_t x;
+
+	for( x = 0; x < ( xLength / sizeof( uint32_t ) ); x++ )
+	{
+		if( pulData[ x ] != flashREGION_ERASED )
+		{
+			return pdFALSE;
+		}
+	}
+
+	return pdTRUE;
+}
+
+/*------------------------------------------------------------------*/
+/* pdTRUE and the generation if the sector has a valid header */
+static BaseType_t prvJournalHeader( uint32_t ulSector, uint32_t *pulGeneration )
+{
+	JournalHeader_t xHeader;
+
+	vFlashRegionRead( ulSector, 0, &xHeader, sizeof( xHeader ) );
+
+	if( ( xHeader.ulMagic != JOURNAL_MAGIC ) || ( xHeader.ulRecordSize != JOURNAL_RECORD_SIZE ) ||
+		( xHeader.ulCrc != prvJournalCrc( &xHeader, JOURNAL_HEADER_CRC_SIZE ) ) )
+	{
+		return pdFALSE;
+	}
+
+	*pulGeneration = xHeader.ulGeneration;
+
+	return pdTRUE;
+}
+
+/*------------------------------------------------------------------*/
+/* Reads the records of a sector up to the first erased slot */
+static void prvJournalScan( uint32_t ulSector, uint32_t *pulSlot, uint32_t *pulValid,
+							uint32_t *pulCorrupt, uint32_t *pulMaxSequence )
+{
+	JournalRecord_t xRecord;
+	uint32_t ulSlot;
+
+	*pulValid = 0;
+	*pulCorrupt = 0;
+
+	for( ulSlot = 1; ulSlot < JOURNAL_SLOTS; ulSlot++ )
+	{
+		vFlashRegionRead( ulSector, ulSlot * JOURNAL_RECORD_SIZE, &xRecord, sizeof( xRecord ) );
+
+		if( prvJournalErased( &xRecord, sizeof( xRecord ) ) == pdTRUE )
+		{
+			break;
+		}
+
+		/* A torn record keeps its slot: flash can not write it again. */
+		if( xRecord.ulCrc == prvJournalCrc( &xRecord, JOURNAL_RECORD_CRC_SIZE ) )
+		{
+			( *pulValid )++;
+			if( xRecord.ulSequence > *pulMaxSequence )
+			{
+				*pulMaxSequence = xRecord.ulSequence;
+			}
+		}
+		else
+		{
+			( *pulCorrupt )++;
+		}
+	}
+
+	*pulSlot = ulSlot;
+}
+
+/*------------------------------------------------------------------*/
+/* Erases the sector and starts it with a header of that generation */
+static BaseType_t prvJournalOpen( uint32_t ulSector, uint32_t ulGeneration )
+{
+	JournalHeader_t xHeader;
+	BaseType_t xResult = pdFAIL;
+
+	memset( &xHeader, 0xFF, sizeof( xHeader ) );
+	xHeader.ulMagic = JOURNAL_MAGIC;
+	xHeader.ulGeneration = ulGeneration;
+	xHeader.ulRecordSize = JOURNAL_RECORD_SIZE;
+	xHeader.ulCrc = prvJournalCrc( &xHeader, JOURNAL_HEADER_CRC_SIZE );
+
+	if( ( ulFlashRegionErase( ulSector ) != 0 ) &&
+		( ulFlashRegionWrite( ulSector, 0, &xHeader, sizeof( xHeader ) ) != 0 ) )
+	{
+		xResult = pdPASS;
+	}
+
+	/* On a failure the sector is left full, the next flush moves on. */
+	taskENTER_CRITICAL();
+	{
+		xJournal.ulSector = ulSector;
+		xJournal.ulGeneration = ulGeneration;
+		if( xResult == pdPASS )
+		{
+			xJournal.ulSlot = 1;
+		}
+		else
+		{
+			xJournal.ulSlot = JOURNAL_SLOTS;
+			xJournal.ulErrors++;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xResult;
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vJournalInit( void )
+{
+	uint32_t ulSector, ulGeneration, ulSlot, ulValid, ulCorrupt;
+	uint32_t ulMaxSequence = 0;
+	BaseType_t xFound = pdFALSE;
+
+	configASSERT( sizeof( JournalRecord_t ) == JOURNAL_RECORD_SIZE );
+	configASSERT( sizeof( JournalHeader_t ) == JOURNAL_RECORD_SIZE );
+
+	vFlashRegionInit();
+	memset( &xJournal, 0, sizeof( xJournal ) );
+
+	/* Active sector: the highest generation. */
+	for( ulSector = 0; ulSector < flashREGION_SECTORS; ulSector++ )
+	{
+		if( ( prvJournalHeader( ulSector, &ulGeneration ) == pdTRUE ) &&
+			( ( xFound == pdFALSE ) || ( ulGeneration > xJournal.ulGeneration ) ) )
+		{
+			xJournal.ulSector = ulSector;
+			xJournal.ulGeneration = ulGeneration;
+			xFound = pdTRUE;
+		}
+	}
+
+	if( xFound == pdFALSE )
+	{
+		/* Blank or foreign region: start over in sector 0. */
+		( void ) prvJournalOpen( 0, 1 );
+	}
+	else
+	{
+		/* The older sectors are full, they are only read for the sequence. */
+		for( ulSector = 0; ulSector < flashREGION_SECTORS; ulSector++ )
+		{
+			if( prvJournalHeader( ulSector, &ulGeneration ) == pdTRUE )
+			{
+				prvJournalScan( ulSector, &ulSlot, &ulValid, &ulCorrupt, &ulMaxSequence );
+				if( ulSector == xJournal.ulSector )
+				{
+					xJournal.ulSlot = ulSlot;
+					xJournal.ulRecovered = ulValid;
+					xJournal.ulCorrupt = ulCorrupt;
+				}
+			}
+		}
+	}
+
+	xJournal.ulNextSequence = ulMaxSequence + 1;
+}
+
+/*------------------------------------------------------------------*/
+BaseType_t xJournalAppend( const MonitorQueueStruct *pxVehicle )
+{
+	JournalRecord_t *pxRecord;
+
+	/* Full only if the last flush failed: try once more, or drop. */
+	if( ( xJournal.ulPending == JOURNAL_PAGE_RECORDS ) && ( ulJournalFlush() == 0 ) )
+	{
+		taskENTER_CRITICAL();
+		{
+			xJournal.ulDropped++;
+		}
+		taskEXIT_CRITICAL();
+
+		return pdFAIL;
+	}
+
+	pxRecord = &xJournalPage[ xJournal.ulPending ];
+	memset( pxRecord, 0, sizeof( *pxRecord ) );
+	pxRecord->xTimeStamp = pxVehicle->xTimeStamp;
+	pxRecord->ulDwell = pxVehicle->dwellTime;
+	pxRecord->ulPlate = ulOccupancyPackPlate( pxVehicle->numVehicle );
+	pxRecord->ucGate = pxVehicle->exitGate;
+	pxRecord->ucLot = pxVehicle->parkingLot;
+
+	taskENTER_CRITICAL();
+	{
+		pxRecord->ulSequence = xJournal.ulNextSequence++;
+		xJournal.ulPending++;
+	}
+	taskEXIT_CRITICAL();
+
+	pxRecord->ulCrc = prvJournalCrc( pxRecord, JOURNAL_RECORD_CRC_SIZE );
+
+	if( xJournal.ulPending == JOURNAL_PAGE_RECORDS )
+	{
+		( void ) ulJournalFlush();
+	}
+
+	return pdPASS;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulJournalFlush( void )
+{
+	uint32_t ulCount, ulWritten = 0;
+	BaseType_t xOk;
+
+	while( xJournal.ulPending > 0 )
+	{
+		if( xJournal.ulSlot >= JOURNAL_SLOTS )
+		{
+			taskENTER_CRITICAL();
+			{
+				xJournal.ulRotations++;
+			}
+			taskEXIT_CRITICAL();
+
+			if( prvJournalOpen( ( xJournal.ulSector + 1UL ) % flashREGION_SECTORS, xJournal.ulGeneration + 1UL ) != pdPASS )
+			{
+				break;
+			}
+		}
+
+		/* The page, or what is left of the sector. */
+		ulCount = JOURNAL_SLOTS - xJournal.ulSlot;
+		if( ulCount > xJournal.ulPending )
+		{
+			ulCount = xJournal.ulPending;
+		}
+
+		xOk = ( ulFlashRegionWrite( xJournal.ulSector, xJournal.ulSlot * JOURNAL_RECORD_SIZE,
+									xJournalPage, ulCount * JOURNAL_RECORD_SIZE ) != 0 ) ? pdTRUE : pdFALSE;
+
+		/* The slots are used even if the write failed half way. */
+		taskENTER_CRITICAL();
+		{
+			xJournal.ulSlot += ulCount;
+			if( xOk == pdTRUE )
+			{
+				xJournal.ulPending -= ulCount;
+				xJournal.ulWritten += ulCount;
+				xJournal.ulPages++;
+			}
+			else
+			{
+				xJournal.ulErrors++;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xOk != pdTRUE )
+		{
+			break;
+		}
+
+		memmove( &xJournalPage[ 0 ], &xJournalPage[ ulCount ], xJournal.ulPending * JOURNAL_RECORD_SIZE );
+		ulWritten += ulCount;
+	}
+
+	return ulWritten;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulJournalPending( void )
+{
+	return xJournal.ulPending;
+}
+
+/*------------------------------------------------------------------*/
+void vJournalGetStatus( JournalStatus_t *pxStatus )
+{
+	taskENTER_CRITICAL();
+	{
+		*pxStatus = xJournal;
+	}
+	taskEXIT_CRITICAL();
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,153 @@
+/* Copyright 2020, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    vehicle_Pool.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    vehicle pool file for FreeRTOS - Event Driven System (EDS) - Project
+    for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <string.h>
+
+/* Application includes. */
+#include "app_Resources.h"
+#include "vehicle_Pool.h"
+
+// ------ Macros and definitions ---------------------------------------
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+
+// ------ internal data definition -------------------------------------
+static MonitorQueueStruct xVehiclePool[ VEHICLE_POOL_SIZE ];
+
+/* Stack of the free records, and which records are handed out. */
+static MonitorQueueStruct *pxVehiclePoolFreeList[ VEHICLE_POOL_SIZE ];
+static uint32_t ulVehiclePoolFreeCnt;
+static uint8_t ucVehiclePoolInUse[ VEHICLE_POOL_SIZE ];
+
+static uint32_t ulVehiclePoolAllocFailCnt;
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vVehiclePoolInit( void )
+{
+	uint32_t i;
+
+	memset( xVehiclePool, 0, sizeof( xVehiclePool ) );
+	memset( ucVehiclePoolInUse, 0, sizeof( ucVehiclePoolInUse ) );
+
+	for( i = 0; i < VEHICLE_POOL_SIZE; i++ )
+	{
+		pxVehiclePoolFreeList[ i ] = &xVehiclePool[ i ];
+	}
+	ulVehiclePoolFreeCnt = VEHICLE_POOL_SIZE;
+	ulVehiclePoolAllocFailCnt = 0;
+}
+
+/*------------------------------------------------------------------*/
+MonitorQueueStruct *pxVehiclePoolAlloc( void )
+{
+	MonitorQueueStruct *pxVehicle = NULL;
+
+	/* A few instructions only, shorter than any queue operation. */
+	taskENTER_CRITICAL();
+	{
+		if( ulVehiclePoolFreeCnt > 0 )
+		{
+			pxVehicle = pxVehiclePoolFreeList[ --ulVehiclePoolFreeCnt ];
+			ucVehiclePoolInUse[ pxVehicle - xVehiclePool ] = 1;
+		}
+		else
+		{
+			ulVehiclePoolAllocFailCnt++;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return pxVehicle;
+}
+
+/*------------------------------------------------------------------*/
+void vVehiclePoolFree( MonitorQueueStruct *pxVehicle )
+{
+	uint32_t ulIndex = ( uint32_t )( pxVehicle - xVehiclePool );
+
+	/* Only records of this pool, and only once. */
+	configASSERT( ( pxVehicle >= xVehiclePool ) && ( ulIndex < VEHICLE_POOL_SIZE ) );
+
+	taskENTER_CRITICAL();
+	{
+		configASSERT( ucVehiclePoolInUse[ ulIndex ] != 0 );
+		ucVehiclePoolInUse[ ulIndex ] = 0;
+		pxVehiclePoolFreeList[ ulVehiclePoolFreeCnt++ ] = pxVehicle;
+	}
+	taskEXIT_CRITICAL();
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulVehiclePoolFree( void )
+{
+	return ulVehiclePoolFreeCnt;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulVehiclePoolAllocFailures( void )
+{
+	return ulVehiclePoolAllocFailCnt;
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -24,6 +24,10 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "app.h"
+#include "supporting_Functions.h"
+#include "uart_Tx.h"
+#include "run_Stats.h"
+#include "rtc_Clock.h"
 
 /* USER CODE END Includes */
 
@@ -107,6 +111,18 @@ int main(void)
   MX_USART3_UART_Init();
   MX_USB_OTG_FS_PCD_Init();
   /* USER CODE BEGIN 2 */
+    /* add console DMA transmit, ... */
+  	  vUartTxInit();
+
+    /* add console drain task, ... */
+  	  vLogDrainStart();
+
+    /* add run time statistics task, ... */
+  	  vRunStatsStart();
+
+    /* add RTC calendar for the vehicle time stamps, ... */
+  	  vRtcClockInit();
+
     /* add application, ... */
   	  appInit();
 
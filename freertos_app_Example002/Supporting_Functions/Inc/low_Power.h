@@ -0,0 +1,109 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    low_Power.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Low Power (Tickless Idle) Header file.
+
+    portSUPPRESS_TICKS_AND_SLEEP() for configUSE_TICKLESS_IDLE: the
+    idle task stops SysTick and enters STOP mode, woken by the RTC
+    wakeup timer (LSE / 2 = 16384 Hz) one tick before the next task is
+    due, or earlier by any other interrupt. The time slept is read back
+    from the RTC and the fraction of a tick left over is carried to the
+    next period, so the tick count does not drift and vTaskDelayUntil()
+    periods stay exact.
+
+    Included from FreeRTOSConfig.h, so only standard types are used.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __LOW_POWER_H
+#define __LOW_POWER_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+
+// ------ macros -------------------------------------------------------
+/* Set to 1 to print wakeups per second (see vLowPowerInit()). */
+#ifndef lowPOWER_MEASURE
+	#define lowPOWER_MEASURE			0
+#endif
+
+#ifndef lowPOWER_MEASURE_MS
+	#define lowPOWER_MEASURE_MS			1000UL
+#endif
+
+/* Set to 1 to keep the debugger connected while in STOP mode. */
+#ifndef lowPOWER_DEBUG
+	#define lowPOWER_DEBUG				0
+#endif
+
+/* Shortest sleep worth the clock restart after STOP, in RTC counts. */
+#ifndef lowPOWER_MIN_COUNTS
+	#define lowPOWER_MIN_COUNTS			8UL
+#endif
+
+// ------ typedef ------------------------------------------------------
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Start the LSE for the RTC through vRtcClockInit() (it may take up to
+ * 2 s, STOP mode is used once it is running) and, with lowPOWER_MEASURE,
+ * the report task. */
+void vLowPowerInit( void );
+
+/* portSUPPRESS_TICKS_AND_SLEEP(), called by the idle task with the
+ * scheduler suspended. TickType_t is 32 bits on this port. */
+void vLowPowerSuppressTicksAndSleep( uint32_t ulExpectedIdleTime );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LOW_POWER_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,163 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    task_Signal.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Task Signal Header file.
+
+    A signal wakes the one task that takes it, like a binary or counting
+    semaphore that only one task waits on. taskSIGNAL_NOTIFY selects how:
+    - 0: each signal is a semaphore, created on the heap;
+    - 1: each signal is a count in the TaskSignal_t itself, and a give
+      sets taskSIGNAL_BIT in the notification value of the owner task
+      (xTaskNotify() eSetBits) to wake it. No queue object and no heap.
+
+    The count is the state of the signal, the notification only wakes
+    the owner, so one task can own several signals: a wake up for one
+    of them is seen as a spurious wake up by a take of another, which
+    checks its own count again. The other notification bits are left to
+    the task.
+
+    The owner is given as a pointer to the handle variable of its task,
+    so a signal can be created before xTaskCreate() fills it. Only the
+    owner may take the signal; any task may give it.
+
+    With C11 atomics the count is a compare and swap (LDREX/STREX on the
+    Cortex-M4), as in occupancy_Counter.h, otherwise it runs in a short
+    critical section.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __TASK_SIGNAL_H
+#define __TASK_SIGNAL_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include "main.h"
+#include "cmsis_os.h"
+
+#if( defined( __STDC_VERSION__ ) && ( __STDC_VERSION__ >= 201112L ) && !defined( __STDC_NO_ATOMICS__ ) )
+	#include <stdatomic.h>
+	#define taskSIGNAL_ATOMIC			1
+#else
+	#define taskSIGNAL_ATOMIC			0
+#endif
+
+// ------ macros -------------------------------------------------------
+/* Set to 1 to signal through the task notifications instead of semaphores. */
+#ifndef taskSIGNAL_NOTIFY
+	#define taskSIGNAL_NOTIFY			0
+#endif
+
+/* Notification bit set by a give. */
+#ifndef taskSIGNAL_BIT
+	#define taskSIGNAL_BIT				( 1UL << 31 )
+#endif
+
+#if( ( taskSIGNAL_NOTIFY == 1 ) && ( configUSE_TASK_NOTIFICATIONS == 0 ) )
+	#error taskSIGNAL_NOTIFY needs configUSE_TASK_NOTIFICATIONS
+#endif
+
+// ------ typedef ------------------------------------------------------
+typedef struct
+{
+#if( taskSIGNAL_NOTIFY == 1 )
+	TaskHandle_t			*pxOwner;
+#if( taskSIGNAL_ATOMIC == 1 )
+	_Atomic UBaseType_t		uxCount;
+#else
+	volatile UBaseType_t	uxCount;
+#endif
+	UBaseType_t				uxMaxCount;
+#else
+	SemaphoreHandle_t		xSemaphore;
+#endif
+} TaskSignal_t;
+
+/* Signals one task waits on together, see xTaskSignalSelect(). */
+typedef struct
+{
+	TaskSignal_t			*pxSignals;
+	UBaseType_t				uxSignals;
+#if( taskSIGNAL_NOTIFY == 0 )
+	QueueSetHandle_t		xQueueSet;
+#endif
+} TaskSignalSet_t;
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Create an empty signal that holds up to uxMaxCount gives (1 for a
+ * binary semaphore), taken by the task of *pxOwner. pcName is the
+ * queue registry name of the semaphore. Asserts on a heap failure. */
+void vTaskSignalCreate( TaskSignal_t *pxSignal, UBaseType_t uxMaxCount, TaskHandle_t *pxOwner, const char *pcName );
+
+/* pdFAIL if the signal already holds uxMaxCount gives. */
+BaseType_t xTaskSignalGive( TaskSignal_t *pxSignal );
+
+/* pdFAIL if no give came within xTicksToWait. */
+BaseType_t xTaskSignalTake( TaskSignal_t *pxSignal, TickType_t xTicksToWait );
+
+/* Gives held by the signal. */
+UBaseType_t uxTaskSignalCount( TaskSignal_t *pxSignal );
+
+#if( ( taskSIGNAL_NOTIFY == 1 ) || ( configUSE_QUEUE_SETS == 1 ) )
+/* Group uxSignals signals created with the same owner, so that it can
+ * wait on all of them. With semaphores this creates a queue set. */
+void vTaskSignalSetCreate( TaskSignalSet_t *pxSet, TaskSignal_t *pxSignals, UBaseType_t uxSignals, const char *pcName );
+
+/* Take a give of any signal of the set, the lowest index first with
+ * notifications. Returns the index, or -1 if none came within
+ * xTicksToWait. */
+BaseType_t xTaskSignalSelect( TaskSignalSet_t *pxSet, TickType_t xTicksToWait );
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TASK_SIGNAL_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,147 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+/*--------------------------------------------------------------------*-
+
+    flash_Region.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    flash data region for FreeRTOS - Event Driven System (EDS) - Project
+    for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <string.h>
+
+/* Demo includes. */
+#include "flash_Region.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define flashREGION_ADDRESS( s, o )	( flashREGION_BASE + ( ( s ) * flashREGION_SECTOR_SIZE ) + ( o ) )
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+
+// ------ internal data definition -------------------------------------
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vFlashRegionInit( void )
+{
+	/* Errors left by an earlier operation would fail the next one. */
+	__HAL_FLASH_CLEAR_FLAG( FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+							FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR );
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulFlashRegionErase( uint32_t ulSector )
+{
+	FLASH_EraseInitTypeDef xErase;
+	uint32_t ulSectorError = 0;
+	HAL_StatusTypeDef xStatus;
+
+	configASSERT( ulSector < flashREGION_SECTORS );
+
+	xErase.TypeErase = FLASH_TYPEERASE_SECTORS;
+	xErase.Banks = 0;
+	xErase.Sector = flashREGION_FIRST_SECTOR + ulSector;
+	xErase.NbSectors = 1;
+	xErase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+	/* Also flushes the ART caches, so the sector reads back erased. */
+	HAL_FLASH_Unlock();
+	xStatus = HAL_FLASHEx_Erase( &xErase, &ulSectorError );
+	HAL_FLASH_Lock();
+
+	return ( xStatus == HAL_OK ) ? 1UL : 0UL;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulFlashRegionWrite( uint32_t ulSector, uint32_t ulOffset, const void *pvData, size_t xLength )
+{
+	const uint8_t *pucData = ( const uint8_t * ) pvData;
+	uint32_t ulWord, ulAddress;
+	HAL_StatusTypeDef xStatus = HAL_OK;
+
+	configASSERT( ulSector < flashREGION_SECTORS );
+	configASSERT( ( ( ulOffset | xLength ) & 3UL ) == 0 );
+	configASSERT( ( ulOffset + xLength ) <= flashREGION_SECTOR_SIZE );
+
+	ulAddress = flashREGION_ADDRESS( ulSector, ulOffset );
+
+	/* Word programming (x32 parallelism at 2.7 V to 3.6 V). */
+	HAL_FLASH_Unlock();
+	while( ( xLength > 0 ) && ( xStatus == HAL_OK ) )
+	{
+		memcpy( &ulWord, pucData, sizeof( ulWord ) );
+		xStatus = HAL_FLASH_Program( FLASH_TYPEPROGRAM_WORD, ulAddress, ulWord );
+
+		ulAddress += sizeof( ulWord );
+		pucData += sizeof( ulWord );
+		xLength -= sizeof( ulWord );
+	}
+	HAL_FLASH_Lock();
+
+	return ( xStatus == HAL_OK ) ? 1UL : 0UL;
+}
+
+/*------------------------------------------------------------------*/
+void vFlashRegionRead( uint32_t ulSector, uint32_t ulOffset, void *pvData, size_t xLength )
+{
+	configASSERT( ulSector < flashREGION_SECTORS );
+	configASSERT( ( ulOffset + xLength ) <= flashREGION_SECTOR_SIZE );
+
+	memcpy( pvData, ( const void * ) flashREGION_ADDRESS( ulSector, ulOffset ), xLength );
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,267 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example002
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+/*--------------------------------------------------------------------*-
+
+    traffic_Gen.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    Traffic generator for FreeRTOS - Event Driven System (EDS) -
+    Project for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <string.h>
+
+/* Demo includes. */
+#include "traffic_Gen.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define trafficNS_PER_SECOND		1000000000ULL
+#define trafficNS_PER_TICK			( 1000000ULL * portTICK_PERIOD_MS )
+
+/* ln( 2 ) in Q16. */
+#define trafficLN2_Q16				45426ULL
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+static uint32_t prvTrafficLog2Q16( uint32_t ulValue );
+static uint64_t prvTrafficExponential( TrafficGen_t *pxGen, uint64_t ullMeanNs );
+static uint32_t prvTrafficGate( TrafficGen_t *pxGen );
+
+// ------ internal data definition -------------------------------------
+static const char *pcTextForTraffic_Pattern[] = { "poisson", "burst", "periodic" };
+static const char *pcTextForTraffic_Gates[] = { "uniform", "round robin", "weighted" };
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+/* log2( ulValue ) in Q16, ulValue > 0: the integer part is the top bit,
+ * each squaring of the mantissa gives one more bit of the fraction. */
+static uint32_t prvTrafficLog2Q16( uint32_t ulValue )
+{
+	uint32_t ulTop = 31, ulLog, ulBit;
+	uint64_t ullMantissa;
+
+	while( ( ulValue & ( 1UL << ulTop ) ) == 0 )
+	{
+		ulTop--;
+	}
+	ulLog = ulTop << 16;
+
+	/* Mantissa in [1, 2) with 31 fraction bits. */
+	ullMantissa = ( uint64_t ) ulValue << ( 31 - ulTop );
+	for( ulBit = 1UL << 15; ulBit != 0; ulBit >>= 1 )
+	{
+		ullMantissa = ( ullMantissa * ullMantissa ) >> 31;
+		if( ullMantissa >= ( 1ULL << 32 ) )
+		{
+			ullMantissa >>= 1;
+			ulLog |= ulBit;
+		}
+	}
+
+	return ulLog;
+}
+
+/*------------------------------------------------------------------*/
+/* Exponential gap of mean ullMeanNs: -ln( U ) * mean, U in ( 0, 1 ) */
+static uint64_t prvTrafficExponential( TrafficGen_t *pxGen, uint64_t ullMeanNs )
+{
+	uint64_t ullLnQ16;
+
+	/* -ln( r / 2^32 ) = ( 32 - log2( r ) ) * ln( 2 ), at most 22.2 */
+	ullLnQ16 = ( ( ( 32ULL << 16 ) - prvTrafficLog2Q16( ulTrafficGenRandom( pxGen ) ) ) * trafficLN2_Q16 ) >> 16;
+
+	return ( ullLnQ16 * ullMeanNs ) >> 16;
+}
+
+/*------------------------------------------------------------------*/
+static uint32_t prvTrafficGate( TrafficGen_t *pxGen )
+{
+	const TrafficConfig_t *pxConfig = &pxGen->xConfig;
+	uint32_t ulGate, ulPick, ulWeight;
+
+	switch( pxConfig->ucGates )
+	{
+		case trafficGATES_ROUND_ROBIN:
+
+			ulGate = pxGen->ulNextGate;
+			pxGen->ulNextGate = ( ulGate + 1 ) % pxConfig->ulGateCount;
+			break;
+
+		case trafficGATES_WEIGHTED:
+
+			ulPick = ( uint32_t )( ( ( uint64_t ) ulTrafficGenRandom( pxGen ) * pxGen->ulWeightSum ) >> 32 );
+			for( ulGate = 0; ulGate < ( pxConfig->ulGateCount - 1 ); ulGate++ )
+			{
+				ulWeight = ( pxConfig->pucWeights != NULL ) ? pxConfig->pucWeights[ ulGate ] : ( pxConfig->ulGateCount - ulGate );
+				if( ulPick < ulWeight )
+				{
+					break;
+				}
+				ulPick -= ulWeight;
+			}
+			break;
+
+		case trafficGATES_UNIFORM:
+		default:
+
+			ulGate = ( uint32_t )( ( ( uint64_t ) ulTrafficGenRandom( pxGen ) * pxConfig->ulGateCount ) >> 32 );
+			break;
+	}
+
+	return ulGate;
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vTrafficGenInit( TrafficGen_t *pxGen, const TrafficConfig_t *pxConfig )
+{
+	uint32_t ulGate;
+
+	configASSERT( pxConfig->ulGateCount > 0 );
+	configASSERT( pxConfig->ucEntryPercent <= 100 );
+
+	memset( pxGen, 0, sizeof( *pxGen ) );
+	pxGen->xConfig = *pxConfig;
+	pxGen->ulState = ( pxConfig->ulSeed != 0 ) ? pxConfig->ulSeed : 0x9E3779B9UL;
+	if( pxGen->xConfig.ulBurst == 0 )
+	{
+		pxGen->xConfig.ulBurst = 1;
+	}
+
+	for( ulGate = 0; ulGate < pxConfig->ulGateCount; ulGate++ )
+	{
+		pxGen->ulWeightSum += ( pxConfig->pucWeights != NULL ) ? pxConfig->pucWeights[ ulGate ] : ( pxConfig->ulGateCount - ulGate );
+	}
+	configASSERT( pxGen->ulWeightSum > 0 );
+}
+
+/*------------------------------------------------------------------*/
+void vTrafficGenNext( TrafficGen_t *pxGen, TrafficEvent_t *pxEvent )
+{
+	const TrafficConfig_t *pxConfig = &pxGen->xConfig;
+	uint64_t ullMeanNs;
+
+	if( pxConfig->ulRate != 0 )
+	{
+		ullMeanNs = trafficNS_PER_SECOND / pxConfig->ulRate;
+
+		switch( pxConfig->ucPattern )
+		{
+			case trafficBURST:
+
+				/* The bursts keep the mean rate: one per ulBurst events. */
+				if( pxGen->ulBurstLeft == 0 )
+				{
+					pxGen->ullTimeNs += prvTrafficExponential( pxGen, ullMeanNs * pxConfig->ulBurst );
+					pxGen->ulBurstLeft = pxConfig->ulBurst;
+				}
+				pxGen->ulBurstLeft--;
+				break;
+
+			case trafficPERIODIC:
+
+				pxGen->ullTimeNs += ullMeanNs;
+				break;
+
+			case trafficPOISSON:
+			default:
+
+				pxGen->ullTimeNs += prvTrafficExponential( pxGen, ullMeanNs );
+				break;
+		}
+	}
+
+	pxEvent->ullTimeNs = pxGen->ullTimeNs;
+	pxEvent->ulGate = prvTrafficGate( pxGen );
+	pxEvent->ucEntry = ( ( ( ( uint64_t ) ulTrafficGenRandom( pxGen ) * 100 ) >> 32 ) < pxConfig->ucEntryPercent ) ? 1 : 0;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulTrafficGenRandom( TrafficGen_t *pxGen )
+{
+	uint32_t ulState = pxGen->ulState;
+
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	pxGen->ulState = ulState;
+
+	return ulState;
+}
+
+/*------------------------------------------------------------------*/
+void vTrafficGenWait( TickType_t xStart, const TrafficEvent_t *pxEvent )
+{
+	TickType_t xArrival = ( TickType_t )( pxEvent->ullTimeNs / trafficNS_PER_TICK );
+	TickType_t xElapsed = xTaskGetTickCount() - xStart;
+
+	if( xArrival > xElapsed )
+	{
+		vTaskDelay( xArrival - xElapsed );
+	}
+}
+
+/*------------------------------------------------------------------*/
+const char *pcTrafficGenPattern( uint32_t ulPattern )
+{
+	return ( ulPattern <= trafficPERIODIC ) ? pcTextForTraffic_Pattern[ ulPattern ] : "?";
+}
+
+/*------------------------------------------------------------------*/
+const char *pcTrafficGenGates( uint32_t ulGates )
+{
+	return ( ulGates <= trafficGATES_WEIGHTED ) ? pcTextForTraffic_Gates[ ulGates ] : "?";
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
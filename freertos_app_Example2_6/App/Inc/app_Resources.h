@@ -52,12 +52,13 @@
 // ------ inclusions ---------------------------------------------------
 
 // ------ macros -------------------------------------------------------
+#define TASKS_NUM	3
 
 // ------ typedef ------------------------------------------------------
 
 // ------ external data declaration ------------------------------------
-/* Used to hold the handle of TaskTest. */
-extern TaskHandle_t *xTasksHandle;
+/* Used to hold the handles of the Task X threads. */
+extern TaskHandle_t xTasksHandle[ TASKS_NUM ];
 
 // ------ external functions declaration -------------------------------
 
@@ -0,0 +1,89 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    led_Bench.h (Released 2022-10)
+
+  --------------------------------------------------------------------
+
+    This is the Led Benchmark Header file.
+
+    Led benchmark: the cost of writing and toggling LD1, LD2 and LD3
+    with one HAL call per led against one GPIO batch (gpio_Batch.h).
+
+    With LED_BENCHMARK 1, appInit() creates Task Bench. It measures
+    LED_BENCHMARK_OPS led groups per mode in cycles, with the cycle
+    counter (cycle_Counter.h), prints the min, median and mean of each
+    mode and deletes itself. The leds are left off.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __LED_BENCH_H
+#define __LED_BENCH_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+
+// ------ macros -------------------------------------------------------
+#ifndef LED_BENCHMARK
+	#define LED_BENCHMARK			( 0 )
+#endif
+
+#ifndef LED_BENCHMARK_OPS
+	#define LED_BENCHMARK_OPS		( 1000 )
+#endif
+
+// ------ typedef ------------------------------------------------------
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Create Task Bench at priority 2. Call it before the scheduler
+ * starts. */
+void vLedBenchStart( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LED_BENCH_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
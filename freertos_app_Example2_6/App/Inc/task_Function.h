@@ -52,6 +52,13 @@
 // ------ inclusions ---------------------------------------------------
 
 // ------ macros -------------------------------------------------------
+/* 1: the tasks block until the USER_Btn EXTI interrupt notifies them and
+ * the LEDs toggle from one software timer callback, together through a
+ * GPIO batch (gpio_Batch.h), so the CPU stays idle.
+ * 0: the original loop that polls the button and the tick count. */
+#ifndef TASK_FUNCTION_EVENT_DRIVEN
+	#define TASK_FUNCTION_EVENT_DRIVEN	1
+#endif
 
 // ------ typedef ------------------------------------------------------
 
@@ -60,6 +67,9 @@
 // ------ external functions declaration -------------------------------
 
 void vTaskFunction( void *pvParameters );
+#if( TASK_FUNCTION_EVENT_DRIVEN == 1 )
+void vTaskFunctionInit( void );
+#endif
 
 #ifdef __cplusplus
 }
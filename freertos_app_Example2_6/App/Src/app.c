@@ -59,13 +59,15 @@
 
 /* Demo includes. */
 #include "supporting_Functions.h"
+#include "led_Pwm.h"
 
 /* Application & Tasks includes. */
 #include "app.h"
+#include "app_Resources.h"
 #include "task_Function.h"
+#include "led_Bench.h"
 
 // ------ Macros and definitions ---------------------------------------
-#define TASKS_NUM	3
 
 // ------ internal data declaration ------------------------------------
 /* Declare a variable of type xTaskHandle. This is used to reference tasks. */
@@ -97,6 +99,16 @@ void appInit( void )
 	/* Print out the name of this Example. */
   	vPrintString( pcTextForMain );
 
+#if( ( TASK_FUNCTION_EVENT_DRIVEN == 1 ) && ( ledPWM_ENABLE == 1 ) )
+	/* LD1, LD2 & LD3 blinked by their timers, Task X only sets them */
+	vLedPwmInit();
+#endif
+
+#if( TASK_FUNCTION_EVENT_DRIVEN == 1 )
+	/* The led timer the Task X threads share */
+	vTaskFunctionInit();
+#endif
+
   	for (uint8_t i = 0; i < TASKS_NUM; ++i) {
   		/* Task X thread at priority 1 */
 		ret = xTaskCreate( vTaskFunction,				/* Pointer to the function thats implement the task. */
@@ -109,6 +121,18 @@ void appInit( void )
 		/* Check the task was created successfully. */
 		configASSERT( ret == pdPASS );
 	}
+
+#if( TASK_FUNCTION_EVENT_DRIVEN == 1 )
+	/* MX_GPIO_Init() already sets USER_Btn as EXTI rising edge, let the
+	 * interrupt through. Its callback calls FromISR APIs. */
+	HAL_NVIC_SetPriority( EXTI15_10_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, 0 );
+	HAL_NVIC_EnableIRQ( EXTI15_10_IRQn );
+#endif
+
+#if( LED_BENCHMARK == 1 )
+	/* Task Bench measures the led group writes once */
+	vLedBenchStart();
+#endif
 }
 
 /*------------------------------------------------------------------*-
@@ -0,0 +1,216 @@
+/* Copyright 2020, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+/*--------------------------------------------------------------------*-
+
+    led_Bench.c (Released 2022-10)
+
+--------------------------------------------------------------------
+
+    Led benchmark for FreeRTOS - Event Driven System (EDS) - Project for
+    STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Demo includes. */
+#include "supporting_Functions.h"
+#include "cycle_Counter.h"
+#include "bench_Stats.h"
+#include "gpio_Batch.h"
+
+/* Application includes. */
+#include "led_Bench.h"
+
+// ------ Macros and definitions ---------------------------------------
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+static uint32_t prvLedBenchGroup( uint32_t ulMode, uint32_t ulOp );
+static void prvLedBenchTask( void *pvParameters );
+
+// ------ internal data definition -------------------------------------
+/* Define the strings that will be passed in as the Supporting Functions parameters.
+ * These are defined const and off the stack to ensure they remain valid when the
+ * tasks are executing. */
+const char *pcTextForLedBench_Gpio					= "  <=> Task Bench - Gpio: LD1, LD2 & LD3 groups per mode :";
+const char *pcTextForLedBench_GpioClock				= "  <=> Task Bench - Gpio: core clock (Hz) :";
+const char *pcTextForLedBench_GpioRun				= "  <=> Task Bench - Gpio: %-12s cycles/group min %4lu median %4lu mean %4lu\r\n";
+const char *pcTextForLedBench_GpioDone				= "  <=> Task Bench - Gpio: done\r\n\n";
+
+/* Modes of prvLedBenchGroup(), the first one is the reading overhead */
+static const char * const pcLedBenchMode[] = { "empty", "HAL write", "batch write", "HAL toggle", "batch toggle" };
+
+static BenchStats_t xLedBenchCycles;
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+/* Write or toggle LD1, LD2 and LD3 once in the given mode, and return
+ * the cycles it took. The leds are written on in odd ops, off in even
+ * ones. No interrupt or task switch is counted in. */
+static uint32_t prvLedBenchGroup( uint32_t ulMode, uint32_t ulOp )
+{
+	GPIO_PinState xState = ( ( ulOp & 1UL ) != 0 ) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+	GpioBatch_t xBatch;
+	uint32_t ulStart, ulEnd;
+
+	taskENTER_CRITICAL();
+	switch( ulMode )
+	{
+		case 0:
+			ulStart = ulCycleCounterGet();
+			ulEnd = ulCycleCounterGet();
+			break;
+
+		case 1:
+			ulStart = ulCycleCounterGet();
+			HAL_GPIO_WritePin( LD1_GPIO_Port, LD1_Pin, xState );
+			HAL_GPIO_WritePin( LD2_GPIO_Port, LD2_Pin, xState );
+			HAL_GPIO_WritePin( LD3_GPIO_Port, LD3_Pin, xState );
+			ulEnd = ulCycleCounterGet();
+			break;
+
+		case 2:
+			ulStart = ulCycleCounterGet();
+			vGpioBatchInit( &xBatch );
+			vGpioBatchWrite( &xBatch, LD1_GPIO_Port, LD1_Pin, xState );
+			vGpioBatchWrite( &xBatch, LD2_GPIO_Port, LD2_Pin, xState );
+			vGpioBatchWrite( &xBatch, LD3_GPIO_Port, LD3_Pin, xState );
+			vGpioBatchCommit( &xBatch );
+			ulEnd = ulCycleCounterGet();
+			break;
+
+		case 3:
+			ulStart = ulCycleCounterGet();
+			HAL_GPIO_TogglePin( LD1_GPIO_Port, LD1_Pin );
+			HAL_GPIO_TogglePin( LD2_GPIO_Port, LD2_Pin );
+			HAL_GPIO_TogglePin( LD3_GPIO_Port, LD3_Pin );
+			ulEnd = ulCycleCounterGet();
+			break;
+
+		default:
+			ulStart = ulCycleCounterGet();
+			vGpioBatchInit( &xBatch );
+			vGpioBatchToggle( &xBatch, LD1_GPIO_Port, LD1_Pin );
+			vGpioBatchToggle( &xBatch, LD2_GPIO_Port, LD2_Pin );
+			vGpioBatchToggle( &xBatch, LD3_GPIO_Port, LD3_Pin );
+			vGpioBatchCommit( &xBatch );
+			ulEnd = ulCycleCounterGet();
+			break;
+	}
+	taskEXIT_CRITICAL();
+
+	return ulEnd - ulStart;
+}
+
+/*------------------------------------------------------------------*/
+/* Task Bench thread: for each mode, LED_BENCHMARK_OPS led groups. The
+ * empty mode is the cost of the two counter readings, left in the other
+ * modes. */
+static void prvLedBenchTask( void *pvParameters )
+{
+	char cLine[ 96 ];
+	uint32_t ulMode, ulOp;
+
+	( void ) pvParameters;
+
+	vCycleCounterInit();
+
+	vPrintStringAndNumber( pcTextForLedBench_Gpio, LED_BENCHMARK_OPS );
+	vPrintStringAndNumber( pcTextForLedBench_GpioClock, SystemCoreClock );
+	vTaskDelay( benchREPORT_LINE_TICKS );
+
+	for( ulMode = 0; ulMode < ( sizeof( pcLedBenchMode ) / sizeof( pcLedBenchMode[ 0 ] ) ); ulMode++ )
+	{
+		vBenchStatsReset( &xLedBenchCycles );
+		for( ulOp = 0; ulOp < LED_BENCHMARK_OPS; ulOp++ )
+		{
+			vBenchStatsAdd( &xLedBenchCycles, prvLedBenchGroup( ulMode, ulOp ) );
+		}
+
+		snprintf( cLine, sizeof( cLine ), pcTextForLedBench_GpioRun, pcLedBenchMode[ ulMode ],
+				  ( unsigned long ) xLedBenchCycles.ulMin,
+				  ( unsigned long ) ulBenchStatsPercentile( &xLedBenchCycles, 500 ),
+				  ( unsigned long )( xLedBenchCycles.ullSum / xLedBenchCycles.ulCount ) );
+		vPrintString( cLine );
+		vTaskDelay( benchREPORT_LINE_TICKS );
+	}
+
+	/* Leave the leds off */
+	HAL_GPIO_WritePin( LD1_GPIO_Port, LD1_Pin, GPIO_PIN_RESET );
+	HAL_GPIO_WritePin( LD2_GPIO_Port, LD2_Pin, GPIO_PIN_RESET );
+	HAL_GPIO_WritePin( LD3_GPIO_Port, LD3_Pin, GPIO_PIN_RESET );
+
+	vPrintString( pcTextForLedBench_GpioDone );
+	vTaskDelete( NULL );
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+/* Create Task Bench */
+void vLedBenchStart( void )
+{
+	BaseType_t ret;
+
+	/* Task Bench thread at priority 2 */
+	ret = xTaskCreate( prvLedBenchTask,				/* Pointer to the function thats implement the task. */
+					   "Task Bench",				/* Text name for the task. This is to facilitate debugging only. */
+					   (2 * configMINIMAL_STACK_SIZE),	/* Stack depth in words. 				*/
+					   NULL,						/* We are not using the task parameter.		*/
+					   (tskIDLE_PRIORITY + 2UL),	/* This task will run at priority 2. 		*/
+					   NULL );						/* We are not using the task handle.		*/
+
+	/* Check the task was created successfully. */
+	configASSERT( ret == pdPASS );
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -59,6 +59,8 @@
 
 /* Demo includes. */
 #include "supporting_Functions.h"
+#include "led_Pwm.h"
+#include "gpio_Batch.h"
 
 /* Application includes. */
 #include "app_Resources.h"
@@ -69,6 +71,9 @@
 // ------ internal data declaration ------------------------------------
 
 // ------ internal functions declaration -------------------------------
+#if( ( TASK_FUNCTION_EVENT_DRIVEN == 1 ) && ( ledPWM_ENABLE == 0 ) )
+static void prvLedTimerCallback( TimerHandle_t xTimer );
+#endif
 
 // ------ internal data definition -------------------------------------
 /* Define the strings that will be passed in as the Supporting Functions parameters.
@@ -84,19 +89,182 @@ const char *pcTextForTask_BlinkingOff	= " - Blinking turn Off\r\n";
 
 #define 		buttonTickCntMAX	500
 #define			ledTickCntMAX		500
+#define			ledOnUs				( ledTickCntMAX * portTICK_PERIOD_MS * 1000UL )
 typedef enum	ledFlag_e{ Blinking, NotBlinking } ledFlag_t;
 
 uint16_t	  LDX_Pin[]			= { LD1_Pin,       LD2_Pin,       LD3_Pin };
 GPIO_TypeDef* LDX_GPIO_Port[]	= { LD1_GPIO_Port, LD2_GPIO_Port, LD3_GPIO_Port };
 
+#if( TASK_FUNCTION_EVENT_DRIVEN == 1 )
+/* Notification bit set by the USER_Btn interrupt. */
+#define			buttonEVENT			( 1UL << 0 )
+
+/* LED state of each task, changed by the timer callback only. */
+GPIO_PinState LDX_State[ TASKS_NUM ];
+#endif
+
+#if( ( TASK_FUNCTION_EVENT_DRIVEN == 1 ) && ( ledPWM_ENABLE == 0 ) )
+/* One bit per blinking task, and the auto reload timer that toggles all
+ * of their leds together. */
+static volatile uint32_t ulLedBlinking = 0;
+static TimerHandle_t xLedTimer;
+#endif
+
 // ------ external data definition -------------------------------------
 
 // ------ internal functions definition --------------------------------
+#if( ( TASK_FUNCTION_EVENT_DRIVEN == 1 ) && ( ledPWM_ENABLE == 0 ) )
+
+/*------------------------------------------------------------------*/
+/* Led timer callback, runs in the timer service task every ledTickCntMAX
+ * and toggles the led of every blinking task */
+static void prvLedTimerCallback( TimerHandle_t xTimer )
+{
+	uint32_t ulBlinking = ulLedBlinking;
+	GpioBatch_t xBatch;
+	char *pcTaskName;
+	uint32_t index;
+
+	/* The last task stopped blinking, the next one to start restarts it */
+	if( ulBlinking == 0 )
+	{
+		( void ) xTimerStop( xTimer, 0 );
+		return;
+	}
+
+	vGpioBatchInit( &xBatch );
+	for( index = 0; index < TASKS_NUM; index++ )
+	{
+		if( ( ulBlinking & ( 1UL << index ) ) == 0 )
+		{
+			continue;
+		}
+		pcTaskName = ( char * ) pcTaskGetName( xTasksHandle[ index ] );
+
+		/* Check, Update and Print Led State */
+		if( LDX_State[ index ] == GPIO_PIN_RESET )
+		{
+			LDX_State[ index ] = GPIO_PIN_SET;
+			vPrintTwoStrings( pcTaskName, pcTextForTask_LDXTOn );
+		}
+		else
+		{
+			LDX_State[ index ] = GPIO_PIN_RESET;
+			vPrintTwoStrings( pcTaskName, pcTextForTask_LDXTOff );
+		}
+		vGpioBatchWrite( &xBatch, LDX_GPIO_Port[ index ], LDX_Pin[ index ], LDX_State[ index ] );
+	}
+
+	/* Update HW Led State, the leds of a port with one store */
+	vGpioBatchCommit( &xBatch );
+}
+
+#endif
 
 // ------ external functions definition --------------------------------
 
+#if( TASK_FUNCTION_EVENT_DRIVEN == 1 )
+/*------------------------------------------------------------------*/
+/* Led timer shared by the Task X threads, before they run */
+void vTaskFunctionInit( void )
+{
+#if( ledPWM_ENABLE == 0 )
+	xLedTimer = xTimerCreate( "Led", ledTickCntMAX, pdTRUE, NULL, prvLedTimerCallback );
+	configASSERT( xLedTimer != NULL );
+#endif
+}
+#endif
+
 /*------------------------------------------------------------------*/
 /* Task Function thread */
+#if( TASK_FUNCTION_EVENT_DRIVEN == 1 )
+void vTaskFunction( void *pvParameters )
+{
+	/*  Declare & Initialize Task Function variables for argument, led, button and task */
+	uint32_t index = *(uint32_t *)pvParameters;
+
+	ledFlag_t ledFlag = NotBlinking;
+#if( ledPWM_ENABLE == 0 )
+	uint32_t ulWasBlinking;
+#endif
+	uint32_t ulEvents;
+
+	TickType_t buttonTickCnt = xTaskGetTickCount();
+
+	char *pcTaskName = (char *) pcTaskGetName( NULL );
+
+	/* Print out the name of this task. */
+	vPrintTwoStrings( pcTaskName, pcTextForTask_IsRunning );
+
+	/* As per most tasks, this task is implemented in an infinite loop. */
+	for( ;; )
+	{
+		/* Block until the button interrupt notifies this task. */
+		xTaskNotifyWait( 0, UINT32_MAX, &ulEvents, portMAX_DELAY );
+
+		/* Ignore presses (and contact bounce) closer than buttonTickCntMAX */
+		if( ( ( ulEvents & buttonEVENT ) != 0 ) &&
+			( ( xTaskGetTickCount() - buttonTickCnt ) >= buttonTickCntMAX ) )
+		{
+			/* Check, Update and Print Led Flag, start or stop blinking */
+			if( ledFlag == NotBlinking )
+			{
+				ledFlag = Blinking;
+				vPrintTwoStrings( pcTaskName, pcTextForTask_BlinkingOn );
+#if( ledPWM_ENABLE == 1 )
+				/* The led timer toggles it every ledTickCntMAX */
+				vLedPwmSet( LDX_GPIO_Port[ index ], LDX_Pin[ index ], 2UL * ledOnUs, ledOnUs );
+#else
+				/* Join the led timer, start it if no led is blinking */
+				taskENTER_CRITICAL();
+				ulWasBlinking = ulLedBlinking;
+				ulLedBlinking = ulWasBlinking | ( 1UL << index );
+				taskEXIT_CRITICAL();
+				if( ulWasBlinking == 0 )
+				{
+					configASSERT( xTimerStart( xLedTimer, portMAX_DELAY ) == pdPASS );
+				}
+#endif
+			}
+			else
+			{
+				ledFlag = NotBlinking;
+				vPrintTwoStrings( pcTaskName, pcTextForTask_BlinkingOff );
+#if( ledPWM_ENABLE == 1 )
+				vLedPwmSet( LDX_GPIO_Port[ index ], LDX_Pin[ index ], 2UL * ledOnUs, 0UL );
+#else
+				/* Leave the led timer, it stops itself once none is left */
+				taskENTER_CRITICAL();
+				ulLedBlinking &= ~( 1UL << index );
+				taskEXIT_CRITICAL();
+#endif
+			}
+			/* Update and Button Tick Counter */
+			buttonTickCnt = xTaskGetTickCount();
+		}
+	}
+}
+
+/*------------------------------------------------------------------*/
+/* USER_Btn EXTI callback, from EXTI15_10_IRQHandler() */
+void HAL_GPIO_EXTI_Callback( uint16_t GPIO_Pin )
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if( GPIO_Pin != USER_Btn_Pin )
+	{
+		return;
+	}
+
+	/* Post the press to every Task X thread. */
+	for( uint32_t i = 0; i < TASKS_NUM; i++ )
+	{
+		xTaskNotifyFromISR( xTasksHandle[ i ], buttonEVENT, eSetBits, &xHigherPriorityTaskWoken );
+	}
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+
+#else
 void vTaskFunction( void *pvParameters )
 {
 	/*  Declare & Initialize Task Function variables for argument, led, button and task */
@@ -165,6 +333,8 @@ void vTaskFunction( void *pvParameters )
 	}
 }
 
+#endif
+
 /*------------------------------------------------------------------*-
   ---- END OF FILE -------------------------------------------------
 -*------------------------------------------------------------------*/
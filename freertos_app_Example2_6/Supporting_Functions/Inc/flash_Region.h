@@ -0,0 +1,116 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    flash_Region.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Flash Region Header file.
+
+    flashREGION_SECTORS sectors of the internal flash kept for data,
+    from sector flashREGION_FIRST_SECTOR on. The default is sectors 12
+    to 15 (16 KB each) at the start of bank 2: the code runs from
+    bank 1 and is not stalled while bank 2 is erased or programmed.
+    The STM32F429ZITX_FLASH.ld of every project ends the code at 1024K,
+    so the region is free in all of them.
+
+    Sectors are numbered 0 .. flashREGION_SECTORS - 1 inside the region.
+    Flash only clears bits: a sector must be erased (all bits set) before
+    it is written again. Erase and write busy wait on the flash, call
+    them from a low priority task. The host simulation stands in a file
+    for the region.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __FLASH_REGION_H
+#define __FLASH_REGION_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+#include <stddef.h>
+
+// ------ macros -------------------------------------------------------
+/* First sector of the region and its address. */
+#ifndef flashREGION_FIRST_SECTOR
+	#define flashREGION_FIRST_SECTOR	12
+#endif
+
+#ifndef flashREGION_BASE
+	#define flashREGION_BASE			0x08100000UL
+#endif
+
+#ifndef flashREGION_SECTORS
+	#define flashREGION_SECTORS			4
+#endif
+
+/* All the sectors of the region must have this size. */
+#ifndef flashREGION_SECTOR_SIZE
+	#define flashREGION_SECTOR_SIZE		( 16UL * 1024UL )
+#endif
+
+/* Value of an erased word. */
+#define flashREGION_ERASED				0xFFFFFFFFUL
+
+// ------ typedef ------------------------------------------------------
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+void vFlashRegionInit( void );
+
+/* Erase a sector, 1 when done or 0 on a flash error. */
+uint32_t ulFlashRegionErase( uint32_t ulSector );
+
+/* Program xLength bytes at ulOffset of a sector, both multiples of 4.
+ * 1 when done or 0 on a flash error. */
+uint32_t ulFlashRegionWrite( uint32_t ulSector, uint32_t ulOffset, const void *pvData, size_t xLength );
+
+void vFlashRegionRead( uint32_t ulSector, uint32_t ulOffset, void *pvData, size_t xLength );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FLASH_REGION_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
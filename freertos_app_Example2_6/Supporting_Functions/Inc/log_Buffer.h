@@ -0,0 +1,108 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    log_Buffer.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Log Ring Buffer Header file.
+
+    Multi-producer / single-consumer ring of fixed size slots. Tasks
+    write complete lines in O(1) without blocking and without masking
+    interrupts; a low priority drain task empties it to the console.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __LOG_BUFFER_H
+#define __LOG_BUFFER_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+#include <stddef.h>
+
+// ------ macros -------------------------------------------------------
+/* Number of slots, must be a power of two. */
+#ifndef logBUFFER_SLOT_COUNT
+	#define logBUFFER_SLOT_COUNT	32
+#endif
+
+/* Payload bytes per slot, longer lines are truncated. */
+#ifndef logBUFFER_SLOT_SIZE
+	#define logBUFFER_SLOT_SIZE		96
+#endif
+
+#if( ( logBUFFER_SLOT_COUNT & ( logBUFFER_SLOT_COUNT - 1 ) ) != 0 )
+	#error logBUFFER_SLOT_COUNT must be a power of two
+#endif
+
+// ------ typedef ------------------------------------------------------
+typedef struct
+{
+	uint32_t ulWritten;		/* Lines accepted by the ring. */
+	uint32_t ulDropped;		/* Lines rejected because the ring was full. */
+	uint32_t ulTruncated;	/* Lines cut to logBUFFER_SLOT_SIZE. */
+	uint32_t ulHighWater;	/* Maximum number of slots ever in use. */
+	uint32_t ulCapacity;	/* logBUFFER_SLOT_COUNT. */
+} LogBufferStats_t;
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Producers (any task, several at once). Return 1 if the line was
+ * queued, 0 if it was dropped. */
+uint32_t ulLogBufferWrite( const char *pcData, size_t xLength );
+uint32_t ulLogBufferPrintf( const char *pcFormat, ... ) __attribute__(( format( printf, 1, 2 ) ));
+
+/* Consumer (one task only). Copy the oldest line into pcBuffer and return
+ * its length, or 0 if the ring is empty. */
+size_t xLogBufferRead( char *pcBuffer, size_t xBufferLength );
+
+void vLogBufferGetStats( LogBufferStats_t *pxStats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LOG_BUFFER_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,124 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    log_Token.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Tokenized Log Header file.
+
+    Encodes vPrint* calls as short binary records that carry the index
+    of each constant string (its token) instead of the text. The index
+    is the offset of the string in .rodata, so Tools/log_token.py builds
+    the table from the .elf and turns a capture back into the original
+    console text.
+
+    Writers queue a record of fixed layout with the absolute tick; the
+    drain task packs it on its way to the UART, so the tick goes out as
+    the delta to the record sent before it, in stream order.
+
+    Record (little endian, 6 bytes for most strings):
+      0xA5 | type | token (2) | tick delta (varint) | argument | xor of bytes 1..n-2
+
+    Argument: none for 'S', the number as a varint for 'N', the token of
+    the second string (2) for 'W'. A varint holds 7 bits per byte, low
+    bits first, the top bit set on every byte but the last.
+
+    Text record, for strings that are not in .rodata:
+      0xA5 | 'T' | length (1) | text (length) | xor of bytes 1..length+2
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __LOG_TOKEN_H
+#define __LOG_TOKEN_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+#include <stddef.h>
+
+// ------ macros -------------------------------------------------------
+#define logTOKEN_SYNC				0xA5
+
+/* Record types; the argument holds: */
+#define logTOKEN_STRING				'S'		/* nothing                    -> "%s"               */
+#define logTOKEN_STRING_NUMBER		'N'		/* the number                 -> "%s %lu\r\n"       */
+#define logTOKEN_TWO_STRINGS		'W'		/* token of the second string -> "At time %lu: %s %s\r\n" */
+#define logTOKEN_TEXT				'T'
+
+/* Queued record: type | token (2) | tick (4) | argument (4). */
+#define logTOKEN_QUEUED_SIZE		11
+/* Largest packed record: both varints 5 bytes long. */
+#define logTOKEN_RECORD_SIZE		15
+#define logTOKEN_TEXT_OVERHEAD		4
+
+// ------ typedef ------------------------------------------------------
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Encode one vPrint* call into pucBuffer for the log ring and return its
+ * length. When a string is not in .rodata the call is formatted as text
+ * and queued as a text record of at most xBufferLength bytes. */
+size_t xLogTokenEncode( uint8_t *pucBuffer, size_t xBufferLength, uint8_t ucType,
+						const char *pcString1, const char *pcString2,
+						uint32_t ulValue, uint32_t ulTick );
+
+/* Pack a record queued by xLogTokenEncode into pucWire and return its
+ * length, 0 if it is not a record. pulLastTick holds the tick of the
+ * record sent before; only one task may pack for a given stream. Text
+ * records are copied as they are. */
+size_t xLogTokenPack( uint8_t *pucWire, size_t xWireLength,
+					  const uint8_t *pucRecord, size_t xLength, uint32_t *pulLastTick );
+
+/* Wrap xLength bytes of text in a text record. */
+size_t xLogTokenEncodeText( uint8_t *pucBuffer, size_t xBufferLength,
+							const char *pcText, size_t xLength );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LOG_TOKEN_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
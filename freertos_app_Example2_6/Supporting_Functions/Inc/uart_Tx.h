@@ -0,0 +1,116 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    uart_Tx.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the USART3 Transmit Engine Header file.
+
+    Double-buffered DMA transmit path for the console: writers copy into
+    one half while DMA1 Stream3 sends the other, so _write() returns as
+    soon as the bytes are queued.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __UART_TX_H
+#define __UART_TX_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+#include <stddef.h>
+
+// ------ macros -------------------------------------------------------
+/* Set to 0 to send with the blocking HAL_UART_Transmit() as before. */
+#ifndef uartTX_USE_DMA
+	#define uartTX_USE_DMA			1
+#endif
+
+/* Bytes per half buffer (two halves are allocated). */
+#ifndef uartTX_HALF_SIZE
+	#define uartTX_HALF_SIZE		256
+#endif
+
+/* Writers the transfer complete callback wakes at once, any other one
+ * sleeps for uartTX_WAIT_TICKS. */
+#ifndef uartTX_WAITERS
+	#define uartTX_WAITERS			8
+#endif
+
+/* Longest a writer sleeps before checking the halves again. */
+#ifndef uartTX_WAIT_TICKS
+	#define uartTX_WAIT_TICKS		pdMS_TO_TICKS( 10 )
+#endif
+
+// ------ typedef ------------------------------------------------------
+typedef struct
+{
+	uint32_t ulBytes;		/* Bytes handed to the engine. */
+	uint32_t ulTransfers;	/* DMA transfers started. */
+	uint32_t ulBlocked;		/* Times a writer had to wait for a free half. */
+	uint32_t ulErrors;		/* UART/DMA errors reported by the HAL. */
+} UartTxStats_t;
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Link the DMA stream to huart3 and enable its interrupts. Call after
+ * MX_USART3_UART_Init(); until then writes use the blocking path. */
+void vUartTxInit( void );
+
+/* Queue xLength bytes for transmission and return the number queued. */
+size_t xUartTxWrite( const char *pcData, size_t xLength );
+
+void vUartTxGetStats( UartTxStats_t *pxStats );
+
+/* 1 when nothing is queued or on the wire, so the USART clock may stop. */
+uint32_t ulUartTxIdle( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UART_TX_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
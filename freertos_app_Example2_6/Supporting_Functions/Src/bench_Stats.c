@@ -0,0 +1,249 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+/*--------------------------------------------------------------------*-
+
+    bench_Stats.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    Benchmark statistics for FreeRTOS - Event Driven System (EDS) -
+    Project for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Demo includes. */
+#include "supporting_Functions.h"
+#include "bench_Stats.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define benchSUB_COUNT		( 1UL << benchHISTOGRAM_SUB_BITS )
+#define benchBAR_WIDTH		32UL
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+static uint32_t prvBenchBucket( uint32_t ulSample );
+static uint32_t prvBenchBucketTop( uint32_t ulBucket );
+static void prvBenchPrintLine( const char *pcLine );
+
+// ------ internal data definition -------------------------------------
+static const char *pcTextForBench_Summary	= "  %s n=%lu min=%lu p50=%lu p99=%lu max=%lu mean=%lu %s\r\n";
+static const char *pcTextForBench_Row		= "    %10lu..%-10lu %7lu %s\r\n";
+static const char *pcTextForBench_Bar		= "################################";
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+static uint32_t prvBenchBucket( uint32_t ulSample )
+{
+	uint32_t ulShift;
+
+	if( ulSample < benchSUB_COUNT )
+	{
+		return ulSample;
+	}
+
+	/* Position of the leading one, less the bits kept below it. */
+	ulShift = ( 31UL - ( uint32_t ) __builtin_clz( ulSample ) ) - benchHISTOGRAM_SUB_BITS;
+
+	return ( ( ulShift + 1UL ) << benchHISTOGRAM_SUB_BITS ) + ( ( ulSample >> ulShift ) & ( benchSUB_COUNT - 1UL ) );
+}
+
+/*------------------------------------------------------------------*/
+static uint32_t prvBenchBucketTop( uint32_t ulBucket )
+{
+	uint32_t ulShift;
+
+	if( ulBucket < benchSUB_COUNT )
+	{
+		return ulBucket;
+	}
+
+	ulShift = ( ulBucket >> benchHISTOGRAM_SUB_BITS ) - 1UL;
+
+	/* Computed in 64 bits, the top bucket ends at 2^32 - 1. */
+	return ( uint32_t )( ( ( ( uint64_t ) ( benchSUB_COUNT + ( ulBucket & ( benchSUB_COUNT - 1UL ) ) ) + 1ULL ) << ulShift ) - 1ULL );
+}
+
+/*------------------------------------------------------------------*/
+static void prvBenchPrintLine( const char *pcLine )
+{
+	vPrintString( pcLine );
+
+	if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+	{
+		vTaskDelay( benchREPORT_LINE_TICKS );
+	}
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vBenchStatsReset( BenchStats_t *pxStats )
+{
+	memset( pxStats, 0, sizeof( *pxStats ) );
+	pxStats->ulMin = UINT32_MAX;
+}
+
+/*------------------------------------------------------------------*/
+void vBenchStatsAdd( BenchStats_t *pxStats, uint32_t ulSample )
+{
+	pxStats->ulCount++;
+	pxStats->ullSum += ulSample;
+
+	if( ulSample < pxStats->ulMin )
+	{
+		pxStats->ulMin = ulSample;
+	}
+	if( ulSample > pxStats->ulMax )
+	{
+		pxStats->ulMax = ulSample;
+	}
+
+	pxStats->ulBucket[ prvBenchBucket( ulSample ) ]++;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulBenchStatsPercentile( const BenchStats_t *pxStats, uint32_t ulPerMille )
+{
+	uint32_t ulRank, ulSeen = 0, ulValue = pxStats->ulMax, i;
+
+	if( pxStats->ulCount == 0UL )
+	{
+		return 0;
+	}
+
+	/* 1-based rank of the wanted sample, rounded up. */
+	ulRank = ( uint32_t )( ( ( uint64_t ) pxStats->ulCount * ulPerMille + 999ULL ) / 1000ULL );
+	if( ulRank == 0UL )
+	{
+		ulRank = 1UL;
+	}
+
+	for( i = prvBenchBucket( pxStats->ulMin ); i <= prvBenchBucket( pxStats->ulMax ); i++ )
+	{
+		ulSeen += pxStats->ulBucket[ i ];
+		if( ulSeen >= ulRank )
+		{
+			ulValue = prvBenchBucketTop( i );
+			break;
+		}
+	}
+
+	if( ulValue < pxStats->ulMin )
+	{
+		ulValue = pxStats->ulMin;
+	}
+	if( ulValue > pxStats->ulMax )
+	{
+		ulValue = pxStats->ulMax;
+	}
+
+	return ulValue;
+}
+
+/*------------------------------------------------------------------*/
+void vBenchStatsPrint( const char *pcName, const char *pcUnit, const BenchStats_t *pxStats )
+{
+	char cLine[ 96 ];
+	uint32_t ulRow[ 33 ], ulPeak = 0, ulFirst, ulLast, ulBar, i;
+
+	if( pxStats->ulCount == 0UL )
+	{
+		return;
+	}
+
+	snprintf( cLine, sizeof( cLine ), pcTextForBench_Summary, pcName,
+			  ( unsigned long ) pxStats->ulCount,
+			  ( unsigned long ) pxStats->ulMin,
+			  ( unsigned long ) ulBenchStatsPercentile( pxStats, 500UL ),
+			  ( unsigned long ) ulBenchStatsPercentile( pxStats, 990UL ),
+			  ( unsigned long ) pxStats->ulMax,
+			  ( unsigned long )( pxStats->ullSum / pxStats->ulCount ),
+			  pcUnit );
+	prvBenchPrintLine( cLine );
+
+	/* Fold the fine buckets into one row per power of two: row 0 holds
+	 * the sample 0, row r holds [ 2^(r-1), 2^r - 1 ]. */
+	memset( ulRow, 0, sizeof( ulRow ) );
+	for( i = 0; i < benchHISTOGRAM_BUCKETS; i++ )
+	{
+		uint32_t ulTop = prvBenchBucketTop( i );
+		uint32_t ulIndex = ( ulTop == 0UL ) ? 0UL : ( 32UL - ( uint32_t ) __builtin_clz( ulTop ) );
+
+		ulRow[ ulIndex ] += pxStats->ulBucket[ i ];
+	}
+
+	ulFirst = ( pxStats->ulMin == 0UL ) ? 0UL : ( 32UL - ( uint32_t ) __builtin_clz( pxStats->ulMin ) );
+	ulLast  = ( pxStats->ulMax == 0UL ) ? 0UL : ( 32UL - ( uint32_t ) __builtin_clz( pxStats->ulMax ) );
+	for( i = ulFirst; i <= ulLast; i++ )
+	{
+		if( ulRow[ i ] > ulPeak )
+		{
+			ulPeak = ulRow[ i ];
+		}
+	}
+
+	for( i = ulFirst; i <= ulLast; i++ )
+	{
+		/* Any non empty row gets at least one mark. */
+		ulBar = ( uint32_t )( ( ( uint64_t ) ulRow[ i ] * benchBAR_WIDTH + ulPeak - 1ULL ) / ulPeak );
+		snprintf( cLine, sizeof( cLine ), pcTextForBench_Row,
+				  ( unsigned long )( ( i == 0UL ) ? 0UL : ( 1UL << ( i - 1UL ) ) ),
+				  ( unsigned long )( ( i == 0UL ) ? 0UL : ( uint32_t )( ( 1ULL << i ) - 1ULL ) ),
+				  ( unsigned long ) ulRow[ i ],
+				  &pcTextForBench_Bar[ benchBAR_WIDTH - ulBar ] );
+		prvBenchPrintLine( cLine );
+	}
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
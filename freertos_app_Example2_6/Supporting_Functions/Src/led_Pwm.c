@@ -0,0 +1,216 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+
+/*--------------------------------------------------------------------*-
+
+    led_Pwm.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    Led PWM (timer output) for FreeRTOS - Event Driven System (EDS) -
+    Project for STM32F429ZI_NUCLEO_144.
+
+    Each led has a timer of its own, counting up in PWM mode 1: the
+    output is high while the counter is below the compare value. The
+    prescaler is chosen per period so the auto-reload fits in 16 bits,
+    which gives the best duty resolution the period allows.
+
+    Prescaler, auto-reload and compare are preloaded registers; an
+    update event is generated after writing them, so a new setting
+    takes effect at once and never leaves a period with mixed values.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Demo includes. */
+#include "led_Pwm.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define ledPWM_LEDS				3
+
+/* Largest auto-reload that leaves a compare value above it (16 bit
+ * timers), so an always on led needs no other output mode. */
+#define ledPWM_MAX_COUNTS		65535ULL
+
+// ------ internal data declaration ------------------------------------
+typedef struct
+{
+	GPIO_TypeDef	*pxPort;
+	uint16_t		usPin;
+	uint8_t			ucAlternate;
+	TIM_TypeDef		*pxTimer;
+	uint32_t		ulChannel;
+} LedPwmMap_t;
+
+// ------ internal functions declaration -------------------------------
+static uint32_t prvLedPwmClock( void );
+
+// ------ internal data definition -------------------------------------
+static const LedPwmMap_t xLedPwmMap[ ledPWM_LEDS ] =
+{
+	{ LD1_GPIO_Port, LD1_Pin, GPIO_AF2_TIM3,  TIM3,  TIM_CHANNEL_3 },
+	{ LD2_GPIO_Port, LD2_Pin, GPIO_AF2_TIM4,  TIM4,  TIM_CHANNEL_2 },
+	{ LD3_GPIO_Port, LD3_Pin, GPIO_AF9_TIM12, TIM12, TIM_CHANNEL_1 }
+};
+
+static TIM_HandleTypeDef xLedPwmTim[ ledPWM_LEDS ];
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+static uint32_t prvLedPwmClock( void )
+{
+	uint32_t ulClock = HAL_RCC_GetPCLK1Freq();
+
+	/* APB1 timers run at twice PCLK1 when APB1 is divided. */
+	if( ( RCC->CFGR & RCC_CFGR_PPRE1 ) != RCC_CFGR_PPRE1_DIV1 )
+	{
+		ulClock *= 2UL;
+	}
+	return ulClock;
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vLedPwmInit( void )
+{
+	GPIO_InitTypeDef xGpio = { 0 };
+	TIM_OC_InitTypeDef xOc = { 0 };
+	TIM_HandleTypeDef *pxTim;
+	HAL_StatusTypeDef xResult;
+	uint32_t ul;
+
+	__HAL_RCC_TIM3_CLK_ENABLE();
+	__HAL_RCC_TIM4_CLK_ENABLE();
+	__HAL_RCC_TIM12_CLK_ENABLE();
+
+	xOc.OCMode = TIM_OCMODE_PWM1;
+	xOc.Pulse = 0;
+	xOc.OCPolarity = TIM_OCPOLARITY_HIGH;
+	xOc.OCFastMode = TIM_OCFAST_DISABLE;
+
+	for( ul = 0; ul < ledPWM_LEDS; ul++ )
+	{
+		pxTim = &xLedPwmTim[ ul ];
+
+		pxTim->Instance = xLedPwmMap[ ul ].pxTimer;
+		pxTim->Init.Prescaler = 0;
+		pxTim->Init.CounterMode = TIM_COUNTERMODE_UP;
+		pxTim->Init.Period = ( uint32_t ) ledPWM_MAX_COUNTS - 1UL;
+		pxTim->Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+		pxTim->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+
+		xResult = HAL_TIM_PWM_Init( pxTim );
+		configASSERT( xResult == HAL_OK );
+		xResult = HAL_TIM_PWM_ConfigChannel( pxTim, &xOc, xLedPwmMap[ ul ].ulChannel );
+		configASSERT( xResult == HAL_OK );
+		xResult = HAL_TIM_PWM_Start( pxTim, xLedPwmMap[ ul ].ulChannel );
+		configASSERT( xResult == HAL_OK );
+		( void ) xResult;
+
+		/* Hand the pin over to the timer once its output is low. */
+		xGpio.Pin = xLedPwmMap[ ul ].usPin;
+		xGpio.Mode = GPIO_MODE_AF_PP;
+		xGpio.Pull = GPIO_NOPULL;
+		xGpio.Speed = GPIO_SPEED_FREQ_LOW;
+		xGpio.Alternate = xLedPwmMap[ ul ].ucAlternate;
+		HAL_GPIO_Init( xLedPwmMap[ ul ].pxPort, &xGpio );
+	}
+}
+
+/*------------------------------------------------------------------*/
+void vLedPwmSet( GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, uint32_t ulPeriodUs, uint32_t ulOnUs )
+{
+	TIM_HandleTypeDef *pxTim = NULL;
+	uint64_t ullCounts, ullOn;
+	uint32_t ulPrescaler, ulReload, ulCompare, ulClock, ul;
+
+	for( ul = 0; ul < ledPWM_LEDS; ul++ )
+	{
+		if( ( xLedPwmMap[ ul ].pxPort == GPIOx ) && ( xLedPwmMap[ ul ].usPin == GPIO_Pin ) )
+		{
+			pxTim = &xLedPwmTim[ ul ];
+			break;
+		}
+	}
+	configASSERT( pxTim != NULL );
+
+	ulClock = prvLedPwmClock();
+	ullCounts = ( ( uint64_t ) ulPeriodUs * ulClock ) / 1000000ULL;
+	if( ullCounts < 2ULL )
+	{
+		ullCounts = 2ULL;
+	}
+
+	ulPrescaler = ( uint32_t )( ( ullCounts - 1ULL ) / ledPWM_MAX_COUNTS ) + 1UL;
+	configASSERT( ulPrescaler <= 65536UL );
+	ulReload = ( uint32_t )( ullCounts / ulPrescaler );
+
+	if( ulOnUs == 0UL )
+	{
+		ulCompare = 0UL;
+	}
+	else if( ulOnUs >= ulPeriodUs )
+	{
+		ulCompare = ulReload;
+	}
+	else
+	{
+		ullOn = ( ( uint64_t ) ulOnUs * ulClock ) / 1000000ULL;
+		ulCompare = ( uint32_t )( ullOn / ulPrescaler );
+	}
+
+	taskENTER_CRITICAL();
+	__HAL_TIM_SET_PRESCALER( pxTim, ulPrescaler - 1UL );
+	__HAL_TIM_SET_AUTORELOAD( pxTim, ulReload - 1UL );
+	__HAL_TIM_SET_COMPARE( pxTim, xLedPwmMap[ ul ].ulChannel, ulCompare );
+	pxTim->Instance->EGR = TIM_EGR_UG;
+	taskEXIT_CRITICAL();
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
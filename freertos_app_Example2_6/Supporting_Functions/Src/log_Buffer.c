@@ -0,0 +1,276 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    log_Buffer.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    Log ring buffer for FreeRTOS - Event Driven System (EDS) - Project
+    for STM32F429ZI_NUCLEO_144.
+
+    Bounded multi-producer queue of fixed size slots (one line per
+    slot). Each slot carries a sequence number that tells producers and
+    the consumer whose turn it is, so the only shared write is a
+    compare-and-swap on the head index (LDREX/STREX on the Cortex-M4).
+    Nothing here depends on the kernel or the HAL, so the same file
+    builds on the host.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Standard includes. */
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+/* Demo includes. */
+#include "log_Buffer.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define logMASK		( ( uint32_t ) logBUFFER_SLOT_COUNT - 1UL )
+
+/* Sequence numbers are kept relative to the slot index so that a zeroed
+ * (.bss) ring is already a valid empty ring and producers may run before
+ * any init code. For the slot at position ulPos:
+ *   free for the producer  -> ulSequence == LAP( ulPos )
+ *   ready for the consumer -> ulSequence == LAP( ulPos ) + 1           */
+#define logLAP( ulPos )	( ( ulPos ) & ~logMASK )
+
+// ------ internal data declaration ------------------------------------
+typedef struct
+{
+	uint32_t ulSequence;
+	uint16_t usLength;
+	char     cData[ logBUFFER_SLOT_SIZE ];
+} LogSlot_t;
+
+// ------ internal functions declaration -------------------------------
+static LogSlot_t *prvLogBufferReserve( uint32_t *pulPosition );
+static void prvLogBufferCommit( LogSlot_t *pxSlot, uint32_t ulPosition, size_t xLength );
+static void prvLogBufferCount( uint32_t *pulCounter );
+
+// ------ internal data definition -------------------------------------
+static LogSlot_t xLogSlot[ logBUFFER_SLOT_COUNT ];
+
+/* Next position to reserve (shared by producers) and next position to
+ * read (owned by the consumer). */
+static uint32_t ulLogHead;
+static uint32_t ulLogTail;
+
+static LogBufferStats_t xLogStats;
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+static LogSlot_t *prvLogBufferReserve( uint32_t *pulPosition )
+{
+	uint32_t ulPos = __atomic_load_n( &ulLogHead, __ATOMIC_RELAXED );
+	uint32_t ulUsed, ulHighWater;
+	LogSlot_t *pxSlot;
+	int32_t lDiff;
+
+	for( ;; )
+	{
+		pxSlot = &xLogSlot[ ulPos & logMASK ];
+		lDiff = ( int32_t )( __atomic_load_n( &pxSlot->ulSequence, __ATOMIC_ACQUIRE ) - logLAP( ulPos ) );
+
+		if( lDiff == 0 )
+		{
+			/* Slot is free, claim the position. On failure ulPos is
+			 * reloaded with the current head and we try again. */
+			if( __atomic_compare_exchange_n( &ulLogHead, &ulPos, ulPos + 1UL, 0,
+											 __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+			{
+				break;
+			}
+		}
+		else if( lDiff < 0 )
+		{
+			/* Slot still holds a line from the previous lap: ring full. */
+			prvLogBufferCount( &xLogStats.ulDropped );
+			return NULL;
+		}
+		else
+		{
+			/* Another producer took this position first. */
+			ulPos = __atomic_load_n( &ulLogHead, __ATOMIC_RELAXED );
+		}
+	}
+
+	/* Track the high-water mark. */
+	ulUsed = ulPos + 1UL - __atomic_load_n( &ulLogTail, __ATOMIC_ACQUIRE );
+	ulHighWater = __atomic_load_n( &xLogStats.ulHighWater, __ATOMIC_RELAXED );
+	while( ( ulUsed > ulHighWater ) &&
+		   !__atomic_compare_exchange_n( &xLogStats.ulHighWater, &ulHighWater, ulUsed, 0,
+										 __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+	{
+	}
+
+	*pulPosition = ulPos;
+	return pxSlot;
+}
+
+/*------------------------------------------------------------------*/
+static void prvLogBufferCommit( LogSlot_t *pxSlot, uint32_t ulPosition, size_t xLength )
+{
+	pxSlot->usLength = ( uint16_t ) xLength;
+
+	/* Publish the line to the consumer. */
+	__atomic_store_n( &pxSlot->ulSequence, logLAP( ulPosition ) + 1UL, __ATOMIC_RELEASE );
+	prvLogBufferCount( &xLogStats.ulWritten );
+}
+
+/*------------------------------------------------------------------*/
+static void prvLogBufferCount( uint32_t *pulCounter )
+{
+	__atomic_fetch_add( pulCounter, 1UL, __ATOMIC_RELAXED );
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+uint32_t ulLogBufferWrite( const char *pcData, size_t xLength )
+{
+	uint32_t ulPos;
+	LogSlot_t *pxSlot = prvLogBufferReserve( &ulPos );
+
+	if( pxSlot == NULL )
+	{
+		return 0;
+	}
+
+	if( xLength > logBUFFER_SLOT_SIZE )
+	{
+		memcpy( pxSlot->cData, pcData, logBUFFER_SLOT_SIZE );
+
+		/* Keep the line terminator of a truncated line. */
+		if( pcData[ xLength - 1 ] == '\n' )
+		{
+			pxSlot->cData[ logBUFFER_SLOT_SIZE - 2 ] = '\r';
+			pxSlot->cData[ logBUFFER_SLOT_SIZE - 1 ] = '\n';
+		}
+		xLength = logBUFFER_SLOT_SIZE;
+		prvLogBufferCount( &xLogStats.ulTruncated );
+	}
+	else
+	{
+		memcpy( pxSlot->cData, pcData, xLength );
+	}
+
+	prvLogBufferCommit( pxSlot, ulPos, xLength );
+	return 1;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulLogBufferPrintf( const char *pcFormat, ... )
+{
+	uint32_t ulPos;
+	LogSlot_t *pxSlot = prvLogBufferReserve( &ulPos );
+	va_list xArgs;
+	int iLength;
+
+	if( pxSlot == NULL )
+	{
+		return 0;
+	}
+
+	/* Format straight into the claimed slot. */
+	va_start( xArgs, pcFormat );
+	iLength = vsnprintf( pxSlot->cData, logBUFFER_SLOT_SIZE, pcFormat, xArgs );
+	va_end( xArgs );
+
+	if( iLength < 0 )
+	{
+		iLength = 0;
+	}
+	else if( iLength >= logBUFFER_SLOT_SIZE )
+	{
+		/* Keep the line terminator of a truncated line. */
+		iLength = logBUFFER_SLOT_SIZE - 1;
+		pxSlot->cData[ iLength - 2 ] = '\r';
+		pxSlot->cData[ iLength - 1 ] = '\n';
+		prvLogBufferCount( &xLogStats.ulTruncated );
+	}
+
+	prvLogBufferCommit( pxSlot, ulPos, ( size_t ) iLength );
+	return 1;
+}
+
+/*------------------------------------------------------------------*/
+size_t xLogBufferRead( char *pcBuffer, size_t xBufferLength )
+{
+	uint32_t ulPos = ulLogTail;
+	LogSlot_t *pxSlot = &xLogSlot[ ulPos & logMASK ];
+	size_t xLength;
+
+	if( __atomic_load_n( &pxSlot->ulSequence, __ATOMIC_ACQUIRE ) != ( logLAP( ulPos ) + 1UL ) )
+	{
+		/* Empty, or the producer of the oldest line has not finished yet. */
+		return 0;
+	}
+
+	xLength = pxSlot->usLength;
+	if( xLength > xBufferLength )
+	{
+		xLength = xBufferLength;
+	}
+	memcpy( pcBuffer, pxSlot->cData, xLength );
+
+	/* Hand the slot back to producers for the next lap. */
+	__atomic_store_n( &pxSlot->ulSequence, logLAP( ulPos ) + logBUFFER_SLOT_COUNT, __ATOMIC_RELEASE );
+	__atomic_store_n( &ulLogTail, ulPos + 1UL, __ATOMIC_RELEASE );
+
+	return xLength;
+}
+
+/*------------------------------------------------------------------*/
+void vLogBufferGetStats( LogBufferStats_t *pxStats )
+{
+	pxStats->ulWritten   = __atomic_load_n( &xLogStats.ulWritten,   __ATOMIC_RELAXED );
+	pxStats->ulDropped   = __atomic_load_n( &xLogStats.ulDropped,   __ATOMIC_RELAXED );
+	pxStats->ulTruncated = __atomic_load_n( &xLogStats.ulTruncated, __ATOMIC_RELAXED );
+	pxStats->ulHighWater = __atomic_load_n( &xLogStats.ulHighWater, __ATOMIC_RELAXED );
+	pxStats->ulCapacity  = logBUFFER_SLOT_COUNT;
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
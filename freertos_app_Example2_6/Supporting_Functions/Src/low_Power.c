@@ -0,0 +1,376 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+
+/*--------------------------------------------------------------------*-
+
+    low_Power.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    Tickless idle for FreeRTOS - Event Driven System (EDS) - Project
+    for STM32F429ZI_NUCLEO_144.
+
+    The RTC is set up by rtc_Clock: its sub-second register counts at
+    the same 16384 Hz as the wakeup timer (WUCKSEL = RTC / 2), shadow
+    registers bypassed so they can be read right after STOP mode.
+
+    Time is kept in units of 1 / ( configTICK_RATE_HZ * 16384 ) s: one
+    tick is lowPOWER_RTC_HZ units and one RTC count configTICK_RATE_HZ
+    units, so converting between them never rounds.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Demo includes. */
+#include "supporting_Functions.h"
+#include "uart_Tx.h"
+#include "rtc_Clock.h"
+#include "low_Power.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define lowPOWER_RTC_HZ			rtcCLOCK_HZ
+#define lowPOWER_DAY_COUNTS		( 86400UL * lowPOWER_RTC_HZ )
+
+/* The wakeup timer counts at most 2^16 RTC counts. */
+#define lowPOWER_MAX_IDLE_TICKS	( ( 65536UL * configTICK_RATE_HZ ) / lowPOWER_RTC_HZ )
+
+#define lowPOWER_IRQ_PRIORITY	configLIBRARY_LOWEST_INTERRUPT_PRIORITY
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+static uint32_t prvLowPowerReady( void );
+static uint32_t prvLowPowerRtcNow( void );
+static void prvLowPowerWakeupStart( uint32_t ulCounts );
+static void prvLowPowerWakeupStop( void );
+#if( lowPOWER_MEASURE == 1 )
+static void prvLowPowerMeasureTask( void *pvParameters );
+#endif
+
+// ------ internal data definition -------------------------------------
+static uint8_t ucLowPowerReady;
+
+/* Counters for the measurement report. */
+static volatile uint32_t ulLowPowerStops;
+static volatile uint32_t ulLowPowerStepped;
+static volatile uint64_t ullLowPowerStopCounts;
+
+#if( lowPOWER_MEASURE == 1 )
+static const char *pcTextForLowPower_Report = "  <=> Task  Power - wakeups/s: %lu (stop: %lu tick: %lu) in stop: %lu.%lu%%\r\n";
+#endif
+
+// ------ external data definition -------------------------------------
+/* Generated by CubeMX in main.c. */
+extern void SystemClock_Config( void );
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+static uint32_t prvLowPowerReady( void )
+{
+	if( ucLowPowerReady != 0 )
+	{
+		return 1UL;
+	}
+
+	/* Keep ticking until vRtcClockInit() has run and the LSE is stable. */
+	if( ulRtcClockReady() == 0UL )
+	{
+		return 0UL;
+	}
+
+	/* Wakeup timer event on EXTI line 22, rising edge. */
+	EXTI->IMR |= EXTI_IMR_MR22;
+	EXTI->RTSR |= EXTI_RTSR_TR22;
+	EXTI->PR = EXTI_PR_PR22;
+	HAL_NVIC_SetPriority( RTC_WKUP_IRQn, lowPOWER_IRQ_PRIORITY, 0 );
+	HAL_NVIC_EnableIRQ( RTC_WKUP_IRQn );
+
+#if( lowPOWER_DEBUG == 1 )
+	DBGMCU->CR |= DBGMCU_CR_DBG_STOP;
+#endif
+
+	ucLowPowerReady = 1;
+	return 1UL;
+}
+
+/*------------------------------------------------------------------*/
+static uint32_t prvLowPowerRtcNow( void )
+{
+	uint32_t ulSsr, ulTr, ulSeconds;
+
+	/* Shadow registers are bypassed: read until two readings agree. */
+	do
+	{
+		ulSsr = RTC->SSR;
+		ulTr = RTC->TR;
+	} while( ( ulSsr != RTC->SSR ) || ( ulTr != RTC->TR ) );
+
+	ulSeconds = ( ( ( ulTr & RTC_TR_HT ) >> RTC_TR_HT_Pos ) * 10UL + ( ( ulTr & RTC_TR_HU ) >> RTC_TR_HU_Pos ) ) * 3600UL +
+				( ( ( ulTr & RTC_TR_MNT ) >> RTC_TR_MNT_Pos ) * 10UL + ( ( ulTr & RTC_TR_MNU ) >> RTC_TR_MNU_Pos ) ) * 60UL +
+				( ( ( ulTr & RTC_TR_ST ) >> RTC_TR_ST_Pos ) * 10UL + ( ( ulTr & RTC_TR_SU ) >> RTC_TR_SU_Pos ) );
+
+	/* The sub-second register counts down. */
+	return ulSeconds * lowPOWER_RTC_HZ + ( lowPOWER_RTC_HZ - 1UL - ( ulSsr & RTC_SSR_SS ) );
+}
+
+/*------------------------------------------------------------------*/
+static void prvLowPowerWakeupStart( uint32_t ulCounts )
+{
+	RTC->WPR = 0xCA;
+	RTC->WPR = 0x53;
+
+	RTC->CR &= ~( RTC_CR_WUTE | RTC_CR_WUTIE );
+	while( ( RTC->ISR & RTC_ISR_WUTWF ) == 0 )
+	{
+	}
+	RTC->WUTR = ulCounts - 1UL;
+	RTC->CR = ( RTC->CR & ~RTC_CR_WUCKSEL ) | RTC_CR_WUCKSEL_0 | RTC_CR_WUCKSEL_1;
+
+	/* Clear a stale flag (rc_w0 bits, leave INIT as it is). */
+	RTC->ISR = ( ~( RTC_ISR_WUTF | RTC_ISR_INIT ) & 0x0001FFFFUL ) | ( RTC->ISR & RTC_ISR_INIT );
+	EXTI->PR = EXTI_PR_PR22;
+
+	RTC->CR |= RTC_CR_WUTE | RTC_CR_WUTIE;
+
+	RTC->WPR = 0xFF;
+}
+
+/*------------------------------------------------------------------*/
+static void prvLowPowerWakeupStop( void )
+{
+	RTC->WPR = 0xCA;
+	RTC->WPR = 0x53;
+	RTC->CR &= ~( RTC_CR_WUTE | RTC_CR_WUTIE );
+	RTC->ISR = ( ~( RTC_ISR_WUTF | RTC_ISR_INIT ) & 0x0001FFFFUL ) | ( RTC->ISR & RTC_ISR_INIT );
+	RTC->WPR = 0xFF;
+
+	EXTI->PR = EXTI_PR_PR22;
+	NVIC_ClearPendingIRQ( RTC_WKUP_IRQn );
+}
+
+#if( lowPOWER_MEASURE == 1 )
+/*------------------------------------------------------------------*/
+static void prvLowPowerMeasureTask( void *pvParameters )
+{
+	char cLine[ 96 ];
+	TickType_t xLastWakeTime, xLastTick;
+	uint32_t ulLastStops, ulLastStepped, ulStops, ulStepped, ulTicks, ulTickIrqs, ulPerMille;
+	uint64_t ullLastCounts, ullCounts;
+
+	( void ) pvParameters;
+
+	xLastWakeTime = xLastTick = xTaskGetTickCount();
+	ulLastStops = ulLowPowerStops;
+	ulLastStepped = ulLowPowerStepped;
+	ullLastCounts = ullLowPowerStopCounts;
+
+	for( ;; )
+	{
+		/* This task wakes the CPU once per report as well. */
+		vTaskDelayUntil( &xLastWakeTime, pdMS_TO_TICKS( lowPOWER_MEASURE_MS ) );
+
+		taskENTER_CRITICAL();
+		{
+			ulTicks = ( uint32_t )( xTaskGetTickCount() - xLastTick );
+			ulStops = ulLowPowerStops - ulLastStops;
+			ulStepped = ulLowPowerStepped - ulLastStepped;
+			ullCounts = ullLowPowerStopCounts - ullLastCounts;
+
+			xLastTick += ulTicks;
+			ulLastStops = ulLowPowerStops;
+			ulLastStepped = ulLowPowerStepped;
+			ullLastCounts = ullLowPowerStopCounts;
+		}
+		taskEXIT_CRITICAL();
+
+		/* Ticks not stepped after a sleep came from a SysTick interrupt. */
+		ulTickIrqs = ulTicks - ulStepped;
+		ulPerMille = ( ulTicks == 0UL ) ? 0UL :
+					 ( uint32_t )( ( ullCounts * 1000ULL * configTICK_RATE_HZ ) / ( ( uint64_t ) ulTicks * lowPOWER_RTC_HZ ) );
+		ulTicks = ( ulTicks == 0UL ) ? 1UL : ulTicks;
+
+		snprintf( cLine, sizeof( cLine ), pcTextForLowPower_Report,
+				  ( unsigned long )( ( ( uint64_t )( ulStops + ulTickIrqs ) * configTICK_RATE_HZ ) / ulTicks ),
+				  ( unsigned long )( ( ( uint64_t ) ulStops * configTICK_RATE_HZ ) / ulTicks ),
+				  ( unsigned long )( ( ( uint64_t ) ulTickIrqs * configTICK_RATE_HZ ) / ulTicks ),
+				  ( unsigned long )( ulPerMille / 10UL ), ( unsigned long )( ulPerMille % 10UL ) );
+		vPrintString( cLine );
+	}
+}
+#endif
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vLowPowerInit( void )
+{
+	/* Same RTC as the calendar, vRtcClockInit() may have run already. */
+	vRtcClockInit();
+
+#if( lowPOWER_MEASURE == 1 )
+	{
+		BaseType_t ret;
+
+		ret = xTaskCreate( prvLowPowerMeasureTask,		/* Pointer to the function thats implement the task. */
+						   "Task Power",				/* Text name for the task. This is to facilitate debugging only. */
+						   2 * configMINIMAL_STACK_SIZE,/* Stack depth in words. 				*/
+						   NULL,						/* We are not using the task parameter.		*/
+						   tskIDLE_PRIORITY + 1UL,		/* This task will run at low priority. 		*/
+						   NULL );						/* We are not using the task handle.		*/
+
+		/* Check the task was created successfully. */
+		configASSERT( ret == pdPASS );
+	}
+#endif
+}
+
+/*------------------------------------------------------------------*/
+void vLowPowerSuppressTicksAndSleep( uint32_t ulExpectedIdleTime )
+{
+	uint32_t ulLoad, ulPosition, ulTarget, ulCounts, ulStart, ulElapsed, ulTicks, ulReload;
+	uint64_t ullPosition;
+
+	/* STOP mode halts the USART clock: while the console is sending, or
+	 * before the RTC runs, sleep until the next interrupt instead. */
+	if( ( prvLowPowerReady() == 0UL ) || ( ulUartTxIdle() == 0UL ) )
+	{
+		__DSB();
+		__WFI();
+		return;
+	}
+
+	if( ulExpectedIdleTime > lowPOWER_MAX_IDLE_TICKS )
+	{
+		ulExpectedIdleTime = lowPOWER_MAX_IDLE_TICKS;
+	}
+
+	/* Masked with PRIMASK: a pending interrupt still ends the WFI, but
+	 * runs only once the tick count is right again. */
+	__disable_irq();
+	__DSB();
+	__ISB();
+
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+	/* Part of the current tick already gone. */
+	ulLoad = SysTick->LOAD + 1UL;
+	ulPosition = ( uint32_t )( ( ( uint64_t )( ulLoad - SysTick->VAL ) * lowPOWER_RTC_HZ ) / ulLoad );
+
+	/* Wake at the start of the last idle tick, SysTick does the rest. */
+	ulTarget = ( ulExpectedIdleTime - 1UL ) * lowPOWER_RTC_HZ;
+	ulCounts = ( ulTarget > ulPosition ) ? ( ( ulTarget - ulPosition ) / configTICK_RATE_HZ ) : 0UL;
+
+	if( ( eTaskConfirmSleepModeStatus() == eAbortSleep ) ||
+		( ( SCB->ICSR & SCB_ICSR_PENDSTSET_Msk ) != 0 ) ||
+		( ulCounts < lowPOWER_MIN_COUNTS ) )
+	{
+		/* Carry on counting the current tick from where it stopped. */
+		SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+		__enable_irq();
+		return;
+	}
+
+	ulStart = prvLowPowerRtcNow();
+	prvLowPowerWakeupStart( ulCounts );
+
+	HAL_PWR_EnterSTOPMode( PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI );
+
+	/* Back on the HSI: restart the PLL before anything else. */
+	SystemClock_Config();
+
+	ulElapsed = ( prvLowPowerRtcNow() + lowPOWER_DAY_COUNTS - ulStart ) % lowPOWER_DAY_COUNTS;
+	prvLowPowerWakeupStop();
+
+	/* Whole ticks slept, the remainder is carried into the next tick. */
+	ullPosition = ( uint64_t ) ulPosition + ( uint64_t ) ulElapsed * configTICK_RATE_HZ;
+	ulTicks = ( uint32_t )( ullPosition / lowPOWER_RTC_HZ );
+	ulPosition = ( uint32_t )( ullPosition % lowPOWER_RTC_HZ );
+	if( ulTicks > ( ulExpectedIdleTime - 1UL ) )
+	{
+		/* Woke late: step to the tick before the due one and let SysTick
+		 * fire right away. */
+		ulTicks = ulExpectedIdleTime - 1UL;
+		ulPosition = lowPOWER_RTC_HZ - 1UL;
+	}
+
+	/* The core clock stopped as well: keep CYCCNT, and with it the run
+	 * time stats and trace timestamps, in step with real time. */
+	if( ( DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk ) != 0 )
+	{
+		DWT->CYCCNT += ( uint32_t )( ( ( uint64_t ) ulElapsed * SystemCoreClock ) / lowPOWER_RTC_HZ );
+	}
+
+	/* Next interrupt at the end of the current tick, then full ticks. */
+	ulReload = ( uint32_t )( ( ( uint64_t )( lowPOWER_RTC_HZ - ulPosition ) * ulLoad ) / lowPOWER_RTC_HZ );
+	SysTick->LOAD = ( ulReload > 1UL ) ? ( ulReload - 1UL ) : 1UL;
+	SysTick->VAL = 0UL;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+	SysTick->LOAD = ulLoad - 1UL;
+
+	vTaskStepTick( ulTicks );
+
+	ulLowPowerStops++;
+	ulLowPowerStepped += ulTicks;
+	ullLowPowerStopCounts += ulElapsed;
+
+	__enable_irq();
+}
+
+/*------------------------------------------------------------------*/
+void RTC_WKUP_IRQHandler( void )
+{
+	/* Normally cleared in vLowPowerSuppressTicksAndSleep() already. */
+	RTC->WPR = 0xCA;
+	RTC->WPR = 0x53;
+	RTC->ISR = ( ~( RTC_ISR_WUTF | RTC_ISR_INIT ) & 0x0001FFFFUL ) | ( RTC->ISR & RTC_ISR_INIT );
+	RTC->WPR = 0xFF;
+	EXTI->PR = EXTI_PR_PR22;
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,382 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+
+/*--------------------------------------------------------------------*-
+
+    run_Stats.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    Run time statistics task for FreeRTOS - Event Driven System (EDS) -
+    Project for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Demo includes. */
+#include "supporting_Functions.h"
+#include "run_Stats.h"
+
+#if( runSTATS_ENABLE == 1 )
+
+#if( ( configGENERATE_RUN_TIME_STATS != 1 ) || ( configUSE_TRACE_FACILITY != 1 ) )
+	#error run_Stats needs configGENERATE_RUN_TIME_STATS and configUSE_TRACE_FACILITY
+#endif
+
+// ------ Macros and definitions ---------------------------------------
+/* Same default as tasks.c, used to find the idle task for the load. */
+#ifndef configIDLE_TASK_NAME
+	#define configIDLE_TASK_NAME	"IDLE"
+#endif
+
+// ------ internal data declaration ------------------------------------
+/* One followed task. ulSample[] holds the cycles it ran in each sample
+ * of the window, ulCounter the kernel counter at the last sample. */
+typedef struct
+{
+	TaskHandle_t xHandle;
+	uint32_t ulCounter;
+	uint64_t ullTotal;
+	uint32_t ulSample[ runSTATS_WINDOW_SAMPLES ];
+	configSTACK_DEPTH_TYPE usStackFree;
+	char     cName[ configMAX_TASK_NAME_LEN ];
+} RunStatsTask_t;
+
+// ------ internal functions declaration -------------------------------
+static void prvRunStatsTask( void *pvParameters );
+static void prvRunStatsSample( void );
+static void prvRunStatsReport( void );
+static void prvRunStatsPrintLine( const char *pcLine );
+static uint32_t prvRunStatsFragmentation( const HeapStats_t *pxHeap );
+
+// ------ internal data definition -------------------------------------
+static RunStatsTask_t xRunStatsTask[ runSTATS_MAX_TASKS ];
+static TaskStatus_t xRunStatsStatus[ runSTATS_MAX_TASKS ];
+
+/* Cycles of each sample, and the run time clock extended to 64 bits. */
+static uint32_t ulRunStatsWindow[ runSTATS_WINDOW_SAMPLES ];
+static uint32_t ulRunStatsSlot;
+static uint32_t ulRunStatsLast;
+static uint64_t ullRunStatsClock;
+
+/* Last heap sample, and the worst values seen since the start. */
+static HeapStats_t xRunStatsHeap;
+static size_t xRunStatsMinLargest = ( size_t ) configTOTAL_HEAP_SIZE;
+static uint32_t ulRunStatsMaxFrag;
+
+/* Samples skipped since the last report, with more tasks than
+ * runSTATS_MAX_TASKS. */
+static uint32_t ulRunStatsSkipped;
+
+static const char *pcTextForRunStats_Header	= "  <=> Task  Stats - window: %lu ms load: %lu.%lu%% uptime: %lu s\r\n";
+static const char *pcTextForRunStats_Heap	= "      heap free: %lu/%lu B min: %lu B allocs: %lu frees: %lu\r\n";
+static const char *pcTextForRunStats_Frag	= "      heap largest: %lu B (min %lu B) blocks: %lu frag: %lu.%lu%% (max %lu.%lu%%)\r\n";
+static const char *pcTextForRunStats_Over	= "  <=> Task  Stats - tasks: %lu over runSTATS_MAX_TASKS %lu, %lu samples skipped\r\n";
+static const char *pcTextForRunStats_Row	= "      %-16s %3lu.%lu%% %10lu cycles %8lu Mcycles total %5lu w free%s\r\n";
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+static void prvRunStatsTask( void *pvParameters )
+{
+	TickType_t xLastWakeTime;
+	uint32_t ulSamples = 0, i;
+
+	( void ) pvParameters;
+
+	/* The first sample only sets the starting point of the window. */
+	prvRunStatsSample();
+	memset( ulRunStatsWindow, 0, sizeof( ulRunStatsWindow ) );
+	for( i = 0; i < runSTATS_MAX_TASKS; i++ )
+	{
+		memset( xRunStatsTask[ i ].ulSample, 0, sizeof( xRunStatsTask[ i ].ulSample ) );
+	}
+
+	xLastWakeTime = xTaskGetTickCount();
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLastWakeTime, pdMS_TO_TICKS( runSTATS_SAMPLE_MS ) );
+
+		ulRunStatsSlot = ( ulRunStatsSlot + 1UL ) % runSTATS_WINDOW_SAMPLES;
+		prvRunStatsSample();
+
+		if( ++ulSamples >= runSTATS_REPORT_SAMPLES )
+		{
+			ulSamples = 0;
+			prvRunStatsReport();
+		}
+	}
+}
+
+/*------------------------------------------------------------------*/
+static void prvRunStatsSample( void )
+{
+	UBaseType_t uxCount, x;
+	uint32_t ulTotal, ulDelta, ulFrag, i;
+	RunStatsTask_t *pxTask, *pxFree;
+	uint8_t ucSeen[ runSTATS_MAX_TASKS ];
+
+	/* Walks the heap_4 free list with the scheduler suspended. */
+	vPortGetHeapStats( &xRunStatsHeap );
+
+	if( xRunStatsHeap.xSizeOfLargestFreeBlockInBytes < xRunStatsMinLargest )
+	{
+		xRunStatsMinLargest = xRunStatsHeap.xSizeOfLargestFreeBlockInBytes;
+	}
+
+	ulFrag = prvRunStatsFragmentation( &xRunStatsHeap );
+	if( ulFrag > ulRunStatsMaxFrag )
+	{
+		ulRunStatsMaxFrag = ulFrag;
+	}
+
+	uxCount = uxTaskGetSystemState( xRunStatsStatus, runSTATS_MAX_TASKS, &ulTotal );
+
+	/* Zero means more tasks than runSTATS_MAX_TASKS: the slot stays
+	 * empty and the next sample takes these cycles. */
+	if( uxCount == 0 )
+	{
+		ulRunStatsSkipped++;
+		ulRunStatsWindow[ ulRunStatsSlot ] = 0;
+		for( i = 0; i < runSTATS_MAX_TASKS; i++ )
+		{
+			xRunStatsTask[ i ].ulSample[ ulRunStatsSlot ] = 0;
+		}
+		return;
+	}
+
+	/* Unsigned differences stay right across a wrap of the counter. */
+	ulDelta = ulTotal - ulRunStatsLast;
+	ulRunStatsLast = ulTotal;
+	ullRunStatsClock += ulDelta;
+	ulRunStatsWindow[ ulRunStatsSlot ] = ulDelta;
+
+	memset( ucSeen, 0, sizeof( ucSeen ) );
+	for( x = 0; x < uxCount; x++ )
+	{
+		pxFree = NULL;
+		pxTask = NULL;
+		for( i = 0; i < runSTATS_MAX_TASKS; i++ )
+		{
+			/* A new task may get the TCB of a deleted one, check the name. */
+			if( ( xRunStatsTask[ i ].xHandle == xRunStatsStatus[ x ].xHandle ) &&
+				( strncmp( xRunStatsTask[ i ].cName, xRunStatsStatus[ x ].pcTaskName, configMAX_TASK_NAME_LEN - 1 ) == 0 ) )
+			{
+				pxTask = &xRunStatsTask[ i ];
+				break;
+			}
+			if( ( pxFree == NULL ) && ( xRunStatsTask[ i ].xHandle == NULL ) )
+			{
+				pxFree = &xRunStatsTask[ i ];
+			}
+		}
+
+		if( pxTask == NULL )
+		{
+			/* New task, its counter started at zero. */
+			configASSERT( pxFree != NULL );
+			pxTask = pxFree;
+			pxTask->xHandle = xRunStatsStatus[ x ].xHandle;
+			strncpy( pxTask->cName, xRunStatsStatus[ x ].pcTaskName, configMAX_TASK_NAME_LEN - 1 );
+		}
+		ucSeen[ pxTask - xRunStatsTask ] = 1;
+
+		ulDelta = xRunStatsStatus[ x ].ulRunTimeCounter - pxTask->ulCounter;
+		pxTask->ulCounter = xRunStatsStatus[ x ].ulRunTimeCounter;
+		pxTask->ullTotal += ulDelta;
+		pxTask->ulSample[ ulRunStatsSlot ] = ulDelta;
+
+		/* The least free stack since the task started. */
+		pxTask->usStackFree = xRunStatsStatus[ x ].usStackHighWaterMark;
+	}
+
+	/* Forget the tasks that were deleted since the last sample. */
+	for( i = 0; i < runSTATS_MAX_TASKS; i++ )
+	{
+		if( ucSeen[ i ] == 0 )
+		{
+			memset( &xRunStatsTask[ i ], 0, sizeof( xRunStatsTask[ i ] ) );
+		}
+	}}
+
+/*------------------------------------------------------------------*/
+static uint32_t prvRunStatsFragmentation( const HeapStats_t *pxHeap )
+{
+	size_t xFree = pxHeap->xAvailableHeapSpaceInBytes;
+
+	if( xFree == 0 )
+	{
+		return 0UL;
+	}
+
+	/* Per mille of the free heap outside the largest free block. */
+	return ( uint32_t )( ( ( uint64_t )( xFree - pxHeap->xSizeOfLargestFreeBlockInBytes ) * 1000ULL ) / xFree );
+}
+
+/*------------------------------------------------------------------*/
+static void prvRunStatsReport( void )
+{
+	/* Rows fit the log slot, the room is for the worst case widths. */
+	char cLine[ 128 ];
+	uint64_t ullWindow = 0, ullTask, ullIdle = 0;
+	uint32_t ulPerMille, ulCyclesPerMs, i, j;
+
+	if( ulRunStatsSkipped != 0 )
+	{
+		snprintf( cLine, sizeof( cLine ), pcTextForRunStats_Over,
+				  ( unsigned long ) uxTaskGetNumberOfTasks(), ( unsigned long ) runSTATS_MAX_TASKS,
+				  ( unsigned long ) ulRunStatsSkipped );
+		prvRunStatsPrintLine( cLine );
+		ulRunStatsSkipped = 0;
+	}
+
+	for( j = 0; j < runSTATS_WINDOW_SAMPLES; j++ )
+	{
+		ullWindow += ulRunStatsWindow[ j ];
+	}
+	if( ullWindow == 0ULL )
+	{
+		return;
+	}
+
+	for( i = 0; i < runSTATS_MAX_TASKS; i++ )
+	{
+		if( strcmp( xRunStatsTask[ i ].cName, configIDLE_TASK_NAME ) == 0 )
+		{
+			for( j = 0; j < runSTATS_WINDOW_SAMPLES; j++ )
+			{
+				ullIdle += xRunStatsTask[ i ].ulSample[ j ];
+			}
+		}
+	}
+
+	ulCyclesPerMs = SystemCoreClock / 1000UL;
+	/* Complement of the IDLE row, so both add up to 100 %. */
+	ulPerMille = ( ullIdle >= ullWindow ) ? 0UL : ( 1000UL - ( uint32_t )( ( ullIdle * 1000ULL ) / ullWindow ) );
+	snprintf( cLine, sizeof( cLine ), pcTextForRunStats_Header,
+			  ( unsigned long )( ullWindow / ulCyclesPerMs ),
+			  ( unsigned long )( ulPerMille / 10UL ), ( unsigned long )( ulPerMille % 10UL ),
+			  ( unsigned long )( ullRunStatsClock / ( ulCyclesPerMs * 1000ULL ) ) );
+	prvRunStatsPrintLine( cLine );
+
+	snprintf( cLine, sizeof( cLine ), pcTextForRunStats_Heap,
+			  ( unsigned long ) xRunStatsHeap.xAvailableHeapSpaceInBytes,
+			  ( unsigned long ) configTOTAL_HEAP_SIZE,
+			  ( unsigned long ) xRunStatsHeap.xMinimumEverFreeBytesRemaining,
+			  ( unsigned long ) xRunStatsHeap.xNumberOfSuccessfulAllocations,
+			  ( unsigned long ) xRunStatsHeap.xNumberOfSuccessfulFrees );
+	prvRunStatsPrintLine( cLine );
+
+	ulPerMille = prvRunStatsFragmentation( &xRunStatsHeap );
+	snprintf( cLine, sizeof( cLine ), pcTextForRunStats_Frag,
+			  ( unsigned long ) xRunStatsHeap.xSizeOfLargestFreeBlockInBytes,
+			  ( unsigned long ) xRunStatsMinLargest,
+			  ( unsigned long ) xRunStatsHeap.xNumberOfFreeBlocks,
+			  ( unsigned long )( ulPerMille / 10UL ), ( unsigned long )( ulPerMille % 10UL ),
+			  ( unsigned long )( ulRunStatsMaxFrag / 10UL ), ( unsigned long )( ulRunStatsMaxFrag % 10UL ) );
+	prvRunStatsPrintLine( cLine );
+
+	for( i = 0; i < runSTATS_MAX_TASKS; i++ )
+	{
+		if( xRunStatsTask[ i ].xHandle == NULL )
+		{
+			continue;
+		}
+
+		ullTask = 0;
+		for( j = 0; j < runSTATS_WINDOW_SAMPLES; j++ )
+		{
+			ullTask += xRunStatsTask[ i ].ulSample[ j ];
+		}
+		ulPerMille = ( uint32_t )( ( ullTask * 1000ULL ) / ullWindow );
+
+		snprintf( cLine, sizeof( cLine ), pcTextForRunStats_Row,
+				  xRunStatsTask[ i ].cName,
+				  ( unsigned long )( ulPerMille / 10UL ), ( unsigned long )( ulPerMille % 10UL ),
+				  ( unsigned long ) ullTask,
+				  ( unsigned long )( xRunStatsTask[ i ].ullTotal / 1000000ULL ),
+				  ( unsigned long ) xRunStatsTask[ i ].usStackFree,
+				  ( xRunStatsTask[ i ].usStackFree < runSTATS_STACK_LOW_WORDS ) ? " <- low" : "" );
+		prvRunStatsPrintLine( cLine );
+	}
+}
+
+/*------------------------------------------------------------------*/
+static void prvRunStatsPrintLine( const char *pcLine )
+{
+	vPrintString( pcLine );
+	vTaskDelay( runSTATS_REPORT_LINE_TICKS );
+}
+
+#endif
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vRunStatsStart( void )
+{
+#if( runSTATS_ENABLE == 1 )
+	BaseType_t ret;
+
+	/* Statistics thread at low priority, its own time shows in the report. */
+	ret = xTaskCreate( prvRunStatsTask,				/* Pointer to the function thats implement the task. */
+					   "Task Stats",				/* Text name for the task. This is to facilitate debugging only. */
+					   runSTATS_STACK_SIZE,			/* Stack depth in words. 				*/
+					   NULL,						/* We are not using the task parameter.		*/
+					   runSTATS_TASK_PRIORITY,		/* This task will run at low priority. 		*/
+					   NULL );						/* We are not using the task handle.		*/
+
+	/* Check the task was created successfully. */
+	configASSERT( ret == pdPASS );
+#endif
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
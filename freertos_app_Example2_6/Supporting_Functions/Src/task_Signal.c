@@ -0,0 +1,330 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+
+/*--------------------------------------------------------------------*-
+
+    task_Signal.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    Task signal for FreeRTOS - Event Driven System (EDS) - Project for
+    STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Demo includes. */
+#include "task_Signal.h"
+
+// ------ Macros and definitions ---------------------------------------
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+#if( taskSIGNAL_NOTIFY == 1 )
+static BaseType_t prvTaskSignalTryGive( TaskSignal_t *pxSignal );
+static BaseType_t prvTaskSignalTryTake( TaskSignal_t *pxSignal );
+#endif
+
+// ------ internal data definition -------------------------------------
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+#if( taskSIGNAL_NOTIFY == 1 )
+/*------------------------------------------------------------------*/
+/* Count a give if the signal is not full */
+static BaseType_t prvTaskSignalTryGive( TaskSignal_t *pxSignal )
+{
+#if( taskSIGNAL_ATOMIC == 1 )
+	UBaseType_t uxCount = atomic_load_explicit( &pxSignal->uxCount, memory_order_relaxed );
+
+	/* A failed compare and swap reloads uxCount: check it again. */
+	do
+	{
+		if( uxCount >= pxSignal->uxMaxCount )
+		{
+			return pdFAIL;
+		}
+	} while( !atomic_compare_exchange_weak_explicit( &pxSignal->uxCount, &uxCount, uxCount + 1,
+													 memory_order_acq_rel, memory_order_relaxed ) );
+
+	return pdPASS;
+#else
+	BaseType_t xResult = pdFAIL;
+
+	taskENTER_CRITICAL();
+	{
+		if( pxSignal->uxCount < pxSignal->uxMaxCount )
+		{
+			pxSignal->uxCount++;
+			xResult = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xResult;
+#endif
+}
+
+/*------------------------------------------------------------------*/
+/* Take a counted give, if there is one */
+static BaseType_t prvTaskSignalTryTake( TaskSignal_t *pxSignal )
+{
+#if( taskSIGNAL_ATOMIC == 1 )
+	UBaseType_t uxCount = atomic_load_explicit( &pxSignal->uxCount, memory_order_relaxed );
+
+	do
+	{
+		if( uxCount == 0 )
+		{
+			return pdFAIL;
+		}
+	} while( !atomic_compare_exchange_weak_explicit( &pxSignal->uxCount, &uxCount, uxCount - 1,
+													 memory_order_acq_rel, memory_order_relaxed ) );
+
+	return pdPASS;
+#else
+	BaseType_t xResult = pdFAIL;
+
+	taskENTER_CRITICAL();
+	{
+		if( pxSignal->uxCount > 0 )
+		{
+			pxSignal->uxCount--;
+			xResult = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xResult;
+#endif
+}
+#endif
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vTaskSignalCreate( TaskSignal_t *pxSignal, UBaseType_t uxMaxCount, TaskHandle_t *pxOwner, const char *pcName )
+{
+	configASSERT( uxMaxCount > 0 );
+
+#if( taskSIGNAL_NOTIFY == 1 )
+	configASSERT( pxOwner != NULL );
+	( void ) pcName;
+
+	pxSignal->pxOwner = pxOwner;
+	pxSignal->uxMaxCount = uxMaxCount;
+#if( taskSIGNAL_ATOMIC == 1 )
+	atomic_init( &pxSignal->uxCount, 0 );
+#else
+	pxSignal->uxCount = 0;
+#endif
+#else
+	( void ) pxOwner;
+
+	/* Created empty, as a queue set member must be. */
+	pxSignal->xSemaphore = ( uxMaxCount == 1 ) ? xSemaphoreCreateBinary() : xSemaphoreCreateCounting( uxMaxCount, 0 );
+	configASSERT( pxSignal->xSemaphore != NULL );
+
+	vQueueAddToRegistry( pxSignal->xSemaphore, pcName );
+#endif
+}
+
+/*------------------------------------------------------------------*/
+BaseType_t xTaskSignalGive( TaskSignal_t *pxSignal )
+{
+#if( taskSIGNAL_NOTIFY == 1 )
+	if( prvTaskSignalTryGive( pxSignal ) == pdFAIL )
+	{
+		return pdFAIL;
+	}
+
+	/* The owner checks the count before it waits, so a give before the
+	 * task is created only needs the count. */
+	if( *pxSignal->pxOwner != NULL )
+	{
+		xTaskNotify( *pxSignal->pxOwner, taskSIGNAL_BIT, eSetBits );
+	}
+
+	return pdPASS;
+#else
+	return xSemaphoreGive( pxSignal->xSemaphore );
+#endif
+}
+
+/*------------------------------------------------------------------*/
+BaseType_t xTaskSignalTake( TaskSignal_t *pxSignal, TickType_t xTicksToWait )
+{
+#if( taskSIGNAL_NOTIFY == 1 )
+	TimeOut_t xTimeOut;
+
+	if( prvTaskSignalTryTake( pxSignal ) == pdPASS )
+	{
+		return pdPASS;
+	}
+	vTaskSetTimeOutState( &xTimeOut );
+
+	/* A wake up may be left over from a give already taken, or be for
+	 * another signal of this task: check the count again each time. */
+	while( prvTaskSignalTryTake( pxSignal ) == pdFAIL )
+	{
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			return pdFAIL;
+		}
+		( void ) xTaskNotifyWait( 0, taskSIGNAL_BIT, NULL, xTicksToWait );
+	}
+
+	return pdPASS;
+#else
+	return xSemaphoreTake( pxSignal->xSemaphore, xTicksToWait );
+#endif
+}
+
+/*------------------------------------------------------------------*/
+UBaseType_t uxTaskSignalCount( TaskSignal_t *pxSignal )
+{
+#if( ( taskSIGNAL_NOTIFY == 1 ) && ( taskSIGNAL_ATOMIC == 1 ) )
+	return atomic_load_explicit( &pxSignal->uxCount, memory_order_relaxed );
+#elif( taskSIGNAL_NOTIFY == 1 )
+	return pxSignal->uxCount;
+#else
+	return uxSemaphoreGetCount( pxSignal->xSemaphore );
+#endif
+}
+
+#if( ( taskSIGNAL_NOTIFY == 1 ) || ( configUSE_QUEUE_SETS == 1 ) )
+/*------------------------------------------------------------------*/
+void vTaskSignalSetCreate( TaskSignalSet_t *pxSet, TaskSignal_t *pxSignals, UBaseType_t uxSignals, const char *pcName )
+{
+	configASSERT( uxSignals > 0 );
+
+	pxSet->pxSignals = pxSignals;
+	pxSet->uxSignals = uxSignals;
+
+#if( taskSIGNAL_NOTIFY == 1 )
+	( void ) pcName;
+#else
+	UBaseType_t uxLength = 0, ux;
+
+	/* One item for each give the members can hold, they are empty. */
+	for( ux = 0; ux < uxSignals; ux++ )
+	{
+		uxLength += uxQueueSpacesAvailable( pxSignals[ ux ].xSemaphore );
+	}
+
+	pxSet->xQueueSet = xQueueCreateSet( uxLength );
+	configASSERT( pxSet->xQueueSet != NULL );
+
+	for( ux = 0; ux < uxSignals; ux++ )
+	{
+#if( configUSE_TRACE_FACILITY == 1 )
+		/* The queue number finds the index in O(1). */
+		vQueueSetQueueNumber( pxSignals[ ux ].xSemaphore, ux );
+#endif
+		xQueueAddToSet( pxSignals[ ux ].xSemaphore, pxSet->xQueueSet );
+	}
+	vQueueAddToRegistry( pxSet->xQueueSet, pcName );
+#endif
+}
+
+/*------------------------------------------------------------------*/
+BaseType_t xTaskSignalSelect( TaskSignalSet_t *pxSet, TickType_t xTicksToWait )
+{
+	UBaseType_t ux;
+
+#if( taskSIGNAL_NOTIFY == 1 )
+	TimeOut_t xTimeOut;
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		for( ux = 0; ux < pxSet->uxSignals; ux++ )
+		{
+			if( prvTaskSignalTryTake( &pxSet->pxSignals[ ux ] ) == pdPASS )
+			{
+				return ( BaseType_t ) ux;
+			}
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			return -1;
+		}
+		( void ) xTaskNotifyWait( 0, taskSIGNAL_BIT, NULL, xTicksToWait );
+	}
+#else
+	QueueSetMemberHandle_t xMember = xQueueSelectFromSet( pxSet->xQueueSet, xTicksToWait );
+
+	if( xMember == NULL )
+	{
+		return -1;
+	}
+
+	/* Only the owner takes the members, the take can not fail. */
+	( void ) xSemaphoreTake( ( SemaphoreHandle_t ) xMember, 0 );
+
+#if( configUSE_TRACE_FACILITY == 1 )
+	ux = uxQueueGetQueueNumber( ( QueueHandle_t ) xMember );
+#else
+	for( ux = 0; ux < pxSet->uxSignals; ux++ )
+	{
+		if( pxSet->pxSignals[ ux ].xSemaphore == ( SemaphoreHandle_t ) xMember )
+		{
+			break;
+		}
+	}
+#endif
+	configASSERT( ux < pxSet->uxSignals );
+
+	return ( BaseType_t ) ux;
+#endif
+}
+#endif
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
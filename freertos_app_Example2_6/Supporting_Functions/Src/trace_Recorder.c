@@ -0,0 +1,196 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+/*--------------------------------------------------------------------*-
+
+    trace_Recorder.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    Scheduler trace recorder for FreeRTOS - Event Driven System (EDS) -
+    Project for STM32F429ZI_NUCLEO_144.
+
+    The events are written inline by the trace macros (see
+    trace_Recorder.h); this file keeps the table of named objects that
+    lets the converter print task and queue names instead of addresses.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <string.h>
+
+/* Demo includes. */
+#include "cycle_Counter.h"
+#include "trace_Recorder.h"
+
+// ------ Macros and definitions ---------------------------------------
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+#if( traceRECORDER_ENABLE == 1 )
+static void prvTraceRecorderInit( void );
+#endif
+
+// ------ internal data definition -------------------------------------
+
+// ------ external data definition -------------------------------------
+#if( traceRECORDER_ENABLE == 1 )
+TraceBuffer_t xTraceBuffer;
+#endif
+
+// ------ internal functions definition --------------------------------
+
+#if( traceRECORDER_ENABLE == 1 )
+/*------------------------------------------------------------------*/
+static void prvTraceRecorderInit( void )
+{
+	vCycleCounterInit();
+
+	xTraceBuffer.ulCoreClock = SystemCoreClock;
+	xTraceBuffer.ulEventCount = traceRECORDER_EVENT_COUNT;
+	xTraceBuffer.ulObjectCount = traceRECORDER_OBJECT_COUNT;
+	xTraceBuffer.ulMagic = traceRECORDER_MAGIC;
+	xTraceBuffer.ulRecording = 1UL;
+}
+#endif
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vTraceRecorderObject( uint32_t ulKind, const void *pvHandle, const char *pcName )
+{
+#if( traceRECORDER_ENABLE == 1 )
+	uint32_t ulHandle = ( uint32_t )( uintptr_t ) pvHandle;
+	TraceObject_t *pxObject = NULL;
+	uint32_t i;
+
+	/* Task creation already runs in a critical section, queue creation
+	 * and the registry do not. */
+	taskENTER_CRITICAL();
+	{
+		if( xTraceBuffer.ulMagic != traceRECORDER_MAGIC )
+		{
+			prvTraceRecorderInit();
+		}
+
+		for( i = 0; i < xTraceBuffer.ulObjectsUsed; i++ )
+		{
+			if( xTraceBuffer.xObject[ i ].ulHandle == ulHandle )
+			{
+				pxObject = &xTraceBuffer.xObject[ i ];
+				break;
+			}
+		}
+
+		if( pxObject == NULL )
+		{
+			if( xTraceBuffer.ulObjectsUsed < traceRECORDER_OBJECT_COUNT )
+			{
+				pxObject = &xTraceBuffer.xObject[ xTraceBuffer.ulObjectsUsed++ ];
+				pxObject->ulHandle = ulHandle;
+				pxObject->ulKind = ulKind;
+			}
+			else
+			{
+				xTraceBuffer.ulObjectsLost++;
+			}
+		}
+		else if( ( ulKind == eTraceTask ) || ( pcName == NULL ) )
+		{
+			/* A new object at the address of a deleted one. A registry
+			 * entry only names the queue, it keeps its kind. */
+			pxObject->ulKind = ulKind;
+		}
+
+		if( pxObject != NULL )
+		{
+			memset( pxObject->cName, 0, sizeof( pxObject->cName ) );
+			if( pcName != NULL )
+			{
+				strncpy( pxObject->cName, pcName, sizeof( pxObject->cName ) - 1 );
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+#else
+	( void ) ulKind;
+	( void ) pvHandle;
+	( void ) pcName;
+#endif
+}
+
+/*------------------------------------------------------------------*/
+void vTraceRecorderStop( void )
+{
+#if( traceRECORDER_ENABLE == 1 )
+	xTraceBuffer.ulRecording = 0UL;
+#endif
+}
+
+/*------------------------------------------------------------------*/
+void vTraceRecorderStart( void )
+{
+#if( traceRECORDER_ENABLE == 1 )
+	if( xTraceBuffer.ulMagic == traceRECORDER_MAGIC )
+	{
+		xTraceBuffer.ulRecording = 1UL;
+	}
+#endif
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulTraceRecorderGet( const void **ppvBuffer )
+{
+#if( traceRECORDER_ENABLE == 1 )
+	*ppvBuffer = &xTraceBuffer;
+	return ( uint32_t ) sizeof( xTraceBuffer );
+#else
+	*ppvBuffer = NULL;
+	return 0;
+#endif
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
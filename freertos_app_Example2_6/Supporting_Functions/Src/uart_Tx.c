@@ -0,0 +1,333 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example2_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    uart_Tx.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    USART3 transmit engine for FreeRTOS - Event Driven System (EDS) -
+    Project for STM32F429ZI_NUCLEO_144.
+
+    Two half buffers: writers fill one while DMA1 Stream3 (channel 4,
+    USART3_TX) sends the other. The transfer complete callback starts
+    the next half and wakes every writer waiting for room, so a task only
+    blocks when both halves are full. Writers wait on a counting
+    semaphore of their own, not on their task notification, which the
+    log drain task keeps for its log wake ups.
+
+    Where blocking is not possible (before the scheduler starts, inside
+    an interrupt or a critical section) the writer polls the DMA and
+    UART interrupt handlers instead of waiting for them to run.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <string.h>
+
+/* Demo includes. */
+#include "uart_Tx.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define uartTX_DMA_STREAM		DMA1_Stream3
+#define uartTX_DMA_CHANNEL		DMA_CHANNEL_4
+#define uartTX_DMA_IRQn			DMA1_Stream3_IRQn
+
+/* Both interrupts call FromISR APIs. */
+#define uartTX_IRQ_PRIORITY		configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+#if( uartTX_USE_DMA == 1 )
+static void prvUartTxStart( void );
+static BaseType_t prvUartTxCanBlock( void );
+static void prvUartTxPoll( void );
+#endif
+
+// ------ internal data definition -------------------------------------
+#if( uartTX_USE_DMA == 1 )
+static uint8_t ucUartTxBuffer[ 2 ][ uartTX_HALF_SIZE ];
+static volatile uint16_t usUartTxFill[ 2 ];
+
+/* Half being filled by writers; the other one may be in flight. */
+static volatile uint8_t ucUartTxFilling;
+static volatile uint8_t ucUartTxBusy;
+static uint8_t ucUartTxReady;
+
+/* Writers waiting for room, each one takes a give of xUartTxRoom. */
+static SemaphoreHandle_t xUartTxRoom = NULL;
+static volatile UBaseType_t uxUartTxWaiters;
+#endif
+
+static UartTxStats_t xUartTxStats;
+
+// ------ external data definition -------------------------------------
+extern UART_HandleTypeDef huart3;
+
+DMA_HandleTypeDef hdma_usart3_tx;
+
+// ------ internal functions definition --------------------------------
+#if( uartTX_USE_DMA == 1 )
+
+/*------------------------------------------------------------------*/
+static void prvUartTxStart( void )
+{
+	/* Called with the engine locked (critical section or ISR) and the DMA
+	 * idle: send the half being filled and switch writers to the other. */
+	uint8_t ucHalf = ucUartTxFilling;
+
+	if( usUartTxFill[ ucHalf ] == 0 )
+	{
+		return;
+	}
+
+	ucUartTxBusy = 1;
+	ucUartTxFilling = ucHalf ^ 1;
+	usUartTxFill[ ucHalf ^ 1 ] = 0;
+	xUartTxStats.ulTransfers++;
+
+	if( HAL_UART_Transmit_DMA( &huart3, ucUartTxBuffer[ ucHalf ], usUartTxFill[ ucHalf ] ) != HAL_OK )
+	{
+		ucUartTxBusy = 0;
+		xUartTxStats.ulErrors++;
+	}
+}
+
+/*------------------------------------------------------------------*/
+static BaseType_t prvUartTxCanBlock( void )
+{
+	return ( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING ) &&
+		   ( xPortIsInsideInterrupt() == pdFALSE ) &&
+		   ( __get_BASEPRI() == 0 ) && ( __get_PRIMASK() == 0 );
+}
+
+/*------------------------------------------------------------------*/
+static void prvUartTxPoll( void )
+{
+	/* Interrupts cannot run here: serve the pending flags by hand, masked
+	 * so the real handlers cannot run at the same time. */
+	UBaseType_t uxSaved = taskENTER_CRITICAL_FROM_ISR();
+	{
+		HAL_DMA_IRQHandler( &hdma_usart3_tx );
+		HAL_UART_IRQHandler( &huart3 );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSaved );
+}
+
+#endif
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vUartTxInit( void )
+{
+#if( uartTX_USE_DMA == 1 )
+	__HAL_RCC_DMA1_CLK_ENABLE();
+
+	hdma_usart3_tx.Instance = uartTX_DMA_STREAM;
+	hdma_usart3_tx.Init.Channel = uartTX_DMA_CHANNEL;
+	hdma_usart3_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	hdma_usart3_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdma_usart3_tx.Init.MemInc = DMA_MINC_ENABLE;
+	hdma_usart3_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdma_usart3_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hdma_usart3_tx.Init.Mode = DMA_NORMAL;
+	hdma_usart3_tx.Init.Priority = DMA_PRIORITY_LOW;
+	hdma_usart3_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+	if( HAL_DMA_Init( &hdma_usart3_tx ) != HAL_OK )
+	{
+		Error_Handler();
+	}
+	__HAL_LINKDMA( &huart3, hdmatx, hdma_usart3_tx );
+
+	HAL_NVIC_SetPriority( uartTX_DMA_IRQn, uartTX_IRQ_PRIORITY, 0 );
+	HAL_NVIC_EnableIRQ( uartTX_DMA_IRQn );
+	HAL_NVIC_SetPriority( USART3_IRQn, uartTX_IRQ_PRIORITY, 0 );
+	HAL_NVIC_EnableIRQ( USART3_IRQn );
+
+	xUartTxRoom = xSemaphoreCreateCounting( uartTX_WAITERS, 0 );
+	configASSERT( xUartTxRoom != NULL );
+
+	ucUartTxReady = 1;
+#endif
+}
+
+/*------------------------------------------------------------------*/
+size_t xUartTxWrite( const char *pcData, size_t xLength )
+{
+#if( uartTX_USE_DMA == 1 )
+	size_t xLeft = xLength;
+	size_t xCopy;
+	uint8_t ucHalf;
+	BaseType_t xWait;
+	BaseType_t xCanBlock;
+
+	if( ucUartTxReady == 0 )
+	{
+		/* DMA not set up yet. */
+		HAL_UART_Transmit( &huart3, ( uint8_t * ) pcData, ( uint16_t ) xLength, 0xFFFF );
+		xUartTxStats.ulBytes += xLength;
+		return xLength;
+	}
+
+	/* Checked out of the critical section below, which masks interrupts. */
+	xCanBlock = prvUartTxCanBlock();
+
+	while( xLeft > 0 )
+	{
+		/* The FROM_ISR form nests, so writes are also safe from interrupts
+		 * and from inside critical sections. */
+		UBaseType_t uxSaved = taskENTER_CRITICAL_FROM_ISR();
+		{
+			xWait = pdFALSE;
+			ucHalf = ucUartTxFilling;
+			xCopy = uartTX_HALF_SIZE - usUartTxFill[ ucHalf ];
+			if( xCopy > xLeft )
+			{
+				xCopy = xLeft;
+			}
+			memcpy( &ucUartTxBuffer[ ucHalf ][ usUartTxFill[ ucHalf ] ], pcData, xCopy );
+			usUartTxFill[ ucHalf ] += xCopy;
+			pcData += xCopy;
+			xLeft -= xCopy;
+
+			if( ucUartTxBusy == 0 )
+			{
+				prvUartTxStart();
+			}
+			else if( ( xLeft > 0 ) && ( xCanBlock != pdFALSE ) )
+			{
+				/* Both halves full, sleep until the transfer completes. */
+				uxUartTxWaiters++;
+				xWait = pdTRUE;
+			}
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSaved );
+
+		if( xWait != pdFALSE )
+		{
+			/* A give left over by a writer that timed out only costs one
+			 * more pass of the loop. */
+			xUartTxStats.ulBlocked++;
+			xSemaphoreTake( xUartTxRoom, uartTX_WAIT_TICKS );
+		}
+		else if( ( xLeft > 0 ) && ( ucUartTxBusy != 0 ) && ( xCanBlock == pdFALSE ) )
+		{
+			prvUartTxPoll();
+		}
+	}
+
+	xUartTxStats.ulBytes += xLength;
+	return xLength;
+#else
+	HAL_UART_Transmit( &huart3, ( uint8_t * ) pcData, ( uint16_t ) xLength, 0xFFFF );
+	xUartTxStats.ulBytes += xLength;
+	return xLength;
+#endif
+}
+
+/*------------------------------------------------------------------*/
+void vUartTxGetStats( UartTxStats_t *pxStats )
+{
+	*pxStats = xUartTxStats;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulUartTxIdle( void )
+{
+#if( uartTX_USE_DMA == 1 )
+	/* The complete callback runs once the last byte has left the shift
+	 * register, and any data written meanwhile starts a new transfer. */
+	return ( ucUartTxBusy == 0 ) ? 1UL : 0UL;
+#else
+	/* HAL_UART_Transmit() returns once the transfer is complete. */
+	return 1UL;
+#endif
+}
+
+#if( uartTX_USE_DMA == 1 )
+/*------------------------------------------------------------------*/
+void HAL_UART_TxCpltCallback( UART_HandleTypeDef *huart )
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if( huart->Instance != USART3 )
+	{
+		return;
+	}
+
+	/* The half just sent is free again; send the other one if it has data. */
+	ucUartTxBusy = 0;
+	prvUartTxStart();
+
+	/* Wake every writer waiting for room, past uartTX_WAITERS the give
+	 * fails and the writer wakes up on its timeout. */
+	while( uxUartTxWaiters > 0 )
+	{
+		uxUartTxWaiters--;
+		xSemaphoreGiveFromISR( xUartTxRoom, &xHigherPriorityTaskWoken );
+	}
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+
+/*------------------------------------------------------------------*/
+void HAL_UART_ErrorCallback( UART_HandleTypeDef *huart )
+{
+	if( huart->Instance != USART3 )
+	{
+		return;
+	}
+
+	xUartTxStats.ulErrors++;
+
+	/* Only a transfer the HAL has aborted frees the half. */
+	if( huart->gState == HAL_UART_STATE_READY )
+	{
+		HAL_UART_TxCpltCallback( huart );
+	}
+}
+#endif
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,99 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example3_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    led_Engine.h (Released 2022-10)
+
+  --------------------------------------------------------------------
+
+    This is the Led Engine Header file.
+
+    The LDX_Config entries blink from one software timer.
+
+    The leds wait in a list sorted by the tick of their next change,
+    the timer wheel. The timer expires at the head of the list; its
+    callback, on the timer service task, updates every led due by then
+    in one pass, puts each one back in order and sets the timer for the
+    new head. A led costs the timing and state fields of LDX_Config_t
+    rather than a task and its stack. The pins changed in one pass are
+    written together through a GPIO batch (gpio_Batch.h).
+
+    Each led blinks on a 32 step pattern: in a lit step (its bit set in
+    ledPattern) it is on for ledOn ticks of the ledPeriod ticks of the
+    step, in a dark step it stays off. The first step starts ledPhase
+    ticks after vLedEngineRun( true ). Each change is printed on the
+    console under the ledName of the led, as its Task X thread does.
+
+    With ledPWM_ENABLE (led_Pwm.h) a led lit in every step and with no
+    phase is a plain PWM output: it is handed to its hardware timer on
+    start and stays out of the wheel, so it costs no callback at all.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __LED_ENGINE_H
+#define __LED_ENGINE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+
+// ------ macros -------------------------------------------------------
+
+// ------ typedef ------------------------------------------------------
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Hand ulCount leds to the engine and create its timer, all off and
+ * stopped. Call it before the scheduler starts. */
+void vLedEngineInit( LDX_Config_t *pxLeds, uint32_t ulCount );
+
+/* Start the leds from step 0 of their pattern, or stop them and turn
+ * them off. Takes effect on the next tick. */
+void vLedEngineRun( bool bRun );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LED_ENGINE_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -52,20 +52,47 @@
 // ------ inclusions ---------------------------------------------------
 
 // ------ macros -------------------------------------------------------
+/* 1: the Task Button thread blocks until the USER_Btn driver has an event
+ * (button_Event.h), so it does not wake up while the button is idle.
+ * 0: the original loop that polls the button. */
+#ifndef TASK_BUTTON_EVENT_DRIVEN
+	#define TASK_BUTTON_EVENT_DRIVEN	1
+#endif
+
+/* 1: the leds blink from the led engine (led_Engine.h), on the timer
+ * service task. 0: the original Task 1, 2 and 3, one per led. */
+#ifndef TASK_LED_ENGINE
+	#define TASK_LED_ENGINE				1
+#endif
+
+/* Entries of LDX_Config */
+#define LDX_NUM		3
 
 // ------ typedef ------------------------------------------------------
 
 // ------ external data declaration ------------------------------------
 typedef enum	ledFlag_e{ Blinking, NotBlinking } ledFlag_t;
 
-typedef struct
+typedef struct LDX_Config_s
 {
 	GPIO_TypeDef*	LDX_GPIO_Port;
 	uint16_t		LDX_Pin;
 	GPIO_PinState	ledState;
+	const char		*ledName;		/* Console name, as its Task X thread		*/
+
+	/* Blink timing for the led engine, in ticks */
+	uint16_t		ledPeriod;		/* Length of a pattern step 				*/
+	uint16_t		ledPhase;		/* Delay of the first step from the start	*/
+	uint16_t		ledOn;			/* Lit time of a lit step (duty)			*/
+	uint32_t		ledPattern;		/* Lit steps, bit 0 first, 32 step cycle	*/
+
+	/* Led engine state */
+	uint8_t			ledStep;		/* Pattern step the next change is in		*/
+	TickType_t		ledDue;			/* Tick of the next change					*/
+	struct LDX_Config_s *ledNext;	/* Next led due, in the engine wheel		*/
 } LDX_Config_t;
 
-extern LDX_Config_t LDX_Config[];
+extern LDX_Config_t LDX_Config[ LDX_NUM ];
 
 // ------ external functions declaration -------------------------------
 
@@ -59,10 +59,14 @@
 
 /* Demo includes. */
 #include "supporting_Functions.h"
+#include "led_Pwm.h"
 
 /* Application & Tasks includes. */
 #include "app.h"
 #include "task_Function.h"
+#include "button_Event.h"
+#include "led_Engine.h"
+#include "led_Bench.h"
 
 // ------ Macros and definitions ---------------------------------------
 
@@ -90,12 +94,27 @@ const char *pcTextForMain = "freertos_app_Example3_6 is running: PO (3 de 6)\r\n
 /* App Initialization */
 void appInit( void )
 {
+#if( TASK_LED_ENGINE == 0 )
 	LDX_Config_t* ptr;
+#endif
 	BaseType_t ret;
 
 	/* Print out the name of this Example. */
   	vPrintString( pcTextForMain );
 
+#if( TASK_BUTTON_EVENT_DRIVEN == 1 )
+	/* USER_Btn events, before the Task Button thread waits on them */
+	vButtonInit();
+#endif
+
+#if( TASK_LED_ENGINE == 1 )
+	/* The three leds on the timer service task, instead of Task 1, 2 and 3 */
+	vLedEngineInit( LDX_Config, LDX_NUM );
+#if( ledPWM_ENABLE == 1 )
+	/* Leds lit in every step blinked by their timers */
+	vLedPwmInit();
+#endif
+#else
 	ptr = &LDX_Config[0];
 	/* Task 1 thread at priority 1 */
 	ret = xTaskCreate( vTaskLed,					/* Pointer to the function thats implement the task. */
@@ -131,6 +150,7 @@ void appInit( void )
 
 	/* Check the task was created successfully. */
 	configASSERT( ret == pdPASS );
+#endif
 
 	/* Task 3 thread at priority 1 */
 	ret = xTaskCreate( vTaskButton,					/* Pointer to the function thats implement the task. */
@@ -142,6 +162,11 @@ void appInit( void )
 
 	/* Check the task was created successfully. */
 	configASSERT( ret == pdPASS );
+
+#if( LED_BENCHMARK == 1 )
+	/* Task Bench measures the led group writes once */
+	vLedBenchStart();
+#endif
 }
 
 /*------------------------------------------------------------------*-
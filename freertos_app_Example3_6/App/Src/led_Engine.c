@@ -0,0 +1,299 @@
+/* Copyright 2020, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example3_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+/*--------------------------------------------------------------------*-
+
+    led_Engine.c (Released 2022-10)
+
+--------------------------------------------------------------------
+
+    Led engine for FreeRTOS - Event Driven System (EDS) - Project for
+    STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <stdbool.h>
+
+/* Demo includes. */
+#include "supporting_Functions.h"
+#include "led_Pwm.h"
+#include "gpio_Batch.h"
+
+/* Application includes. */
+#include "task_Function.h"
+#include "led_Engine.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define ledENGINE_TICK_US		( portTICK_PERIOD_MS * 1000UL )
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+static void prvLedEngineCallback( TimerHandle_t xTimer );
+static void prvLedEngineInsert( LDX_Config_t *pxLed, TickType_t xNow );
+static void prvLedEngineUpdate( LDX_Config_t *pxLed, GpioBatch_t *pxBatch );
+static void prvLedEngineStart( TickType_t xNow );
+static void prvLedEngineStop( void );
+#if( ledPWM_ENABLE == 1 )
+static bool prvLedEnginePwm( const LDX_Config_t *pxLed );
+#endif
+
+// ------ internal data definition -------------------------------------
+/* Define the strings that will be passed in as the Supporting Functions parameters.
+ * These are defined const and off the stack to ensure they remain valid when the
+ * tasks are executing. */
+const char *pcTextForLedEngine_LDXTOn	= " - LDX turn On \r\n";
+const char *pcTextForLedEngine_LDXTOff	= " - LDX turn Off\r\n";
+
+static LDX_Config_t *pxLedEngineLeds;
+static uint32_t ulLedEngineCount;
+static TimerHandle_t xLedEngineTimer;
+
+/* Head of the wheel, the led due first. Only used from the callback. */
+static LDX_Config_t *pxLedEngineHead = NULL;
+static bool bLedEngineRunning = false;
+
+/* Asked by vLedEngineRun(), done by the callback. */
+static volatile bool bLedEngineRun = false;
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+/* Put a led in the wheel, after the leds due before or with it. The
+ * ticks are compared as a signed distance from xNow, right across a
+ * wrap and for a led that is late. */
+static void prvLedEngineInsert( LDX_Config_t *pxLed, TickType_t xNow )
+{
+	LDX_Config_t **ppxNext = &pxLedEngineHead;
+	int32_t lDistance = ( int32_t )( pxLed->ledDue - xNow );
+
+	while( ( *ppxNext != NULL ) && ( ( int32_t )( ( *ppxNext )->ledDue - xNow ) <= lDistance ) )
+	{
+		ppxNext = &( *ppxNext )->ledNext;
+	}
+	pxLed->ledNext = *ppxNext;
+	*ppxNext = pxLed;
+}
+
+/*------------------------------------------------------------------*/
+/* The led is due: set its pin in the batch for the step, or for the end
+ * of the lit time, and move ledDue to its next change. */
+static void prvLedEngineUpdate( LDX_Config_t *pxLed, GpioBatch_t *pxBatch )
+{
+	bool bLit = ( ( pxLed->ledPattern >> pxLed->ledStep ) & 1UL ) != 0;
+	GPIO_PinState xLastState = pxLed->ledState;
+
+	if( ( pxLed->ledState == GPIO_PIN_SET ) && ( pxLed->ledOn < pxLed->ledPeriod ) )
+	{
+		/* End of the lit time, off for the rest of the step */
+		pxLed->ledState = GPIO_PIN_RESET;
+		pxLed->ledDue += pxLed->ledPeriod - pxLed->ledOn;
+		pxLed->ledStep = ( pxLed->ledStep + 1U ) % 32U;
+	}
+	else if( bLit && ( pxLed->ledOn > 0 ) && ( pxLed->ledOn < pxLed->ledPeriod ) )
+	{
+		/* Start of a lit step, the end of its lit time is due next */
+		pxLed->ledState = GPIO_PIN_SET;
+		pxLed->ledDue += pxLed->ledOn;
+	}
+	else
+	{
+		/* Start of a dark step, or of a step lit all along */
+		pxLed->ledState = ( bLit && ( pxLed->ledOn > 0 ) ) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+		pxLed->ledDue += pxLed->ledPeriod;
+		pxLed->ledStep = ( pxLed->ledStep + 1U ) % 32U;
+	}
+
+	/* Print the change, as its Task X thread does. The log is written
+	 * without blocking, so the timer service task may print it. */
+	if( pxLed->ledState != xLastState )
+	{
+		vPrintTwoStrings( pxLed->ledName, ( pxLed->ledState == GPIO_PIN_SET ) ? pcTextForLedEngine_LDXTOn : pcTextForLedEngine_LDXTOff );
+	}
+
+	vGpioBatchWrite( pxBatch, pxLed->LDX_GPIO_Port, pxLed->LDX_Pin, pxLed->ledState );
+}
+
+#if( ledPWM_ENABLE == 1 )
+/*------------------------------------------------------------------*/
+/* A led lit in every step from the start needs no wheel, its timer
+ * plays ledOn of every ledPeriod the same way. */
+static bool prvLedEnginePwm( const LDX_Config_t *pxLed )
+{
+	return ( pxLed->ledPattern == 0xFFFFFFFFUL ) && ( pxLed->ledPhase == 0 );
+}
+#endif
+
+/*------------------------------------------------------------------*/
+/* Every led off at step 0, its first step ledPhase ticks from now */
+static void prvLedEngineStart( TickType_t xNow )
+{
+	LDX_Config_t *pxLed;
+	uint32_t i;
+
+	pxLedEngineHead = NULL;
+	for( i = 0; i < ulLedEngineCount; i++ )
+	{
+		pxLed = &pxLedEngineLeds[ i ];
+		configASSERT( pxLed->ledPeriod > 0 );
+
+		pxLed->ledState = GPIO_PIN_RESET;
+		pxLed->ledStep = 0;
+#if( ledPWM_ENABLE == 1 )
+		if( prvLedEnginePwm( pxLed ) )
+		{
+			vLedPwmSet( pxLed->LDX_GPIO_Port, pxLed->LDX_Pin, pxLed->ledPeriod * ledENGINE_TICK_US, pxLed->ledOn * ledENGINE_TICK_US );
+			continue;
+		}
+#endif
+		pxLed->ledDue = xNow + pxLed->ledPhase;
+		prvLedEngineInsert( pxLed, xNow );
+	}
+	bLedEngineRunning = true;
+}
+
+/*------------------------------------------------------------------*/
+static void prvLedEngineStop( void )
+{
+	GpioBatch_t xBatch;
+	uint32_t i;
+
+	vGpioBatchInit( &xBatch );
+
+	for( i = 0; i < ulLedEngineCount; i++ )
+	{
+		pxLedEngineLeds[ i ].ledState = GPIO_PIN_RESET;
+#if( ledPWM_ENABLE == 1 )
+		if( prvLedEnginePwm( &pxLedEngineLeds[ i ] ) )
+		{
+			vLedPwmSet( pxLedEngineLeds[ i ].LDX_GPIO_Port, pxLedEngineLeds[ i ].LDX_Pin, pxLedEngineLeds[ i ].ledPeriod * ledENGINE_TICK_US, 0UL );
+			continue;
+		}
+#endif
+		vGpioBatchWrite( &xBatch, pxLedEngineLeds[ i ].LDX_GPIO_Port, pxLedEngineLeds[ i ].LDX_Pin, GPIO_PIN_RESET );
+	}
+	vGpioBatchCommit( &xBatch );
+	pxLedEngineHead = NULL;
+	bLedEngineRunning = false;
+}
+
+/*------------------------------------------------------------------*/
+/* Led engine timer callback, runs in the timer service task when the
+ * head of the wheel is due, or after vLedEngineRun() */
+static void prvLedEngineCallback( TimerHandle_t xTimer )
+{
+	TickType_t xNow = xTaskGetTickCount();
+	LDX_Config_t *pxLed;
+	GpioBatch_t xBatch;
+
+	if( bLedEngineRun != bLedEngineRunning )
+	{
+		if( bLedEngineRun )
+		{
+			prvLedEngineStart( xNow );
+		}
+		else
+		{
+			prvLedEngineStop();
+		}
+	}
+
+	/* Stopped, or every led on its hardware timer */
+	if( !bLedEngineRunning || ( pxLedEngineHead == NULL ) )
+	{
+		return;
+	}
+
+	/* Every led due by now, in one pass. One that is late keeps its
+	 * pattern and goes through its missed changes here. */
+	vGpioBatchInit( &xBatch );
+	while( ( int32_t )( xNow - pxLedEngineHead->ledDue ) >= 0 )
+	{
+		pxLed = pxLedEngineHead;
+		pxLedEngineHead = pxLed->ledNext;
+
+		prvLedEngineUpdate( pxLed, &xBatch );
+		prvLedEngineInsert( pxLed, xNow );
+	}
+
+	/* The leds of a port change together, with one store */
+	vGpioBatchCommit( &xBatch );
+
+	/* Commands from the timer service task must not block. */
+	( void ) xTimerChangePeriod( xTimer, pxLedEngineHead->ledDue - xNow, 0 );
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vLedEngineInit( LDX_Config_t *pxLeds, uint32_t ulCount )
+{
+	configASSERT( ( pxLeds != NULL ) && ( ulCount > 0 ) );
+
+	pxLedEngineLeds = pxLeds;
+	ulLedEngineCount = ulCount;
+
+	/* One shot, each callback sets the time to the next led due. */
+	xLedEngineTimer = xTimerCreate( "Led Engine", 1, pdFALSE, NULL, prvLedEngineCallback );
+	configASSERT( xLedEngineTimer != NULL );
+}
+
+/*------------------------------------------------------------------*/
+void vLedEngineRun( bool bRun )
+{
+	BaseType_t xResult;
+
+	bLedEngineRun = bRun;
+
+	/* The wheel belongs to the callback, let it start or stop the leds */
+	xResult = xTimerChangePeriod( xLedEngineTimer, 1, portMAX_DELAY );
+	configASSERT( xResult == pdPASS );
+	( void ) xResult;
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
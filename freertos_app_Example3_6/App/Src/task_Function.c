@@ -63,6 +63,8 @@
 /* Application includes. */
 #include "app_Resources.h"
 #include "task_Function.h"
+#include "button_Event.h"
+#include "led_Engine.h"
 
 // ------ Macros and definitions ---------------------------------------
 
@@ -88,9 +90,24 @@ const char *pcTextForTask_BlinkingOff	= " - Blinking turn Off\r\n";
 //uint16_t	  LDX_Pin[]			= { LD1_Pin,       LD2_Pin,       LD3_Pin };
 //GPIO_TypeDef* LDX_GPIO_Port[]	= { LD1_GPIO_Port, LD2_GPIO_Port, LD3_GPIO_Port };
 
-LDX_Config_t	LDX_Config[] 	= { { LD1_GPIO_Port, LD1_Pin, GPIO_PIN_RESET },
-							  	    { LD2_GPIO_Port, LD2_Pin, GPIO_PIN_RESET },
-									{ LD3_GPIO_Port, LD3_Pin, GPIO_PIN_RESET } };
+/* Led engine timing: every step lit for half of it, as the Task X loops
+ * that turn the led on and off every ledPeriodMS. The engine state
+ * fields start at zero and are set by vLedEngineRun(). */
+LDX_Config_t	LDX_Config[ LDX_NUM ] =
+{
+	{ .LDX_GPIO_Port = LD1_GPIO_Port, .LDX_Pin = LD1_Pin, .ledState = GPIO_PIN_RESET, .ledName = "Task 1",
+	  .ledPeriod = pdMS_TO_TICKS( 2 * ledPeriodMS ), .ledPhase = 0, .ledOn = pdMS_TO_TICKS( ledPeriodMS ),
+	  .ledPattern = 0xFFFFFFFFUL,
+	  .ledStep = 0, .ledDue = 0, .ledNext = NULL },
+	{ .LDX_GPIO_Port = LD2_GPIO_Port, .LDX_Pin = LD2_Pin, .ledState = GPIO_PIN_RESET, .ledName = "Task 2",
+	  .ledPeriod = pdMS_TO_TICKS( 2 * ledPeriodMS ), .ledPhase = 0, .ledOn = pdMS_TO_TICKS( ledPeriodMS ),
+	  .ledPattern = 0xFFFFFFFFUL,
+	  .ledStep = 0, .ledDue = 0, .ledNext = NULL },
+	{ .LDX_GPIO_Port = LD3_GPIO_Port, .LDX_Pin = LD3_Pin, .ledState = GPIO_PIN_RESET, .ledName = "Task 3",
+	  .ledPeriod = pdMS_TO_TICKS( 2 * ledPeriodMS ), .ledPhase = 0, .ledOn = pdMS_TO_TICKS( ledPeriodMS ),
+	  .ledPattern = 0xFFFFFFFFUL,
+	  .ledStep = 0, .ledDue = 0, .ledNext = NULL }
+};
 
 ledFlag_t ledFlag = NotBlinking;
 
@@ -144,8 +161,10 @@ void vTaskLed( void *pvParameters )
 /* Task for button de-bounce */
 void vTaskButton( void *pvParameters )
 {
+#if( TASK_BUTTON_EVENT_DRIVEN == 0 )
 	const TickType_t xDelayMS = pdMS_TO_TICKS( btnDebounceMS );
 	TickType_t xLastWakeTime = xTaskGetTickCount();
+#endif
 
 	char *pcTaskName = (char *) pcTaskGetName( NULL );
 	/* Print out the name of this task. */
@@ -153,8 +172,13 @@ void vTaskButton( void *pvParameters )
 
 	for ( ;; )
 	{
+#if( TASK_BUTTON_EVENT_DRIVEN == 1 )
+		/* Block until the button driver has a press, instead of spinning */
+		if( xButtonWaitPress( portMAX_DELAY ) )
+#else
 		/* Check HW Button State */
 		if( HAL_GPIO_ReadPin( USER_Btn_GPIO_Port, USER_Btn_Pin ) == GPIO_PIN_SET )
+#endif
 		{
 			/* Check, Update and Print Led Flag */
 			if( ledFlag == NotBlinking )
@@ -168,8 +192,15 @@ void vTaskButton( void *pvParameters )
 				vPrintTwoStrings( pcTaskName, pcTextForTask_BlinkingOff );
 			}
 
+#if( TASK_LED_ENGINE == 1 )
+			/* Start or stop the leds, there is no Task X to look at ledFlag */
+			vLedEngineRun( ledFlag == Blinking );
+#endif
+
+#if( TASK_BUTTON_EVENT_DRIVEN == 0 )
 			/* De-bounce delay */
 			vTaskDelayUntil(&xLastWakeTime, xDelayMS);
+#endif
 		}
 	}
 }
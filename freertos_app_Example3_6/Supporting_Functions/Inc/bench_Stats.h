@@ -0,0 +1,109 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example3_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    bench_Stats.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Benchmark Statistics Header file.
+
+    Fixed size latency histogram: each power of two is split in
+    2^benchHISTOGRAM_SUB_BITS buckets, so a sample is recorded in O(1)
+    without storing it, and percentiles are exact to within one bucket
+    (12.5 % with the default 3 bits). Min, max and mean are exact.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __BENCH_STATS_H
+#define __BENCH_STATS_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+
+// ------ macros -------------------------------------------------------
+/* Buckets per power of two, as a number of bits. */
+#ifndef benchHISTOGRAM_SUB_BITS
+	#define benchHISTOGRAM_SUB_BITS		3
+#endif
+
+/* Enough buckets for any 32 bit sample. */
+#define benchHISTOGRAM_BUCKETS			( ( 33 - benchHISTOGRAM_SUB_BITS ) << benchHISTOGRAM_SUB_BITS )
+
+/* Ticks to wait after each report line, so the console drain keeps up. */
+#ifndef benchREPORT_LINE_TICKS
+	#define benchREPORT_LINE_TICKS		pdMS_TO_TICKS( 10 )
+#endif
+
+// ------ typedef ------------------------------------------------------
+typedef struct
+{
+	uint32_t ulCount;
+	uint32_t ulMin;
+	uint32_t ulMax;
+	uint64_t ullSum;
+	uint32_t ulBucket[ benchHISTOGRAM_BUCKETS ];
+} BenchStats_t;
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+void vBenchStatsReset( BenchStats_t *pxStats );
+
+/* Record one sample. Not reentrant: one writer per BenchStats_t. */
+void vBenchStatsAdd( BenchStats_t *pxStats, uint32_t ulSample );
+
+/* Sample at the given rank, in per mille (500 = median, 990 = p99).
+ * Returns the top of the bucket, clamped to [min, max]. */
+uint32_t ulBenchStatsPercentile( const BenchStats_t *pxStats, uint32_t ulPerMille );
+
+/* Print a summary line followed by a histogram with one row per power of
+ * two, through vPrintString(). Blocks benchREPORT_LINE_TICKS per line. */
+void vBenchStatsPrint( const char *pcName, const char *pcUnit, const BenchStats_t *pxStats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BENCH_STATS_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,153 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example3_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    gpio_Batch.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the GPIO Batch Header file.
+
+    Pin writes gathered per port and committed with one BSRR store per
+    port: the pins of a port change at the same instant, and a group of
+    leds costs one store instead of a HAL_GPIO_WritePin() call each.
+
+    A batch lives on the stack of its user. Writes and toggles are
+    inline and only touch the batch; a toggle reads the output register
+    when it is added. The last write of a pin in a batch wins.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __GPIO_BATCH_H
+#define __GPIO_BATCH_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+
+// ------ macros -------------------------------------------------------
+/* Ports one batch may hold. LD1, LD2 and LD3 are all on GPIOB. */
+#ifndef gpioBATCH_PORTS
+	#define gpioBATCH_PORTS			2
+#endif
+
+// ------ typedef ------------------------------------------------------
+typedef struct
+{
+	GPIO_TypeDef	*pxPort[ gpioBATCH_PORTS ];
+	uint32_t		ulBsrr[ gpioBATCH_PORTS ];		/* Set in bits 0-15, reset in 16-31 */
+	uint32_t		ulPorts;
+} GpioBatch_t;
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* One BSRR store for each port of the batch, in the order they were
+ * added. The batch is left as it is and may be committed again. */
+void vGpioBatchCommit( const GpioBatch_t *pxBatch );
+
+/*------------------------------------------------------------------*/
+/* Empty the batch. */
+static inline void vGpioBatchInit( GpioBatch_t *pxBatch )
+{
+	pxBatch->ulPorts = 0;
+}
+
+/*------------------------------------------------------------------*/
+/* BSRR word of GPIOx in the batch, added if it is not there yet. */
+static inline uint32_t *pulGpioBatchPort( GpioBatch_t *pxBatch, GPIO_TypeDef *GPIOx )
+{
+	uint32_t ul;
+
+	for( ul = 0; ul < pxBatch->ulPorts; ul++ )
+	{
+		if( pxBatch->pxPort[ ul ] == GPIOx )
+		{
+			return &pxBatch->ulBsrr[ ul ];
+		}
+	}
+
+	configASSERT( ul < gpioBATCH_PORTS );
+	pxBatch->pxPort[ ul ] = GPIOx;
+	pxBatch->ulBsrr[ ul ] = 0;
+	pxBatch->ulPorts = ul + 1UL;
+
+	return &pxBatch->ulBsrr[ ul ];
+}
+
+/*------------------------------------------------------------------*/
+/* HAL_GPIO_WritePin() at the commit. */
+static inline void vGpioBatchWrite( GpioBatch_t *pxBatch, GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState )
+{
+	uint32_t *pulBsrr = pulGpioBatchPort( pxBatch, GPIOx );
+
+	if( PinState != GPIO_PIN_RESET )
+	{
+		*pulBsrr = ( *pulBsrr & ~( ( uint32_t ) GPIO_Pin << 16 ) ) | GPIO_Pin;
+	}
+	else
+	{
+		*pulBsrr = ( *pulBsrr & ~( uint32_t ) GPIO_Pin ) | ( ( uint32_t ) GPIO_Pin << 16 );
+	}
+}
+
+/*------------------------------------------------------------------*/
+/* HAL_GPIO_TogglePin() at the commit, from the output register now. */
+static inline void vGpioBatchToggle( GpioBatch_t *pxBatch, GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin )
+{
+	uint32_t *pulBsrr = pulGpioBatchPort( pxBatch, GPIOx );
+	uint32_t ulOdr = GPIOx->ODR;
+
+	*pulBsrr = ( *pulBsrr & ~( ( ( uint32_t ) GPIO_Pin << 16 ) | GPIO_Pin ) ) |
+			   ( ( ulOdr & GPIO_Pin ) << 16 ) | ( ~ulOdr & GPIO_Pin );
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GPIO_BATCH_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,100 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example3_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    led_Pwm.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Led PWM (Timer Output) Header file.
+
+    Optional led backend: LD1, LD2 and LD3 are driven by timer PWM
+    channels instead of HAL_GPIO_WritePin() / HAL_GPIO_TogglePin(), so
+    a blinking led costs no interrupt and no task run per edge. The
+    application only sets the period and the on time when they change.
+
+        LD1 (PB0)  -> TIM3_CH3  (AF2)
+        LD2 (PB7)  -> TIM4_CH2  (AF2)
+        LD3 (PB14) -> TIM12_CH1 (AF9)
+
+    The three timers are on APB1. The host simulation replaces
+    led_Pwm.c with a stub that plays the waveform on the simulated
+    GPIO from the tick interrupt.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __LED_PWM_H
+#define __LED_PWM_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+
+#include "main.h"
+
+// ------ macros -------------------------------------------------------
+/* Set to 1 to blink the leds from the timers (see vLedPwmInit()). */
+#ifndef ledPWM_ENABLE
+	#define ledPWM_ENABLE				0
+#endif
+
+// ------ typedef ------------------------------------------------------
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Switch LD1, LD2 and LD3 from GPIO outputs to their timer channels,
+ * all of them off. Called once, before the leds are used. */
+void vLedPwmInit( void );
+
+/* Blink the led at GPIOx / GPIO_Pin: on for ulOnUs of every ulPeriodUs.
+ * ulOnUs == 0 turns it off and ulOnUs >= ulPeriodUs turns it on. The
+ * new setting starts a period right away. Periods up to about 47 s. */
+void vLedPwmSet( GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, uint32_t ulPeriodUs, uint32_t ulOnUs );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LED_PWM_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -71,10 +71,44 @@
  extern "C" {
 #endif
 
+#include <stddef.h>
+
+/* Set to 1 to queue console output in log_Buffer and send it from a low
+priority drain task, or 0 to print synchronously inside a critical section
+(useful when the system crashes before the drain task gets to run). */
+#ifndef logUSE_DEFERRED_OUTPUT
+	#define logUSE_DEFERRED_OUTPUT		1
+#endif
+
+/* Set to 1 to send binary token records (see log_Token.h) instead of text.
+Decode the console with Tools/log_token.py. Needs logUSE_DEFERRED_OUTPUT. */
+#ifndef logUSE_TOKENS
+	#define logUSE_TOKENS				0
+#endif
+
+#if( ( logUSE_TOKENS == 1 ) && ( logUSE_DEFERRED_OUTPUT == 0 ) )
+	#error logUSE_TOKENS needs logUSE_DEFERRED_OUTPUT
+#endif
+
+#ifndef logDRAIN_TASK_PRIORITY
+	#define logDRAIN_TASK_PRIORITY		( tskIDLE_PRIORITY + 1UL )
+#endif
+
+#ifndef logDRAIN_STACK_SIZE
+	#define logDRAIN_STACK_SIZE			( 2 * configMINIMAL_STACK_SIZE )
+#endif
+
+/* Where the drain task sends the queued lines, USART3 by default (or when
+vLogSetSink() is passed NULL). */
+typedef void ( *LogSink_t )( const char *pcData, size_t xLength );
+
 void vPrintString( const char *pcString );
 void vPrintStringAndNumber( const char *pcString, uint32_t ulValue );
 void vPrintTwoStrings( const char *pcString1, const char *pcString2 );
 
+void vLogDrainStart( void );
+void vLogSetSink( LogSink_t pxSink );
+
 #ifdef __GNUC__
 /* With GCC, small printf (option LD Linker->Libraries->Small printf
    set to 'Yes') calls __io_putchar() */
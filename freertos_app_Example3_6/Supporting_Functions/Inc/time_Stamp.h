@@ -0,0 +1,114 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example3_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    time_Stamp.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Time Stamp Header file.
+
+    An event is stamped with two binary values, taken where it happens:
+    - the tick count extended to 64 bits with the kernel overflow
+      count, monotonic and sortable, never wraps;
+    - the RTC calendar as seconds since 1970 (0 if the RTC was not
+      running yet), see rtc_Clock.h.
+
+    The text form is only built when a record is printed or exported.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __TIME_STAMP_H
+#define __TIME_STAMP_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+#include <stddef.h>
+
+// ------ macros -------------------------------------------------------
+/* "2023-06-13 21:12:40 #18446744073709551615" and the terminator. */
+#define TIME_STAMP_TEXT_LENGTH		42
+
+// ------ typedef ------------------------------------------------------
+/* The 64 bit tick count is kept as two words: 12 bytes with 4 byte
+ * alignment, where a uint64_t member would pad the stamp to 16. */
+typedef struct
+{
+	uint32_t ulTickHigh;
+	uint32_t ulTickLow;
+	uint32_t ulEpoch;
+} TimeStamp_t;
+
+/* Calendar date and time (UTC), ucWeekDay 1 = Monday ... 7 = Sunday. */
+typedef struct
+{
+	uint16_t usYear;
+	uint8_t  ucMonth;
+	uint8_t  ucDay;
+	uint8_t  ucHour;
+	uint8_t  ucMinute;
+	uint8_t  ucSecond;
+	uint8_t  ucWeekDay;
+} TimeStampDate_t;
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Task context only (the overflow count is read in a critical section). */
+uint64_t ullTimeStampTicks( void );
+void vTimeStampGet( TimeStamp_t *pxStamp );
+
+/* Text as in TIME_STAMP_TEXT_LENGTH, returns the length written. */
+size_t xTimeStampFormat( const TimeStamp_t *pxStamp, char *pcBuffer, size_t xLength );
+
+/* Conversions between seconds since 1970 and calendar date. */
+void vTimeStampToDate( uint32_t ulEpoch, TimeStampDate_t *pxDate );
+uint32_t ulTimeStampFromDate( const TimeStampDate_t *pxDate );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIME_STAMP_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,174 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example3_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+/*--------------------------------------------------------------------*-
+
+    time_Stamp.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    Event time stamps for FreeRTOS - Event Driven System (EDS) -
+    Project for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Demo includes. */
+#include "rtc_Clock.h"
+#include "time_Stamp.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define timeSTAMP_DAY_SECONDS	86400UL
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+
+// ------ internal data definition -------------------------------------
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+uint64_t ullTimeStampTicks( void )
+{
+	TimeOut_t xTimeOut;
+
+	/* Tick count and overflow count read together by the kernel. */
+	vTaskSetTimeOutState( &xTimeOut );
+
+	return ( ( uint64_t )( uint32_t ) xTimeOut.xOverflowCount << 32 ) | ( uint64_t ) xTimeOut.xTimeOnEntering;
+}
+
+/*------------------------------------------------------------------*/
+void vTimeStampGet( TimeStamp_t *pxStamp )
+{
+	uint64_t ullTick = ullTimeStampTicks();
+
+	pxStamp->ulTickHigh = ( uint32_t )( ullTick >> 32 );
+	pxStamp->ulTickLow = ( uint32_t ) ullTick;
+	pxStamp->ulEpoch = ulRtcClockEpoch();
+}
+
+/*------------------------------------------------------------------*/
+size_t xTimeStampFormat( const TimeStamp_t *pxStamp, char *pcBuffer, size_t xLength )
+{
+	TimeStampDate_t xDate;
+	char cTick[ 21 ];
+	uint64_t ullTick = ( ( uint64_t ) pxStamp->ulTickHigh << 32 ) | pxStamp->ulTickLow;
+	size_t x = sizeof( cTick ) - 1;
+	int iLength;
+
+	/* newlib nano has no %llu, write the tick count by hand. */
+	cTick[ x ] = '\0';
+	do
+	{
+		cTick[ --x ] = ( char )( '0' + ( ullTick % 10ULL ) );
+		ullTick /= 10ULL;
+	} while( ullTick != 0ULL );
+
+	if( pxStamp->ulEpoch == 0UL )
+	{
+		iLength = snprintf( pcBuffer, xLength, "---------- --:--:-- #%s", &cTick[ x ] );
+	}
+	else
+	{
+		vTimeStampToDate( pxStamp->ulEpoch, &xDate );
+		iLength = snprintf( pcBuffer, xLength, "%04u-%02u-%02u %02u:%02u:%02u #%s",
+							( unsigned ) xDate.usYear, ( unsigned ) xDate.ucMonth, ( unsigned ) xDate.ucDay,
+							( unsigned ) xDate.ucHour, ( unsigned ) xDate.ucMinute, ( unsigned ) xDate.ucSecond,
+							&cTick[ x ] );
+	}
+
+	return ( iLength < 0 ) ? 0 : ( size_t ) iLength;
+}
+
+/*------------------------------------------------------------------*/
+void vTimeStampToDate( uint32_t ulEpoch, TimeStampDate_t *pxDate )
+{
+	uint32_t ulDays = ulEpoch / timeSTAMP_DAY_SECONDS;
+	uint32_t ulSeconds = ulEpoch % timeSTAMP_DAY_SECONDS;
+	uint32_t ulEra, ulDayOfEra, ulYearOfEra, ulDayOfYear, ulMonth;
+
+	pxDate->ucHour = ( uint8_t )( ulSeconds / 3600UL );
+	pxDate->ucMinute = ( uint8_t )( ( ulSeconds / 60UL ) % 60UL );
+	pxDate->ucSecond = ( uint8_t )( ulSeconds % 60UL );
+
+	/* 1970-01-01 was a Thursday. */
+	pxDate->ucWeekDay = ( uint8_t )( ( ( ulDays + 3UL ) % 7UL ) + 1UL );
+
+	/* Civil from days, with years starting on March 1st (leap day last). */
+	ulDays += 719468UL;
+	ulEra = ulDays / 146097UL;
+	ulDayOfEra = ulDays - ulEra * 146097UL;
+	ulYearOfEra = ( ulDayOfEra - ulDayOfEra / 1460UL + ulDayOfEra / 36524UL - ulDayOfEra / 146096UL ) / 365UL;
+	ulDayOfYear = ulDayOfEra - ( 365UL * ulYearOfEra + ulYearOfEra / 4UL - ulYearOfEra / 100UL );
+	ulMonth = ( 5UL * ulDayOfYear + 2UL ) / 153UL;
+
+	pxDate->ucDay = ( uint8_t )( ulDayOfYear - ( 153UL * ulMonth + 2UL ) / 5UL + 1UL );
+	pxDate->ucMonth = ( uint8_t )( ( ulMonth < 10UL ) ? ( ulMonth + 3UL ) : ( ulMonth - 9UL ) );
+	pxDate->usYear = ( uint16_t )( ulYearOfEra + ulEra * 400UL + ( ( pxDate->ucMonth <= 2 ) ? 1UL : 0UL ) );
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulTimeStampFromDate( const TimeStampDate_t *pxDate )
+{
+	uint32_t ulYear = pxDate->usYear - ( ( pxDate->ucMonth <= 2 ) ? 1UL : 0UL );
+	uint32_t ulEra = ulYear / 400UL;
+	uint32_t ulYearOfEra = ulYear - ulEra * 400UL;
+	uint32_t ulMonth = ( pxDate->ucMonth > 2 ) ? ( pxDate->ucMonth - 3UL ) : ( pxDate->ucMonth + 9UL );
+	uint32_t ulDayOfYear = ( 153UL * ulMonth + 2UL ) / 5UL + pxDate->ucDay - 1UL;
+	uint32_t ulDayOfEra = ulYearOfEra * 365UL + ulYearOfEra / 4UL - ulYearOfEra / 100UL + ulDayOfYear;
+	uint32_t ulDays = ulEra * 146097UL + ulDayOfEra - 719468UL;
+
+	return ulDays * timeSTAMP_DAY_SECONDS + pxDate->ucHour * 3600UL + pxDate->ucMinute * 60UL + pxDate->ucSecond;
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
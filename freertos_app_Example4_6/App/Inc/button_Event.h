@@ -0,0 +1,118 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example4_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    button_Event.h (Released 2022-10)
+
+  --------------------------------------------------------------------
+
+    This is the Button Event Header file.
+
+    USER_Btn events from its EXTI line.
+
+    Both edges of USER_Btn raise EXTI15_10_IRQHandler(). The first one
+    stamps the cycle counter, masks the interrupt and starts a one-shot
+    debounce timer, so the contact bounce costs a single interrupt. When
+    the timer expires the line is let in again and read: a level other
+    than the last one is a press or a release. Held for
+    BUTTON_LONG_PRESS_MS, a press is also a long press. The events wait
+    in a queue for the task that handles them, which blocks on
+    xButtonReceive() and so only wakes up when there is one.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __BUTTON_EVENT_H
+#define __BUTTON_EVENT_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+
+// ------ macros -------------------------------------------------------
+/* The line has to stay put this long after its first edge. */
+#ifndef BUTTON_DEBOUNCE_MS
+	#define BUTTON_DEBOUNCE_MS			20UL
+#endif
+
+/* A press held this long is also a long press. */
+#ifndef BUTTON_LONG_PRESS_MS
+	#define BUTTON_LONG_PRESS_MS		1000UL
+#endif
+
+/* Events not taken yet, the newest are dropped when it is full. */
+#ifndef BUTTON_QUEUE_LENGTH
+	#define BUTTON_QUEUE_LENGTH			4
+#endif
+
+// ------ typedef ------------------------------------------------------
+typedef enum	buttonEvent_e{ ButtonPress, ButtonRelease, ButtonLongPress } buttonEvent_t;
+
+typedef struct
+{
+	buttonEvent_t	eEvent;
+	uint32_t		ulCycles;	/* Cycle counter at the edge, or at the long press timeout */
+} buttonMsg_t;
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Create the queue and the timers, set USER_Btn to both edges and let
+ * its interrupt in. Call it before the scheduler starts. */
+void vButtonInit( void );
+
+/* Wait up to xTicksToWait for the next event. */
+BaseType_t xButtonReceive( buttonMsg_t *pxMsg, TickType_t xTicksToWait );
+
+/* Microseconds from the edge of the event to now, the debounce time
+ * included. */
+uint32_t ulButtonLatencyUs( const buttonMsg_t *pxMsg );
+
+/* Wait up to xTicksToWait for the next event, pdTRUE on a press. Prints
+ * the latency of the press and the long presses on the console. */
+BaseType_t xButtonWaitPress( TickType_t xTicksToWait );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BUTTON_EVENT_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -52,6 +52,12 @@
 // ------ inclusions ---------------------------------------------------
 
 // ------ macros -------------------------------------------------------
+/* 1: the Task Button thread blocks until the USER_Btn driver has an event
+ * (button_Event.h), so it does not wake up while the button is idle.
+ * 0: the original loop that polls the button. */
+#ifndef TASK_BUTTON_EVENT_DRIVEN
+	#define TASK_BUTTON_EVENT_DRIVEN	1
+#endif
 
 // ------ typedef ------------------------------------------------------
 
@@ -59,6 +59,7 @@
 
 /* Demo includes. */
 #include "supporting_Functions.h"
+#include "led_Pwm.h"
 
 /* Application includes. */
 #include "app_Resources.h"
@@ -76,8 +77,12 @@
  * tasks are executing. */
 const char *pcTextForTask_LDXTOn		= " - LDX turn On \r\n";
 const char *pcTextForTask_LDXTOff		= " - LDX turn Off\r\n";
+#if( ledPWM_ENABLE == 1 )
+const char *pcTextForTask_LDXBlink		= " - LDX blink   \r\n";
+#endif
 
 #define			ledTickCntMAX		pdMS_TO_TICKS( 250UL )
+#define			ledOnUs				( 250UL * 1000UL )
 
 LDX_Config_t	LDX_Config[] 	= { { LD1_GPIO_Port, LD1_Pin, GPIO_PIN_RESET, NotBlinking, 0 },
 							  	    { LD2_GPIO_Port, LD2_Pin, GPIO_PIN_RESET, NotBlinking, 0 }, \
@@ -98,11 +103,13 @@ void vTaskLed( void *pvParameters )
 	LDX_Config_t * ptr = &LDX_Config[0];
 	ledFlag_t ledFlag = NotBlinking;
 
+#if( ledPWM_ENABLE == 0 )
 	TickType_t xLastWakeTime;
 
 	/* The xLastWakeTime variable needs to be initialized with the current tick
 	   count. ws*/
 	xLastWakeTime = xTaskGetTickCount();
+#endif
 
 	char *pcTaskName = (char *) pcTaskGetName( NULL );
 
@@ -112,6 +119,22 @@ void vTaskLed( void *pvParameters )
 	/* As per most tasks, this task is implemented in an infinite loop. */
 	for( ;; )
 	{
+#if( ledPWM_ENABLE == 1 )
+		/* The led timer blinks the led, wait for a new led flag */
+		xQueueReceive(xQueueBlinkEvent, (void *)&ledFlag, portMAX_DELAY);
+
+		/* Update HW Led Timer: 250 ms on, 250 ms off or always off */
+		if( ledFlag == Blinking )
+		{
+			vLedPwmSet( ptr->LDX_GPIO_Port, ptr->LDX_Pin, 2UL * ledOnUs, ledOnUs );
+			vPrintTwoStrings( pcTaskName, pcTextForTask_LDXBlink );
+		}
+		else
+		{
+			vLedPwmSet( ptr->LDX_GPIO_Port, ptr->LDX_Pin, 2UL * ledOnUs, 0UL );
+			vPrintTwoStrings( pcTaskName, pcTextForTask_LDXTOff );
+		}
+#else
 		/* Check for new led flag on queue */
 		xQueueReceive(xQueueBlinkEvent, (void *)&ledFlag, 0);
 
@@ -135,6 +158,7 @@ void vTaskLed( void *pvParameters )
 
 		/* We want this task to execute exactly every 250 milliseconds. */
 		vTaskDelayUntil( &xLastWakeTime, ledTickCntMAX );
+#endif
 	}
 }
 
@@ -66,6 +66,7 @@
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
 #define configTOTAL_HEAP_SIZE                    ((size_t)15360)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configUSE_TRACE_FACILITY                 1
 #define configUSE_16_BIT_TICKS                   0
 #define configUSE_MUTEXES                        1
 #define configQUEUE_REGISTRY_SIZE                8
@@ -80,6 +81,12 @@
 #define configUSE_CO_ROUTINES                    0
 #define configMAX_CO_ROUTINE_PRIORITIES          ( 2 )
 
+/* Software timer definitions. */
+#define configUSE_TIMERS                         1
+#define configTIMER_TASK_PRIORITY                ( 2 )
+#define configTIMER_QUEUE_LENGTH                 10
+#define configTIMER_TASK_STACK_DEPTH             256
+
 /* The following flag must be enabled only when using newlib */
 #define configUSE_NEWLIB_REENTRANT          1
 
@@ -137,6 +144,17 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Scheduler trace recorder, define traceRECORDER_ENABLE as 1 to record (see trace_Recorder.h). */
+#include "trace_Recorder.h"
+/* Run time stats clocked by the DWT cycle counter (see run_Stats.h). */
+#include "cycle_Counter.h"
+#define configGENERATE_RUN_TIME_STATS            1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vCycleCounterInit()
+#define portGET_RUN_TIME_COUNTER_VALUE()         ulCycleCounterGet()
+/* Tickless idle in STOP mode, woken by the RTC wakeup timer (see low_Power.h). */
+#include "low_Power.h"
+#define configUSE_TICKLESS_IDLE                  1
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vLowPowerSuppressTicksAndSleep( xExpectedIdleTime )
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
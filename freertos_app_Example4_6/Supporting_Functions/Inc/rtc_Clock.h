@@ -0,0 +1,100 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example4_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    rtc_Clock.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the RTC Clock Header file.
+
+    The HAL RTC driver is not part of the projects, the RTC is set up
+    through its registers: LSE clock, PREDIV_A = 1 and PREDIV_S = 16383
+    so the calendar counts seconds and the sub-second register counts
+    at rtcCLOCK_HZ, shadow registers bypassed so they can be read right
+    after STOP mode. low_Power uses the same RTC for its wakeup timer.
+
+    The calendar keeps UTC and is read and written as seconds since
+    1970-01-01 00:00:00 (years 2000 to 2099). It survives a reset, and
+    starts at rtcCLOCK_START_EPOCH after a backup domain reset.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __RTC_CLOCK_H
+#define __RTC_CLOCK_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+
+// ------ macros -------------------------------------------------------
+/* Sub-second counts per second (LSE / ( PREDIV_A + 1 )). */
+#define rtcCLOCK_HZ					16384UL
+
+/* Calendar start when the RTC was not running: 2023-06-13 21:12:40. */
+#ifndef rtcCLOCK_START_EPOCH
+	#define rtcCLOCK_START_EPOCH	1686690760UL
+#endif
+
+// ------ typedef ------------------------------------------------------
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Start the LSE for the RTC without waiting, it may take up to 2 s. */
+void vRtcClockInit( void );
+
+/* 1 once the LSE runs and the RTC is set up. Does not block: the first
+ * call after the LSE is stable does the set up. Task context only. */
+uint32_t ulRtcClockReady( void );
+
+/* Seconds since 1970, 0 while the RTC is not ready. */
+uint32_t ulRtcClockEpoch( void );
+void vRtcClockSetEpoch( uint32_t ulEpoch );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RTC_CLOCK_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
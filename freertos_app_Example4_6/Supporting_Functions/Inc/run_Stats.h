@@ -0,0 +1,135 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example4_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    run_Stats.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Run Time Statistics Header file.
+
+    The kernel run time counters are clocked by the DWT cycle counter
+    (configGENERATE_RUN_TIME_STATS in FreeRTOSConfig.h). A low priority
+    task samples uxTaskGetSystemState() every runSTATS_SAMPLE_MS and
+    prints, for the last runSTATS_WINDOW_SAMPLES samples, the share of
+    the CPU and the cycles used by each task.
+
+    The same samples walk the heap_4 free list (vPortGetHeapStats) and
+    keep the worst largest free block and fragmentation seen; the report
+    adds them, the minimum ever free heap and the stack high water mark
+    of every task, so stacks and configTOTAL_HEAP_SIZE can be trimmed to
+    what the application really uses. Fragmentation is the share of the
+    free heap that is not in the largest free block: 0 % means a single
+    free block.
+
+    FreeRTOS 10.3.1 keeps 32 bit run time counters, so the task only
+    relies on differences between two samples (one sample period must
+    stay below 2^32 cycles, about 23 s at 180 MHz) and adds them up in
+    64 bits for the uptime and the per task totals.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __RUN_STATS_H
+#define __RUN_STATS_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+
+// ------ macros -------------------------------------------------------
+/* Set to 0 to leave the statistics task out. */
+#ifndef runSTATS_ENABLE
+	#define runSTATS_ENABLE				1
+#endif
+
+#ifndef runSTATS_SAMPLE_MS
+	#define runSTATS_SAMPLE_MS			1000UL
+#endif
+
+/* Samples in the sliding window, and samples between two reports. */
+#ifndef runSTATS_WINDOW_SAMPLES
+	#define runSTATS_WINDOW_SAMPLES		5
+#endif
+
+#ifndef runSTATS_REPORT_SAMPLES
+	#define runSTATS_REPORT_SAMPLES		5
+#endif
+
+/* Tasks that can be followed at once, kernel tasks included. With more
+ * tasks the samples are skipped and the report says so. */
+#ifndef runSTATS_MAX_TASKS
+	#define runSTATS_MAX_TASKS			16
+#endif
+
+/* Stacks with fewer free words than this are flagged in the report. */
+#ifndef runSTATS_STACK_LOW_WORDS
+	#define runSTATS_STACK_LOW_WORDS	32
+#endif
+
+#ifndef runSTATS_TASK_PRIORITY
+	#define runSTATS_TASK_PRIORITY		( tskIDLE_PRIORITY + 1UL )
+#endif
+
+#ifndef runSTATS_STACK_SIZE
+	#define runSTATS_STACK_SIZE			( 2 * configMINIMAL_STACK_SIZE )
+#endif
+
+/* Ticks to wait after each report line, so the console drain keeps up. */
+#ifndef runSTATS_REPORT_LINE_TICKS
+	#define runSTATS_REPORT_LINE_TICKS	pdMS_TO_TICKS( 10 )
+#endif
+
+// ------ typedef ------------------------------------------------------
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Create the statistics task (nothing when runSTATS_ENABLE is 0). */
+void vRunStatsStart( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RUN_STATS_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
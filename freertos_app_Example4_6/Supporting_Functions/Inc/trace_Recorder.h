@@ -0,0 +1,225 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example4_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*--------------------------------------------------------------------*-
+
+    trace_Recorder.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Scheduler Trace Recorder Header file.
+
+    Defines the FreeRTOS trace macros so that task switches and queue,
+    semaphore and mutex operations are written as 12 byte events into
+    a RAM ring (xTraceBuffer). The ring always holds the newest
+    traceRECORDER_EVENT_COUNT events. Dump it from the debugger
+
+        (gdb) dump binary value trace.bin xTraceBuffer
+
+    or with -T in the host simulation, then convert it with
+    Tools/trace_to_json.py and open the result in ui.perfetto.dev or
+    chrome://tracing.
+
+    Included at the end of FreeRTOSConfig.h, so only standard types
+    are available here: the macros expand inside tasks.c and queue.c,
+    where pxCurrentTCB, pxNewTCB and pxQueue are in scope.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __TRACE_RECORDER_H
+#define __TRACE_RECORDER_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+
+// ------ macros -------------------------------------------------------
+/* Set to 1 (here, in FreeRTOSConfig.h or with -D) to record. */
+#ifndef traceRECORDER_ENABLE
+	#define traceRECORDER_ENABLE			0
+#endif
+
+/* Events kept in the ring, must be a power of two (12 bytes each). */
+#ifndef traceRECORDER_EVENT_COUNT
+	#define traceRECORDER_EVENT_COUNT		1024
+#endif
+
+/* Tasks and queues that can be named in the dump. */
+#ifndef traceRECORDER_OBJECT_COUNT
+	#define traceRECORDER_OBJECT_COUNT		32
+#endif
+
+#define traceRECORDER_NAME_LENGTH			32
+#define traceRECORDER_MAGIC					0x31435254UL	/* "TRC1" */
+
+/* Event time stamp, in core clock cycles: DWT->CYCCNT, read directly as
+ * core_cm4.h cannot be included from here. */
+#ifndef traceRECORDER_TIMESTAMP
+	#define traceRECORDER_TIMESTAMP()		( *( volatile uint32_t * ) 0xE0001004UL )
+#endif
+
+#if( ( traceRECORDER_EVENT_COUNT & ( traceRECORDER_EVENT_COUNT - 1 ) ) != 0 )
+	#error traceRECORDER_EVENT_COUNT must be a power of two
+#endif
+
+// ------ typedef ------------------------------------------------------
+/* Event types, Tools/trace_to_json.py uses the same numbers. */
+typedef enum
+{
+	eTraceSwitchedIn = 1,
+	eTraceSwitchedOut,
+	eTraceQueueSend,
+	eTraceQueueSendFailed,
+	eTraceQueueReceive,
+	eTraceQueueReceiveFailed,
+	eTraceBlockingOnSend,
+	eTraceBlockingOnReceive,
+	eTraceQueueSendFromIsr,
+	eTraceQueueReceiveFromIsr,
+	eTraceTaskDelay,
+	eTraceTaskDelete
+} eTraceEvent_t;
+
+/* Object kinds: the kernel queue types (queueQUEUE_TYPE_*), or a task. */
+typedef enum
+{
+	eTraceQueue = 0,
+	eTraceMutex,
+	eTraceCountingSemaphore,
+	eTraceBinarySemaphore,
+	eTraceRecursiveMutex,
+	eTraceTask = 16
+} eTraceObject_t;
+
+typedef struct
+{
+	uint32_t ulTimestamp;	/* traceRECORDER_TIMESTAMP(). */
+	uint32_t ulHandle;		/* Task or queue, low 32 bits of its handle. */
+	uint32_t ulInfo;		/* Event type << 24 | argument (items in the queue
+							 * before the operation). */
+} TraceEvent_t;
+
+typedef struct
+{
+	uint32_t ulHandle;
+	uint32_t ulKind;		/* eTraceObject_t. */
+	char     cName[ traceRECORDER_NAME_LENGTH ];
+} TraceObject_t;
+
+/* Everything the converter needs, in one block of RAM. */
+typedef struct
+{
+	uint32_t ulMagic;		/* traceRECORDER_MAGIC once started. */
+	uint32_t ulCoreClock;	/* Time stamp frequency in Hz. */
+	uint32_t ulEventCount;	/* traceRECORDER_EVENT_COUNT. */
+	uint32_t ulObjectCount;	/* traceRECORDER_OBJECT_COUNT. */
+	uint32_t ulRecording;	/* 0 while stopped. */
+	uint32_t ulHead;		/* Events ever written, the newest is ulHead - 1. */
+	uint32_t ulObjectsUsed;
+	uint32_t ulObjectsLost;	/* Objects created after the table filled up. */
+	TraceObject_t xObject[ traceRECORDER_OBJECT_COUNT ];
+	TraceEvent_t xEvent[ traceRECORDER_EVENT_COUNT ];
+} TraceBuffer_t;
+
+// ------ external data declaration ------------------------------------
+#if( traceRECORDER_ENABLE == 1 )
+extern TraceBuffer_t xTraceBuffer;
+#endif
+
+// ------ external functions declaration -------------------------------
+
+/* Add a task or queue to the object table (starts the recorder on the
+ * first call), or rename it if it is already there. */
+void vTraceRecorderObject( uint32_t ulKind, const void *pvHandle, const char *pcName );
+
+/* Freeze the ring, e.g. when a fault is detected, and resume it. */
+void vTraceRecorderStop( void );
+void vTraceRecorderStart( void );
+
+/* Start and size of xTraceBuffer, 0 when the recorder is disabled. */
+uint32_t ulTraceRecorderGet( const void **ppvBuffer );
+
+#if( traceRECORDER_ENABLE == 1 )
+/*------------------------------------------------------------------*/
+/* Called from the trace macros, with the kernel data in scope. It only
+ * claims a slot and stores three words, any context may call it. */
+static inline void vTraceRecorderEvent( uint32_t ulType, const void *pvHandle, uint32_t ulArgument )
+{
+	TraceEvent_t *pxEvent;
+	uint32_t ulIndex;
+
+	if( xTraceBuffer.ulRecording != 0UL )
+	{
+		ulIndex = __atomic_fetch_add( &xTraceBuffer.ulHead, 1UL, __ATOMIC_RELAXED );
+		pxEvent = &xTraceBuffer.xEvent[ ulIndex & ( traceRECORDER_EVENT_COUNT - 1UL ) ];
+		pxEvent->ulTimestamp = traceRECORDER_TIMESTAMP();
+		pxEvent->ulHandle = ( uint32_t )( uintptr_t ) pvHandle;
+		pxEvent->ulInfo = ( ulType << 24 ) | ( ulArgument & 0x00FFFFFFUL );
+	}
+}
+
+// ------ FreeRTOS trace macros ----------------------------------------
+#define traceTASK_CREATE( pxNewTCB )					vTraceRecorderObject( eTraceTask, ( pxNewTCB ), ( pxNewTCB )->pcTaskName )
+#define traceTASK_DELETE( pxTCB )						vTraceRecorderEvent( eTraceTaskDelete, ( pxTCB ), 0 )
+#define traceTASK_SWITCHED_IN()							vTraceRecorderEvent( eTraceSwitchedIn, pxCurrentTCB, 0 )
+#define traceTASK_SWITCHED_OUT()						vTraceRecorderEvent( eTraceSwitchedOut, pxCurrentTCB, 0 )
+#define traceTASK_DELAY()								vTraceRecorderEvent( eTraceTaskDelay, pxCurrentTCB, 0 )
+#define traceTASK_DELAY_UNTIL( xTimeToWake )			vTraceRecorderEvent( eTraceTaskDelay, pxCurrentTCB, 0 )
+
+/* Mutex and semaphore give/take go through the queue send/receive
+ * paths; the object kind tells them apart. */
+#define traceQUEUE_CREATE( pxNewQueue )					vTraceRecorderObject( ucQueueType, ( pxNewQueue ), NULL )
+#define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName )	vTraceRecorderObject( eTraceQueue, ( xQueue ), ( pcQueueName ) )
+#define traceQUEUE_SEND( pxQueue )						vTraceRecorderEvent( eTraceQueueSend, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FAILED( pxQueue )				vTraceRecorderEvent( eTraceQueueSendFailed, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE( pxQueue )					vTraceRecorderEvent( eTraceQueueReceive, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )			vTraceRecorderEvent( eTraceQueueReceiveFailed, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )			vTraceRecorderEvent( eTraceBlockingOnSend, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )		vTraceRecorderEvent( eTraceBlockingOnReceive, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )				vTraceRecorderEvent( eTraceQueueSendFromIsr, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )			vTraceRecorderEvent( eTraceQueueReceiveFromIsr, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TRACE_RECORDER_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,294 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example4_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    log_Token.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    Tokenized log encoder for FreeRTOS - Event Driven System (EDS) -
+    Project for STM32F429ZI_NUCLEO_144.
+
+    The pcTextFor* strings are constants linked into .rodata, so their
+    offset from _srodata (see the linker script) is already a unique,
+    build-time index: no table has to be kept on the target and the call
+    sites stay unchanged.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Demo includes. */
+#include "log_Token.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define logTOKEN_MAX				0xFFFFUL
+
+// ------ internal data declaration ------------------------------------
+/* Bounds of .rodata, from the linker script. */
+extern const char _srodata[];
+extern const char _erodata[];
+
+// ------ internal functions declaration -------------------------------
+static BaseType_t prvLogTokenFind( const char *pcString, uint16_t *pusToken );
+static uint8_t *prvLogTokenPut16( uint8_t *pucBuffer, uint16_t usValue );
+static uint8_t *prvLogTokenPut32( uint8_t *pucBuffer, uint32_t ulValue );
+static uint8_t *prvLogTokenPutVarint( uint8_t *pucBuffer, uint32_t ulValue );
+static uint32_t prvLogTokenGet32( const uint8_t *pucBuffer );
+static uint8_t prvLogTokenChecksum( const uint8_t *pucBuffer, size_t xLength );
+
+// ------ internal data definition -------------------------------------
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+static BaseType_t prvLogTokenFind( const char *pcString, uint16_t *pusToken )
+{
+	uintptr_t uxOffset = ( uintptr_t ) pcString - ( uintptr_t ) _srodata;
+
+	/* Also rejects strings below _srodata, the subtraction wraps. */
+	if( ( uxOffset >= ( uintptr_t ) ( _erodata - _srodata ) ) || ( uxOffset > logTOKEN_MAX ) )
+	{
+		return pdFALSE;
+	}
+
+	*pusToken = ( uint16_t ) uxOffset;
+
+	return pdTRUE;
+}
+
+/*------------------------------------------------------------------*/
+static uint8_t *prvLogTokenPut16( uint8_t *pucBuffer, uint16_t usValue )
+{
+	pucBuffer[ 0 ] = ( uint8_t ) ( usValue );
+	pucBuffer[ 1 ] = ( uint8_t ) ( usValue >> 8 );
+
+	return pucBuffer + 2;
+}
+
+/*------------------------------------------------------------------*/
+static uint8_t *prvLogTokenPut32( uint8_t *pucBuffer, uint32_t ulValue )
+{
+	pucBuffer[ 0 ] = ( uint8_t ) ( ulValue );
+	pucBuffer[ 1 ] = ( uint8_t ) ( ulValue >> 8 );
+	pucBuffer[ 2 ] = ( uint8_t ) ( ulValue >> 16 );
+	pucBuffer[ 3 ] = ( uint8_t ) ( ulValue >> 24 );
+
+	return pucBuffer + 4;
+}
+
+/*------------------------------------------------------------------*/
+static uint8_t *prvLogTokenPutVarint( uint8_t *pucBuffer, uint32_t ulValue )
+{
+	while( ulValue >= 0x80 )
+	{
+		*pucBuffer++ = ( uint8_t ) ( ulValue | 0x80 );
+		ulValue >>= 7;
+	}
+	*pucBuffer++ = ( uint8_t ) ulValue;
+
+	return pucBuffer;
+}
+
+/*------------------------------------------------------------------*/
+static uint32_t prvLogTokenGet32( const uint8_t *pucBuffer )
+{
+	return ( uint32_t ) pucBuffer[ 0 ] | ( ( uint32_t ) pucBuffer[ 1 ] << 8 ) |
+		   ( ( uint32_t ) pucBuffer[ 2 ] << 16 ) | ( ( uint32_t ) pucBuffer[ 3 ] << 24 );
+}
+
+/*------------------------------------------------------------------*/
+static uint8_t prvLogTokenChecksum( const uint8_t *pucBuffer, size_t xLength )
+{
+	uint8_t ucSum = 0;
+
+	while( xLength-- > 0 )
+	{
+		ucSum ^= *pucBuffer++;
+	}
+
+	return ucSum;
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+size_t xLogTokenEncode( uint8_t *pucBuffer, size_t xBufferLength, uint8_t ucType,
+						const char *pcString1, const char *pcString2,
+						uint32_t ulValue, uint32_t ulTick )
+{
+	char cText[ 96 ];
+	uint16_t usToken1, usToken2 = 0;
+	uint8_t *pucNext;
+	int iLength;
+
+	if( ( xBufferLength >= logTOKEN_QUEUED_SIZE ) &&
+		( prvLogTokenFind( pcString1, &usToken1 ) != pdFALSE ) &&
+		( ( ucType != logTOKEN_TWO_STRINGS ) || ( prvLogTokenFind( pcString2, &usToken2 ) != pdFALSE ) ) )
+	{
+		if( ucType == logTOKEN_TWO_STRINGS )
+		{
+			ulValue = usToken2;
+		}
+
+		/* Fixed layout, xLogTokenPack drops what the type does not use. */
+		pucNext = pucBuffer;
+		*pucNext++ = ucType;
+		pucNext = prvLogTokenPut16( pucNext, usToken1 );
+		pucNext = prvLogTokenPut32( pucNext, ulTick );
+		prvLogTokenPut32( pucNext, ulValue );
+
+		return logTOKEN_QUEUED_SIZE;
+	}
+
+	/* Built at run time (e.g. a buffer on the stack): send the text. */
+	switch( ucType )
+	{
+		case logTOKEN_STRING_NUMBER:
+			iLength = snprintf( cText, sizeof( cText ), "%s %lu\r\n", pcString1, ( unsigned long ) ulValue );
+			break;
+		case logTOKEN_TWO_STRINGS:
+			iLength = snprintf( cText, sizeof( cText ), "At time %lu: %s %s\r\n", ( unsigned long ) ulTick, pcString1, pcString2 );
+			break;
+		default:
+			iLength = snprintf( cText, sizeof( cText ), "%s", pcString1 );
+			break;
+	}
+
+	if( iLength < 0 )
+	{
+		iLength = 0;
+	}
+	else if( iLength >= ( int ) sizeof( cText ) )
+	{
+		iLength = sizeof( cText ) - 1;
+	}
+
+	return xLogTokenEncodeText( pucBuffer, xBufferLength, cText, ( size_t ) iLength );
+}
+
+/*------------------------------------------------------------------*/
+size_t xLogTokenPack( uint8_t *pucWire, size_t xWireLength,
+					  const uint8_t *pucRecord, size_t xLength, uint32_t *pulLastTick )
+{
+	uint8_t ucType = pucRecord[ 0 ];
+	uint32_t ulTick;
+	uint8_t *pucNext;
+
+	if( ucType == logTOKEN_SYNC )
+	{
+		/* Text record, already in wire form. */
+		if( xLength > xWireLength )
+		{
+			return 0;
+		}
+		memcpy( pucWire, pucRecord, xLength );
+
+		return xLength;
+	}
+
+	if( ( xLength != logTOKEN_QUEUED_SIZE ) || ( xWireLength < logTOKEN_RECORD_SIZE ) )
+	{
+		return 0;
+	}
+
+	/* Modulo 2^32: a writer preempted between its tick and its write
+	 * queues an older tick, which costs a 5 byte delta, not a wrong time. */
+	ulTick = prvLogTokenGet32( &pucRecord[ 3 ] );
+
+	pucNext = pucWire;
+	*pucNext++ = logTOKEN_SYNC;
+	*pucNext++ = ucType;
+	*pucNext++ = pucRecord[ 1 ];
+	*pucNext++ = pucRecord[ 2 ];
+	pucNext = prvLogTokenPutVarint( pucNext, ulTick - *pulLastTick );
+
+	if( ucType == logTOKEN_STRING_NUMBER )
+	{
+		pucNext = prvLogTokenPutVarint( pucNext, prvLogTokenGet32( &pucRecord[ 7 ] ) );
+	}
+	else if( ucType == logTOKEN_TWO_STRINGS )
+	{
+		*pucNext++ = pucRecord[ 7 ];
+		*pucNext++ = pucRecord[ 8 ];
+	}
+
+	*pucNext = prvLogTokenChecksum( &pucWire[ 1 ], ( size_t ) ( pucNext - &pucWire[ 1 ] ) );
+	*pulLastTick = ulTick;
+
+	return ( size_t ) ( pucNext - pucWire ) + 1;
+}
+
+/*------------------------------------------------------------------*/
+size_t xLogTokenEncodeText( uint8_t *pucBuffer, size_t xBufferLength,
+							const char *pcText, size_t xLength )
+{
+	if( xBufferLength < logTOKEN_TEXT_OVERHEAD )
+	{
+		return 0;
+	}
+	if( xLength > ( xBufferLength - logTOKEN_TEXT_OVERHEAD ) )
+	{
+		xLength = xBufferLength - logTOKEN_TEXT_OVERHEAD;
+	}
+	if( xLength > 255 )
+	{
+		xLength = 255;
+	}
+
+	pucBuffer[ 0 ] = logTOKEN_SYNC;
+	pucBuffer[ 1 ] = logTOKEN_TEXT;
+	pucBuffer[ 2 ] = ( uint8_t ) xLength;
+	memcpy( &pucBuffer[ 3 ], pcText, xLength );
+	pucBuffer[ 3 + xLength ] = prvLogTokenChecksum( &pucBuffer[ 1 ], xLength + 2 );
+
+	return xLength + logTOKEN_TEXT_OVERHEAD;
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
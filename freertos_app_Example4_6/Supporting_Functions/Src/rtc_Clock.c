@@ -0,0 +1,209 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example4_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+/*--------------------------------------------------------------------*-
+
+    rtc_Clock.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    RTC calendar for FreeRTOS - Event Driven System (EDS) - Project
+    for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Demo includes. */
+#include "time_Stamp.h"
+#include "rtc_Clock.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define rtcCLOCK_PRER			( ( 1UL << RTC_PRER_PREDIV_A_Pos ) | ( rtcCLOCK_HZ - 1UL ) )
+
+#define rtcCLOCK_BCD( x )		( ( ( ( x ) / 10UL ) << 4 ) | ( ( x ) % 10UL ) )
+#define rtcCLOCK_BIN( x )		( ( ( ( x ) >> 4 ) * 10UL ) + ( ( x ) & 0x0FUL ) )
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+static void prvRtcClockCalendarSet( uint32_t ulEpoch );
+
+// ------ internal data definition -------------------------------------
+static volatile uint8_t ucRtcClockReady;
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+static void prvRtcClockCalendarSet( uint32_t ulEpoch )
+{
+	TimeStampDate_t xDate;
+
+	vTimeStampToDate( ulEpoch, &xDate );
+
+	/* Write protection is off. Initialization mode stops the calendar. */
+	RTC->ISR |= RTC_ISR_INIT;
+	while( ( RTC->ISR & RTC_ISR_INITF ) == 0 )
+	{
+	}
+	RTC->PRER = rtcCLOCK_HZ - 1UL;
+	RTC->PRER |= 1UL << RTC_PRER_PREDIV_A_Pos;
+	RTC->TR = ( rtcCLOCK_BCD( xDate.ucHour ) << RTC_TR_HU_Pos ) |
+			  ( rtcCLOCK_BCD( xDate.ucMinute ) << RTC_TR_MNU_Pos ) |
+			  ( rtcCLOCK_BCD( xDate.ucSecond ) << RTC_TR_SU_Pos );
+	RTC->DR = ( rtcCLOCK_BCD( xDate.usYear - 2000UL ) << RTC_DR_YU_Pos ) |
+			  ( ( uint32_t ) xDate.ucWeekDay << RTC_DR_WDU_Pos ) |
+			  ( rtcCLOCK_BCD( xDate.ucMonth ) << RTC_DR_MU_Pos ) |
+			  ( rtcCLOCK_BCD( xDate.ucDay ) << RTC_DR_DU_Pos );
+	RTC->ISR &= ~RTC_ISR_INIT;
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vRtcClockInit( void )
+{
+	/* Backup domain access, then start the LSE without waiting for it. */
+	__HAL_RCC_PWR_CLK_ENABLE();
+	HAL_PWR_EnableBkUpAccess();
+
+	if( ( ( RCC->BDCR & RCC_BDCR_RTCSEL ) != 0 ) && ( ( RCC->BDCR & RCC_BDCR_RTCSEL ) != RCC_BDCR_RTCSEL_0 ) )
+	{
+		/* The RTC clock can only be changed by a backup domain reset. */
+		RCC->BDCR |= RCC_BDCR_BDRST;
+		RCC->BDCR &= ~RCC_BDCR_BDRST;
+	}
+	RCC->BDCR |= RCC_BDCR_LSEON;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulRtcClockReady( void )
+{
+	if( ucRtcClockReady != 0 )
+	{
+		return 1UL;
+	}
+
+	/* Not yet if vRtcClockInit() has not run or the LSE is not stable. */
+	if( ( RCC->BDCR & RCC_BDCR_LSERDY ) == 0 )
+	{
+		return 0UL;
+	}
+
+	/* The idle task (tickless idle) and the tasks may both get here. */
+	taskENTER_CRITICAL();
+	if( ucRtcClockReady == 0 )
+	{
+		if( ( RCC->BDCR & RCC_BDCR_RTCEN ) == 0 )
+		{
+			RCC->BDCR |= RCC_BDCR_RTCSEL_0 | RCC_BDCR_RTCEN;
+		}
+
+		RTC->WPR = 0xCA;
+		RTC->WPR = 0x53;
+
+		/* Keep a calendar that was already running with these settings. */
+		if( ( RTC->PRER != rtcCLOCK_PRER ) || ( ( RTC->ISR & RTC_ISR_INITS ) == 0 ) )
+		{
+			prvRtcClockCalendarSet( rtcCLOCK_START_EPOCH );
+		}
+		RTC->CR |= RTC_CR_BYPSHAD;
+
+		RTC->WPR = 0xFF;
+
+		ucRtcClockReady = 1;
+	}
+	taskEXIT_CRITICAL();
+
+	return 1UL;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulRtcClockEpoch( void )
+{
+	TimeStampDate_t xDate;
+	uint32_t ulTr, ulDr;
+
+	if( ulRtcClockReady() == 0UL )
+	{
+		return 0UL;
+	}
+
+	/* Shadow registers are bypassed: read until two readings agree. */
+	do
+	{
+		ulTr = RTC->TR;
+		ulDr = RTC->DR;
+	} while( ( ulTr != RTC->TR ) || ( ulDr != RTC->DR ) );
+
+	xDate.usYear = ( uint16_t )( 2000UL + rtcCLOCK_BIN( ( ulDr & ( RTC_DR_YT | RTC_DR_YU ) ) >> RTC_DR_YU_Pos ) );
+	xDate.ucMonth = ( uint8_t ) rtcCLOCK_BIN( ( ulDr & ( RTC_DR_MT | RTC_DR_MU ) ) >> RTC_DR_MU_Pos );
+	xDate.ucDay = ( uint8_t ) rtcCLOCK_BIN( ( ulDr & ( RTC_DR_DT | RTC_DR_DU ) ) >> RTC_DR_DU_Pos );
+	xDate.ucHour = ( uint8_t ) rtcCLOCK_BIN( ( ulTr & ( RTC_TR_HT | RTC_TR_HU ) ) >> RTC_TR_HU_Pos );
+	xDate.ucMinute = ( uint8_t ) rtcCLOCK_BIN( ( ulTr & ( RTC_TR_MNT | RTC_TR_MNU ) ) >> RTC_TR_MNU_Pos );
+	xDate.ucSecond = ( uint8_t ) rtcCLOCK_BIN( ( ulTr & ( RTC_TR_ST | RTC_TR_SU ) ) >> RTC_TR_SU_Pos );
+
+	return ulTimeStampFromDate( &xDate );
+}
+
+/*------------------------------------------------------------------*/
+void vRtcClockSetEpoch( uint32_t ulEpoch )
+{
+	if( ulRtcClockReady() == 0UL )
+	{
+		return;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		RTC->WPR = 0xCA;
+		RTC->WPR = 0x53;
+		prvRtcClockCalendarSet( ulEpoch );
+		RTC->WPR = 0xFF;
+	}
+	taskEXIT_CRITICAL();
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -72,7 +72,9 @@
  * To allow maximum portability the book examples do not rely on any chip
  * specific IO, and instead just output to a console.  However, printing to a
  * console in this manner is not thread safe, so a function is used so the
- * terminal output can be wrapped in a critical section.
+ * terminal output can be wrapped in a critical section.  When
+ * logUSE_DEFERRED_OUTPUT is 1 the output is instead queued in log_Buffer and
+ * sent by a low priority drain task, so callers never mask interrupts.
  *
  * 2) RTOS hook functions: vApplicationMallocFailedHook(), vApplicationIdleHook()
  * vApplicationIdleHook(), vApplicationStackOverflowHook() and
@@ -102,11 +104,29 @@
 
 /* Demo includes. */
 #include "supporting_Functions.h"
+#include "log_Buffer.h"
+#include "log_Token.h"
+#include "uart_Tx.h"
 
 
  // ------ Public variable  -----------------------------------------
 extern UART_HandleTypeDef huart3;
 
+ // ------ Private variable  ----------------------------------------
+#if( logUSE_DEFERRED_OUTPUT == 1 )
+static void prvLogDrainTask( void *pvParameters );
+static void prvLogUartSink( const char *pcData, size_t xLength );
+static void prvLogWakeDrain( void );
+#if( logUSE_TOKENS == 1 )
+static void prvLogToken( uint8_t ucType, const char *pcString1, const char *pcString2, uint32_t ulValue );
+#endif
+
+static TaskHandle_t xLogDrainTaskHandle = NULL;
+static LogSink_t pxLogSink = prvLogUartSink;
+
+static const char *pcTextForLog_Dropped = "  <=> Task  Log - dropped: %lu high-water: %lu/%lu\r\n";
+#endif
+
 /*-----------------------------------------------------------*/
 /**
   * @brief  Retargets the C library printf function to the USART.
@@ -116,12 +136,182 @@ extern UART_HandleTypeDef huart3;
 PUTCHAR_PROTOTYPE
 {
 	/* Place your implementation of fputc here */
-    /* e.g. write a character to the USART3 and Loop until the end of transmission */
-	HAL_UART_Transmit(&huart3, (uint8_t *)&ch, 1, 0xFFFF);
+    /* e.g. write a character to the USART3 transmit engine */
+	char c = ( char ) ch;
+
+	xUartTxWrite( &c, 1 );
 
 	return ch;
 }
+/*-----------------------------------------------------------*/
+
+/**
+  * @brief  Retargets the C library write function to the USART, so printf
+  *         hands whole buffers over instead of one character at a time
+  *         (overrides the weak _write() in syscalls.c).
+  * @param  file, ptr, len
+  * @retval Number of bytes written
+  */
+int _write( int file, char *ptr, int len )
+{
+	( void ) file;
+
+	return ( int ) xUartTxWrite( ptr, ( size_t ) len );
+}
 
+#if( logUSE_DEFERRED_OUTPUT == 1 )
+/*-----------------------------------------------------------*/
+
+#if( logUSE_TOKENS == 1 )
+void vPrintString( const char *pcString )
+{
+	/* Queue a token record instead of the text. */
+	prvLogToken( logTOKEN_STRING, pcString, NULL, 0 );
+}
+/*-----------------------------------------------------------*/
+
+void vPrintStringAndNumber( const char *pcString, uint32_t ulValue )
+{
+	prvLogToken( logTOKEN_STRING_NUMBER, pcString, NULL, ulValue );
+}
+/*-----------------------------------------------------------*/
+
+void vPrintTwoStrings( const char *pcString1, const char *pcString2 )
+{
+	prvLogToken( logTOKEN_TWO_STRINGS, pcString1, pcString2, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvLogToken( uint8_t ucType, const char *pcString1, const char *pcString2, uint32_t ulValue )
+{
+	uint8_t ucRecord[ logBUFFER_SLOT_SIZE ];
+	size_t xLength;
+
+	xLength = xLogTokenEncode( ucRecord, sizeof( ucRecord ), ucType, pcString1, pcString2,
+							   ulValue, ( uint32_t ) xTaskGetTickCount() );
+	ulLogBufferWrite( ( const char * ) ucRecord, xLength );
+	prvLogWakeDrain();
+}
+/*-----------------------------------------------------------*/
+
+#else
+void vPrintString( const char *pcString )
+{
+	/* Queue the string, the drain task prints it later.  No critical
+	 * section is needed, log_Buffer is safe for several writers. */
+	ulLogBufferWrite( pcString, strlen( pcString ) );
+	prvLogWakeDrain();
+}
+/*-----------------------------------------------------------*/
+
+void vPrintStringAndNumber( const char *pcString, uint32_t ulValue )
+{
+	ulLogBufferPrintf( "%s %lu\r\n", pcString, ( unsigned long ) ulValue );
+	prvLogWakeDrain();
+}
+/*-----------------------------------------------------------*/
+
+void vPrintTwoStrings( const char *pcString1, const char *pcString2 )
+{
+	ulLogBufferPrintf( "At time %lu: %s %s\r\n", ( unsigned long ) xTaskGetTickCount(), pcString1, pcString2 );
+	prvLogWakeDrain();
+}
+/*-----------------------------------------------------------*/
+#endif
+
+void vLogDrainStart( void )
+{
+	BaseType_t ret;
+
+	/* Drain thread at low priority, it only runs when nothing else has work. */
+	ret = xTaskCreate( prvLogDrainTask,				/* Pointer to the function thats implement the task. */
+					   "Task Log",					/* Text name for the task. This is to facilitate debugging only. */
+					   logDRAIN_STACK_SIZE,			/* Stack depth in words. 				*/
+					   NULL,						/* We are not using the task parameter.		*/
+					   logDRAIN_TASK_PRIORITY,		/* This task will run at low priority. 		*/
+					   &xLogDrainTaskHandle );		/* We are using a variable as task handle.	*/
+
+	/* Check the task was created successfully. */
+	configASSERT( ret == pdPASS );
+}
+/*-----------------------------------------------------------*/
+
+void vLogSetSink( LogSink_t pxSink )
+{
+	/* Lets a host build capture the console in memory, NULL restores
+	 * USART3. */
+	pxLogSink = ( pxSink != NULL ) ? pxSink : prvLogUartSink;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLogWakeDrain( void )
+{
+	/* Lines queued before the scheduler starts are drained on the first
+	 * pass of the drain task. */
+	if( ( xLogDrainTaskHandle != NULL ) && ( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED ) )
+	{
+		xTaskNotifyGive( xLogDrainTaskHandle );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvLogUartSink( const char *pcData, size_t xLength )
+{
+	xUartTxWrite( pcData, xLength );
+}
+/*-----------------------------------------------------------*/
+
+static void prvLogDrainTask( void *pvParameters )
+{
+	char cLine[ logBUFFER_SLOT_SIZE ];
+#if( logUSE_TOKENS == 1 )
+	uint8_t ucRecord[ logBUFFER_SLOT_SIZE ];
+	uint32_t ulLastTick = 0;
+#endif
+	LogBufferStats_t xStats;
+	uint32_t ulDroppedReported = 0;
+	size_t xLength;
+
+	for( ;; )
+	{
+		/* Empty the ring. */
+		while( ( xLength = xLogBufferRead( cLine, sizeof( cLine ) ) ) > 0 )
+		{
+#if( logUSE_TOKENS == 1 )
+			/* Records go out in ring order, so each tick is sent as the
+			 * delta to the one before. */
+			xLength = xLogTokenPack( ucRecord, sizeof( ucRecord ), ( const uint8_t * ) cLine, xLength, &ulLastTick );
+			pxLogSink( ( const char * ) ucRecord, xLength );
+#else
+			pxLogSink( cLine, xLength );
+#endif
+		}
+
+		/* Report the lines lost since the last pass. */
+		vLogBufferGetStats( &xStats );
+		if( xStats.ulDropped != ulDroppedReported )
+		{
+			ulDroppedReported = xStats.ulDropped;
+			xLength = ( size_t ) snprintf( cLine, sizeof( cLine ), pcTextForLog_Dropped,
+										   ( unsigned long ) xStats.ulDropped,
+										   ( unsigned long ) xStats.ulHighWater,
+										   ( unsigned long ) xStats.ulCapacity );
+#if( logUSE_TOKENS == 1 )
+			/* Keep the console a valid record stream. */
+			xLength = xLogTokenEncodeText( ucRecord, sizeof( ucRecord ), cLine, xLength );
+			pxLogSink( ( const char * ) ucRecord, xLength );
+#else
+			pxLogSink( cLine, xLength );
+#endif
+		}
+
+		/* Sleep until a writer queues something new. */
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#else
 /*-----------------------------------------------------------*/
 
 void vPrintString( const char *pcString )
@@ -161,3 +351,16 @@ void vPrintTwoStrings( const char *pcString1, const char *pcString2 )
 	xTaskResumeAll();
 }
 /*-----------------------------------------------------------*/
+
+void vLogDrainStart( void )
+{
+	/* Nothing to drain, output is synchronous. */
+}
+/*-----------------------------------------------------------*/
+
+void vLogSetSink( LogSink_t pxSink )
+{
+	( void ) pxSink;
+}
+/*-----------------------------------------------------------*/
+#endif
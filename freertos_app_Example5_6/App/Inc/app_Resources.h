@@ -50,6 +50,7 @@
 #endif
 
 // ------ inclusions ---------------------------------------------------
+#include "task_Signal.h"
 
 // ------ macros -------------------------------------------------------
 
@@ -59,7 +60,7 @@
 /* Used to hold the handle of TaskTest. */
 extern TaskHandle_t xTaskButtonHandle;
 extern TaskHandle_t xTaskLedHandle;
-extern SemaphoreHandle_t SemaphoreHandle;
+extern TaskSignal_t xSignalLed;
 
 // ------ external functions declaration -------------------------------
 
@@ -62,7 +62,9 @@
 
 /* Application & Tasks includes. */
 #include "app.h"
+#include "app_Resources.h"
 #include "task_Button.h"
+#include "button_Event.h"
 #include "task_Led.h"
 
 // ------ Macros and definitions ---------------------------------------
@@ -72,9 +74,9 @@
 TaskHandle_t xTaskButtonHandle;
 TaskHandle_t xTaskLedHandle;
 
-/* Declare a variable of type SemaphoreHandle_t.  This is used to communicate
+/* Declare a variable of type TaskSignal_t.  This is used to communicate
  * button task with led task. */
-SemaphoreHandle_t SemaphoreHandle;
+TaskSignal_t xSignalLed;
 
 // ------ internal functions declaration -------------------------------
 
@@ -98,11 +100,16 @@ void appInit( void )
 	/* Print out the name of this Example. */
   	vPrintString( pcTextForMain );
 
-    /* Semaphore for communication between button and led tasks */
-	SemaphoreHandle = xSemaphoreCreateBinary();
+#if( TASK_BUTTON_EVENT_DRIVEN == 1 )
+	/* USER_Btn events, before the Task Button thread waits on them */
+	vButtonInit();
+#endif
 
-	/* Check the semaphore was created successfully */
-	configASSERT( SemaphoreHandle != NULL );
+    /* Signal for communication between button and led tasks: a binary
+     * semaphore, or the task notification of Task Led with
+     * taskSIGNAL_NOTIFY (task_Signal.h). The creation is checked by
+     * vTaskSignalCreate(). */
+	vTaskSignalCreate( &xSignalLed, 1, &xTaskLedHandle, "SemaphoreHandle" );
 
 	ptr = &LDX_Config[0];
 	/* Task Led thread at priority 1 */
@@ -0,0 +1,249 @@
+/* Copyright 2020, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_app_Example5_6
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+
+/*--------------------------------------------------------------------*-
+
+    button_Event.c (Released 2022-10)
+
+--------------------------------------------------------------------
+
+    USER_Btn EXTI driver for FreeRTOS - Event Driven System (EDS) -
+    Project for STM32F429ZI_NUCLEO_144.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+/* Project includes. */
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Standard includes. */
+#include <stdbool.h>
+
+/* Demo includes. */
+#include "supporting_Functions.h"
+#include "cycle_Counter.h"
+
+/* Application includes. */
+#include "button_Event.h"
+
+// ------ Macros and definitions ---------------------------------------
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+static void prvButtonDebounceCallback( TimerHandle_t xTimer );
+static void prvButtonLongPressCallback( TimerHandle_t xTimer );
+static void prvButtonPost( buttonEvent_t eEvent, uint32_t ulCycles );
+
+// ------ internal data definition -------------------------------------
+/* Define the strings that will be passed in as the Supporting Functions parameters.
+ * These are defined const and off the stack to ensure they remain valid when the
+ * tasks are executing. */
+const char *pcTextForButton_PressLatency	= "Task Button - press latency (us) :";
+const char *pcTextForButton_LongPress		= " - Long press\r\n";
+
+static QueueHandle_t xButtonQueue;
+static TimerHandle_t xButtonDebounceTimer;
+static TimerHandle_t xButtonLongPressTimer;
+
+/* Cycle counter at the edge that started the debounce. */
+static volatile uint32_t ulButtonEdgeCycles;
+
+/* Debounced level, only used from the timer callbacks. */
+static bool bButtonPressed = false;
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+/* Queue an event, from the timer service task. The handler is expected
+ * to keep up, a press it does not have room for is dropped. */
+static void prvButtonPost( buttonEvent_t eEvent, uint32_t ulCycles )
+{
+	buttonMsg_t xMsg = { eEvent, ulCycles };
+
+	( void ) xQueueSend( xButtonQueue, &xMsg, 0 );
+}
+
+/*------------------------------------------------------------------*/
+/* The line has settled: let its edges in again and compare the level
+ * with the last one. */
+static void prvButtonDebounceCallback( TimerHandle_t xTimer )
+{
+	bool bPressed;
+
+	( void ) xTimer;
+
+	/* Drop the bounces seen while masked, an edge from here on starts
+	 * a new debounce. */
+	__HAL_GPIO_EXTI_CLEAR_IT( USER_Btn_Pin );
+	HAL_NVIC_ClearPendingIRQ( EXTI15_10_IRQn );
+	HAL_NVIC_EnableIRQ( EXTI15_10_IRQn );
+
+	/* The NUCLEO user button reads high while pressed. */
+	bPressed = ( HAL_GPIO_ReadPin( USER_Btn_GPIO_Port, USER_Btn_Pin ) == GPIO_PIN_SET );
+	if( bPressed == bButtonPressed )
+	{
+		/* A glitch, or a press and release within the debounce time. */
+		return;
+	}
+	bButtonPressed = bPressed;
+
+	/* Commands from the timer service task must not block. */
+	if( bPressed )
+	{
+		prvButtonPost( ButtonPress, ulButtonEdgeCycles );
+		( void ) xTimerReset( xButtonLongPressTimer, 0 );
+	}
+	else
+	{
+		( void ) xTimerStop( xButtonLongPressTimer, 0 );
+		prvButtonPost( ButtonRelease, ulButtonEdgeCycles );
+	}
+}
+
+/*------------------------------------------------------------------*/
+/* Still pressed BUTTON_LONG_PRESS_MS after the press. */
+static void prvButtonLongPressCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+
+	if( bButtonPressed )
+	{
+		prvButtonPost( ButtonLongPress, ulCycleCounterGet() );
+	}
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void vButtonInit( void )
+{
+	GPIO_InitTypeDef GPIO_InitStruct = { 0 };
+
+	vCycleCounterInit();
+
+	xButtonQueue = xQueueCreate( BUTTON_QUEUE_LENGTH, sizeof( buttonMsg_t ) );
+	configASSERT( xButtonQueue != NULL );
+	vQueueAddToRegistry( xButtonQueue, "xButtonQueue" );
+
+	xButtonDebounceTimer = xTimerCreate( "Btn Debounce", pdMS_TO_TICKS( BUTTON_DEBOUNCE_MS ),
+										 pdFALSE, NULL, prvButtonDebounceCallback );
+	configASSERT( xButtonDebounceTimer != NULL );
+
+	xButtonLongPressTimer = xTimerCreate( "Btn Long", pdMS_TO_TICKS( BUTTON_LONG_PRESS_MS ),
+										  pdFALSE, NULL, prvButtonLongPressCallback );
+	configASSERT( xButtonLongPressTimer != NULL );
+
+	/* MX_GPIO_Init() only sets the rising edge, the release needs the
+	 * falling one too. */
+	GPIO_InitStruct.Pin = USER_Btn_Pin;
+	GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
+	GPIO_InitStruct.Pull = GPIO_NOPULL;
+	HAL_GPIO_Init( USER_Btn_GPIO_Port, &GPIO_InitStruct );
+
+	/* Its callback calls FromISR APIs. */
+	__HAL_GPIO_EXTI_CLEAR_IT( USER_Btn_Pin );
+	HAL_NVIC_SetPriority( EXTI15_10_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, 0 );
+	HAL_NVIC_EnableIRQ( EXTI15_10_IRQn );
+}
+
+/*------------------------------------------------------------------*/
+BaseType_t xButtonReceive( buttonMsg_t *pxMsg, TickType_t xTicksToWait )
+{
+	return xQueueReceive( xButtonQueue, pxMsg, xTicksToWait );
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulButtonLatencyUs( const buttonMsg_t *pxMsg )
+{
+	/* Unsigned difference, right across a wrap of the counter. */
+	return ( ulCycleCounterGet() - pxMsg->ulCycles ) / ( SystemCoreClock / 1000000UL );
+}
+
+/*------------------------------------------------------------------*/
+BaseType_t xButtonWaitPress( TickType_t xTicksToWait )
+{
+	buttonMsg_t xMsg;
+
+	if( xButtonReceive( &xMsg, xTicksToWait ) != pdPASS )
+	{
+		return pdFALSE;
+	}
+
+	if( xMsg.eEvent == ButtonPress )
+	{
+		vPrintStringAndNumber( pcTextForButton_PressLatency, ulButtonLatencyUs( &xMsg ) );
+		return pdTRUE;
+	}
+
+	if( xMsg.eEvent == ButtonLongPress )
+	{
+		vPrintTwoStrings( ( char * ) pcTaskGetName( NULL ), pcTextForButton_LongPress );
+	}
+	return pdFALSE;
+}
+
+/*------------------------------------------------------------------*/
+/* USER_Btn EXTI callback, from EXTI15_10_IRQHandler() */
+void HAL_GPIO_EXTI_Callback( uint16_t GPIO_Pin )
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if( GPIO_Pin != USER_Btn_Pin )
+	{
+		return;
+	}
+
+	/* Stamp the edge and keep the bounces out until the line settles. */
+	ulButtonEdgeCycles = ulCycleCounterGet();
+	HAL_NVIC_DisableIRQ( EXTI15_10_IRQn );
+
+	if( xTimerStartFromISR( xButtonDebounceTimer, &xHigherPriorityTaskWoken ) != pdPASS )
+	{
+		/* Timer queue full: leave it to the next edge. */
+		HAL_NVIC_EnableIRQ( EXTI15_10_IRQn );
+	}
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -63,6 +63,7 @@
 /* Application includes. */
 #include "app_Resources.h"
 #include "task_Button.h"
+#include "button_Event.h"
 #include "task_Led.h"
 
 // ------ Macros and definitions ---------------------------------------
@@ -101,8 +102,14 @@ void vTaskButton( void *pvParameters )
 	/* As per most tasks, this task is implemented in an infinite loop. */
 	for( ;; )
 	{
+#if( TASK_BUTTON_EVENT_DRIVEN == 1 )
+		/* Block until the button driver has a press, or while blinking
+		 * until the next 250 milliseconds are over */
+		if( xButtonWaitPress( ( lValueToSend == Blinking ) ? buttonTickCntMAX : portMAX_DELAY ) )
+#else
 		/* Check HW Button State */
 		if( HAL_GPIO_ReadPin( USER_Btn_GPIO_Port, USER_Btn_Pin ) == GPIO_PIN_SET )
+#endif
 		{
         	/* Check, Update and Print Led Flag */
 			if( lValueToSend == NotBlinking )
@@ -119,12 +126,14 @@ void vTaskButton( void *pvParameters )
 
 		if (lValueToSend == Blinking)
 		{
-			/* Release semaphore to allow blinking */
-			xSemaphoreGive(SemaphoreHandle);
+			/* Release signal to allow blinking */
+			xTaskSignalGive( &xSignalLed );
 		}
 
+#if( TASK_BUTTON_EVENT_DRIVEN == 0 )
 		/* We want this task to execute every 250 milliseconds. */
 		vTaskDelay( buttonTickCntMAX );
+#endif
 
 	}
 }
@@ -106,13 +106,13 @@ void vTaskLed( void *pvParameters )
 	/* Print out the name of this task. */
 	vPrintTwoStrings( pcTaskName, "   - is running\r\n" );
 
-	xSemaphoreTake(SemaphoreHandle, 0);
+	xTaskSignalTake( &xSignalLed, 0 );
 
 	/* As per most tasks, this task is implemented in an infinite loop. */
 	for( ;; )
 	{
-		/* Check if semaphore is available */
-		if( xSemaphoreTake(SemaphoreHandle, 0) == pdTRUE )
+		/* Check if signal is available */
+		if( xTaskSignalTake( &xSignalLed, 0 ) == pdTRUE )
 		{
 			/* Check, Update and Print Led State */
 		   	if( ptr->ledState == GPIO_PIN_RESET )
@@ -59,10 +59,12 @@
 
 /* Demo includes. */
 #include "supporting_Functions.h"
+#include "led_Pwm.h"
 
 /* Application & Tasks includes. */
 #include "app.h"
 #include "task_Button.h"
+#include "button_Event.h"
 #include "task_Led.h"
 
 // ------ Macros and definitions ---------------------------------------
@@ -98,6 +100,16 @@ void appInit( void )
 	/* Print out the name of this Example. */
   	vPrintString( pcTextForMain );
 
+#if( TASK_BUTTON_EVENT_DRIVEN == 1 )
+	/* USER_Btn events, before the Task Button thread waits on them */
+	vButtonInit();
+#endif
+
+#if( ledPWM_ENABLE == 1 )
+	/* LD1, LD2 & LD3 blinked by their timers, Task Led only sets them */
+	vLedPwmInit();
+#endif
+
 	/* The binary semaphore is created. */
 	MutexHandle = xSemaphoreCreateMutex();
 
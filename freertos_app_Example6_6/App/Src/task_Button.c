@@ -63,6 +63,7 @@
 /* Application includes. */
 #include "app_Resources.h"
 #include "task_Button.h"
+#include "button_Event.h"
 #include "task_Led.h"
 
 // ------ Macros and definitions ---------------------------------------
@@ -100,8 +101,13 @@ void vTaskButton( void *pvParameters )
 	/* As per most tasks, this task is implemented in an infinite loop. */
 	for( ;; )
 	{
+#if( TASK_BUTTON_EVENT_DRIVEN == 1 )
+		/* Block until the button driver has a press */
+		if( xButtonWaitPress( portMAX_DELAY ) )
+#else
 		/* Check HW Button State */
 		if( HAL_GPIO_ReadPin( USER_Btn_GPIO_Port, USER_Btn_Pin ) == GPIO_PIN_SET )
+#endif
 		{
 			xSemaphoreTake( MutexHandle, portMAX_DELAY);
 
@@ -117,8 +123,10 @@ void vTaskButton( void *pvParameters )
 			xSemaphoreGive( MutexHandle );
 		}
 
+#if( TASK_BUTTON_EVENT_DRIVEN == 0 )
 		/* We want this task to execute every 250 milliseconds. */
 		vTaskDelay( buttonTickCntMAX );
+#endif
 	}
 }
 
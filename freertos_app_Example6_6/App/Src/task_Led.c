@@ -59,6 +59,7 @@
 
 /* Demo includes. */
 #include "supporting_Functions.h"
+#include "led_Pwm.h"
 
 /* Application includes. */
 #include "app_Resources.h"
@@ -77,8 +78,12 @@
 const char *pcTextForTask_LDXTOn		= " - LDX turn On \r\n";
 const char *pcTextForTask_LDXTOff		= " - LDX turn Off\r\n";
 const char *pcTextForTask_BinSemTaken	= "    - Binary Semaphore was taken\r\n";
+#if( ledPWM_ENABLE == 1 )
+const char *pcTextForTask_LDXBlink		= " - LDX blink   \r\n";
+#endif
 
 #define			ledTickCntMAX		pdMS_TO_TICKS( 250UL )
+#define			ledOnUs				( 250UL * 1000UL )
 
 LDX_Config_t	LDX_Config[] 	= { { LD1_GPIO_Port, LD1_Pin, GPIO_PIN_RESET, NotBlinking, 0 },
 							  	    { LD2_GPIO_Port, LD2_Pin, GPIO_PIN_RESET, NotBlinking, 0 }, \
@@ -99,6 +104,9 @@ void vTaskLed( void *pvParameters )
 	/*  Declare & Initialize Task Function variables for argument, led, button and task */
 	LDX_Config_t * ptr = (LDX_Config_t *) pvParameters;
 	TickType_t xLastWakeTime;
+#if( ledPWM_ENABLE == 1 )
+	ledFlag_t ledFlag;
+#endif
 
 	/* The xLastWakeTime variable needs to be initialized with the current tick
 	   count. ws*/
@@ -112,6 +120,7 @@ void vTaskLed( void *pvParameters )
     /* As per most tasks, this task is implemented in an infinite loop. */
 	for( ;; )
 	{
+#if( ledPWM_ENABLE == 0 )
 		/* Check Led Flag */
 		if( ptr->ledFlag == Blinking )
 		{
@@ -129,6 +138,9 @@ void vTaskLed( void *pvParameters )
 			/* Update HW Led State */
 		   	HAL_GPIO_WritePin( ptr->LDX_GPIO_Port, ptr->LDX_Pin, ptr->ledState );
 		}
+#else
+		ledFlag = ptr->ledFlag;
+#endif
 
 		/* Check mutex */
 		xSemaphoreTake( MutexHandle, portMAX_DELAY);
@@ -137,6 +149,24 @@ void vTaskLed( void *pvParameters )
 
 		xSemaphoreGive( MutexHandle );
 
+#if( ledPWM_ENABLE == 1 )
+		/* The led timer blinks the led, update it on a new led flag only:
+		 * 250 ms on, 250 ms off or always off */
+		if( ptr->ledFlag != ledFlag )
+		{
+			if( ptr->ledFlag == Blinking )
+			{
+				vLedPwmSet( ptr->LDX_GPIO_Port, ptr->LDX_Pin, 2UL * ledOnUs, ledOnUs );
+				vPrintTwoStrings( pcTaskName, pcTextForTask_LDXBlink );
+			}
+			else
+			{
+				vLedPwmSet( ptr->LDX_GPIO_Port, ptr->LDX_Pin, 2UL * ledOnUs, 0UL );
+				vPrintTwoStrings( pcTaskName, pcTextForTask_LDXTOff );
+			}
+		}
+#endif
+
 		/* We want this task to execute exactly every 250 milliseconds. */
 		vTaskDelayUntil( &xLastWakeTime, ledTickCntMAX );
 	}
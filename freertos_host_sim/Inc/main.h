@@ -0,0 +1,187 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_host_sim
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    main.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    Stand-in for Core/Inc/main.h in the host simulation: the pin names
+    of the NUCLEO-F429ZI board and the few STM32 HAL GPIO and UART
+    calls the applications use. sim_Hal.c records every GPIO edge and
+    console byte in memory.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+#include <stddef.h>
+
+// ------ macros -------------------------------------------------------
+#define GPIO_PIN_0					((uint16_t)0x0001)
+#define GPIO_PIN_1					((uint16_t)0x0002)
+#define GPIO_PIN_2					((uint16_t)0x0004)
+#define GPIO_PIN_3					((uint16_t)0x0008)
+#define GPIO_PIN_4					((uint16_t)0x0010)
+#define GPIO_PIN_5					((uint16_t)0x0020)
+#define GPIO_PIN_6					((uint16_t)0x0040)
+#define GPIO_PIN_7					((uint16_t)0x0080)
+#define GPIO_PIN_8					((uint16_t)0x0100)
+#define GPIO_PIN_9					((uint16_t)0x0200)
+#define GPIO_PIN_10					((uint16_t)0x0400)
+#define GPIO_PIN_11					((uint16_t)0x0800)
+#define GPIO_PIN_12					((uint16_t)0x1000)
+#define GPIO_PIN_13					((uint16_t)0x2000)
+#define GPIO_PIN_14					((uint16_t)0x4000)
+#define GPIO_PIN_15					((uint16_t)0x8000)
+
+/* Pin modes of HAL_GPIO_Init(), with the HAL values. */
+#define GPIO_MODE_INPUT				0x00000000U
+#define GPIO_MODE_OUTPUT_PP			0x00000001U
+#define GPIO_MODE_IT_RISING			0x10110000U
+#define GPIO_MODE_IT_FALLING		0x10210000U
+#define GPIO_MODE_IT_RISING_FALLING	0x10310000U
+
+#define GPIO_NOPULL					0x00000000U
+
+/* What the HAL macro writes to EXTI->PR. */
+#define __HAL_GPIO_EXTI_CLEAR_IT( __EXTI_LINE__ )	vSimExtiClearIT( __EXTI_LINE__ )
+
+#define simGPIO_PORTS				8
+
+#define GPIOA						( &xSimGpio[ 0 ] )
+#define GPIOB						( &xSimGpio[ 1 ] )
+#define GPIOC						( &xSimGpio[ 2 ] )
+#define GPIOD						( &xSimGpio[ 3 ] )
+#define GPIOE						( &xSimGpio[ 4 ] )
+#define GPIOF						( &xSimGpio[ 5 ] )
+#define GPIOG						( &xSimGpio[ 6 ] )
+#define GPIOH						( &xSimGpio[ 7 ] )
+
+/* Board pins (Core/Inc/main.h). */
+#define USER_Btn_Pin				GPIO_PIN_13
+#define USER_Btn_GPIO_Port			GPIOC
+#define LD1_Pin						GPIO_PIN_0
+#define LD1_GPIO_Port				GPIOB
+#define LD2_Pin						GPIO_PIN_7
+#define LD2_GPIO_Port				GPIOB
+#define LD3_Pin						GPIO_PIN_14
+#define LD3_GPIO_Port				GPIOB
+
+// ------ typedef ------------------------------------------------------
+typedef enum
+{
+	HAL_OK       = 0x00U,
+	HAL_ERROR    = 0x01U,
+	HAL_BUSY     = 0x02U,
+	HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+	GPIO_PIN_RESET = 0,
+	GPIO_PIN_SET
+} GPIO_PinState;
+
+/* Output and input data registers of a simulated port. */
+typedef struct
+{
+	volatile uint32_t IDR;
+	volatile uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+	uint32_t Pin;
+	uint32_t Mode;
+	uint32_t Pull;
+	uint32_t Speed;
+	uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+typedef struct
+{
+	void *Instance;
+} UART_HandleTypeDef;
+
+/* Interrupts the simulation can raise (device numbering). */
+typedef enum
+{
+	EXTI15_10_IRQn = 40
+} IRQn_Type;
+
+// ------ external data declaration ------------------------------------
+extern GPIO_TypeDef xSimGpio[ simGPIO_PORTS ];
+
+// ------ external functions declaration -------------------------------
+void HAL_GPIO_Init( GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init );
+GPIO_PinState HAL_GPIO_ReadPin( GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin );
+void HAL_GPIO_WritePin( GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState );
+void HAL_GPIO_TogglePin( GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin );
+
+HAL_StatusTypeDef HAL_UART_Transmit( UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout );
+
+void HAL_NVIC_SetPriority( IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority );
+void HAL_NVIC_EnableIRQ( IRQn_Type IRQn );
+void HAL_NVIC_DisableIRQ( IRQn_Type IRQn );
+void HAL_NVIC_ClearPendingIRQ( IRQn_Type IRQn );
+
+/* USER_Btn is an EXTI rising edge input (MX_GPIO_Init()) on every project,
+ * HAL_GPIO_Init() may move it to the other edges. */
+void HAL_GPIO_EXTI_IRQHandler( uint16_t GPIO_Pin );
+void vSimExtiClearIT( uint16_t GPIO_Pin );
+void HAL_GPIO_EXTI_Callback( uint16_t GPIO_Pin );
+void EXTI15_10_IRQHandler( void );
+
+uint32_t HAL_GetTick( void );
+void Error_Handler( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MAIN_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
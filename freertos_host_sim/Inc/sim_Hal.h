@@ -0,0 +1,112 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_host_sim
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    sim_Hal.h (Released 2022-06)
+
+  --------------------------------------------------------------------
+
+    This is the Host Simulation HAL Header file.
+
+    Recorders for the GPIO and console stubs, and the scripted user
+    button.
+
+-*--------------------------------------------------------------------*/
+
+
+#ifndef __SIM_HAL_H
+#define __SIM_HAL_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+// ------ inclusions ---------------------------------------------------
+#include <stdint.h>
+#include <stddef.h>
+
+// ------ macros -------------------------------------------------------
+#ifndef simGPIO_EDGE_COUNT
+	#define simGPIO_EDGE_COUNT		( 64 * 1024 )
+#endif
+
+#ifndef simCONSOLE_SIZE
+	#define simCONSOLE_SIZE			( 1024 * 1024 )
+#endif
+
+#ifndef simBUTTON_PRESS_COUNT
+	#define simBUTTON_PRESS_COUNT	64
+#endif
+
+// ------ typedef ------------------------------------------------------
+typedef struct
+{
+	uint32_t ulTick;
+	uint8_t  ucPort;	/* 0 = GPIOA ... */
+	uint8_t  ucPin;		/* 0 .. 15 */
+	uint8_t  ucLevel;
+} SimGpioEdge_t;
+
+// ------ external data declaration ------------------------------------
+
+// ------ external functions declaration -------------------------------
+
+/* Copy console output to stdout as well as to memory. */
+void vSimHalInit( int bEcho );
+
+/* Hold USER_Btn pressed from tick ulStart for ulLength ticks. */
+void vSimButtonAddPress( uint32_t ulStart, uint32_t ulLength );
+
+/* Called on the tick thread in interrupt context. */
+void vSimHalTickIsr( void );
+
+/* Flash region image: kept in pcFile when not NULL, and a power cut
+ * during write number ulCutWrite (1 = first, 0 = never). */
+void vSimFlashOpen( const char *pcFile, uint32_t ulCutWrite );
+void vSimFlashGetStats( uint32_t *pulWrites, uint32_t *pulErases );
+
+/* Recorded data; the counters tell how much did not fit. */
+size_t xSimGetGpioEdges( const SimGpioEdge_t **ppxEdges, uint32_t *pulLost );
+size_t xSimGetConsole( const char **ppcData, uint32_t *pulLost );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SIM_HAL_H */
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
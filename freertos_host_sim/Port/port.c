@@ -0,0 +1,640 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_host_sim
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    port.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    FreeRTOS port for the host (POSIX threads) simulation.
+
+    - Each task runs on its own pthread. A thread only executes while it
+      owns the "CPU": it is the thread of pxCurrentTCB and its bRun flag
+      is set. Context switches hand the flag over under xPortLock.
+    - xPortLock is also the interrupt mask: a critical section holds it,
+      so the tick thread (and any simulated interrupt) only runs when no
+      task is inside one.
+    - Preemption: when an interrupt makes a switch necessary the tick
+      thread sends SIGUSR1 to the running thread, whose handler yields.
+      SIGUSR1 is blocked while a thread holds or waits for xPortLock.
+
+    The FreeRTOS allocated stack is only used to store the Thread_t, the
+    task code runs on the pthread stack, so stack high-water marks are
+    not meaningful in the simulation.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define portSIM_PREEMPT_SIGNAL		SIGUSR1
+#define portSIM_THREAD_STACK		( 256 * 1024 )
+
+/* Task threads run niced so the host scheduler wakes the tick thread on
+ * time even when a task busy-loops (as in Example2_6). */
+#define portSIM_TASK_NICE			10
+
+/* In virtual time the tick thread checks for idle this often (ns). */
+#define portSIM_IDLE_POLL_NS		20000L
+
+// ------ internal data declaration ------------------------------------
+typedef struct
+{
+	pthread_t xThread;
+	pthread_cond_t xCond;
+	TaskFunction_t pxCode;
+	void *pvParameters;
+	BaseType_t bRun;
+	BaseType_t bDying;
+} Thread_t;
+
+// ------ internal functions declaration -------------------------------
+static void prvLock( void );
+static void prvUnlock( void );
+static Thread_t *prvThreadOf( TaskHandle_t xTask );
+static void prvSwitchTo( Thread_t *pxFrom, Thread_t *pxTo );
+static void prvSwitchContext( void );
+static void *prvThreadEntry( void *pvArg );
+static void *prvTickThread( void *pvArg );
+static void prvPreemptHandler( int iSignal );
+static void prvSleepNs( long lNs );
+static void prvAddNs( struct timespec *pxTime, long lNs );
+static BaseType_t prvBefore( const struct timespec *pxNow, const struct timespec *pxDeadline );
+static int64_t prvHostNs( void );
+
+// ------ internal data definition -------------------------------------
+static pthread_mutex_t xPortLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t xEndCond = PTHREAD_COND_INITIALIZER;
+static sigset_t xPreemptSet;
+
+static volatile UBaseType_t uxCriticalNesting = 0;
+static volatile BaseType_t xPendingYield = pdFALSE;
+static volatile BaseType_t xInterruptsDisabled = pdFALSE;
+static volatile BaseType_t xSchedulerEnded = pdFALSE;
+
+/* Set on the tick thread while it runs interrupt code. */
+static __thread BaseType_t xInsideInterrupt = pdFALSE;
+static BaseType_t xIsrYieldPending = pdFALSE;
+
+/* SIGUSR1 sent and the running task has not switched yet. */
+static volatile BaseType_t xPreemptPending = pdFALSE;
+
+static uint32_t ulSimSpeed = 1;
+static uint32_t ulSimRunTicks = 0;
+static volatile uint32_t ulSimTicks = 0;
+static volatile uint32_t ulSimIdleTicks = 0;
+static PortSimIsr_t pxSimTickIsr = NULL;
+
+/* Host time of the last tick, for ullPortSimGetTimeNs(). ulSimTimeSeq is
+ * odd while the tick thread updates it together with ulSimTicks. */
+static volatile uint32_t ulSimTimeSeq = 0;
+static volatile int64_t llSimTickHostNs = 0;
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+static void prvLock( void )
+{
+	pthread_sigmask( SIG_BLOCK, &xPreemptSet, NULL );
+	pthread_mutex_lock( &xPortLock );
+}
+
+/*------------------------------------------------------------------*/
+static void prvUnlock( void )
+{
+	pthread_mutex_unlock( &xPortLock );
+	pthread_sigmask( SIG_UNBLOCK, &xPreemptSet, NULL );
+}
+
+/*------------------------------------------------------------------*/
+static Thread_t *prvThreadOf( TaskHandle_t xTask )
+{
+	/* pxTopOfStack is the first member of the TCB and points to the
+	 * Thread_t stored by pxPortInitialiseStack(). */
+	return ( Thread_t * ) *( StackType_t ** ) xTask;
+}
+
+/*------------------------------------------------------------------*/
+static void prvSwitchTo( Thread_t *pxFrom, Thread_t *pxTo )
+{
+	/* Called with xPortLock held. Give the CPU to pxTo and wait until
+	 * someone gives it back. */
+	if( pxFrom == pxTo )
+	{
+		return;
+	}
+
+	pxFrom->bRun = pdFALSE;
+	pxTo->bRun = pdTRUE;
+	pthread_cond_signal( &pxTo->xCond );
+
+	while( ( pxFrom->bRun == pdFALSE ) && ( pxFrom->bDying == pdFALSE ) )
+	{
+		pthread_cond_wait( &pxFrom->xCond, &xPortLock );
+	}
+
+	if( pxFrom->bDying != pdFALSE )
+	{
+		prvUnlock();
+		pthread_exit( NULL );
+	}
+}
+
+/*------------------------------------------------------------------*/
+static void prvSwitchContext( void )
+{
+	/* Called with xPortLock held from the running task thread. */
+	Thread_t *pxFrom = prvThreadOf( xTaskGetCurrentTaskHandle() );
+
+	xPendingYield = pdFALSE;
+	xPreemptPending = pdFALSE;
+	vTaskSwitchContext();
+	prvSwitchTo( pxFrom, prvThreadOf( xTaskGetCurrentTaskHandle() ) );
+}
+
+/*------------------------------------------------------------------*/
+static void *prvThreadEntry( void *pvArg )
+{
+	Thread_t *pxThread = ( Thread_t * ) pvArg;
+
+	( void ) setpriority( PRIO_PROCESS, ( id_t ) syscall( SYS_gettid ), portSIM_TASK_NICE );
+
+	/* Wait for the first time this task is scheduled. */
+	prvLock();
+	while( ( pxThread->bRun == pdFALSE ) && ( pxThread->bDying == pdFALSE ) )
+	{
+		pthread_cond_wait( &pxThread->xCond, &xPortLock );
+	}
+	if( pxThread->bDying != pdFALSE )
+	{
+		prvUnlock();
+		return NULL;
+	}
+	prvUnlock();
+
+	pxThread->pxCode( pxThread->pvParameters );
+
+	/* Tasks must not return. */
+	configASSERT( 0 );
+	return NULL;
+}
+
+/*------------------------------------------------------------------*/
+static void prvSleepNs( long lNs )
+{
+	struct timespec xDelay = { lNs / 1000000000L, lNs % 1000000000L };
+
+	while( ( nanosleep( &xDelay, &xDelay ) != 0 ) && ( errno == EINTR ) )
+	{
+	}
+}
+
+/*------------------------------------------------------------------*/
+static void prvAddNs( struct timespec *pxTime, long lNs )
+{
+	pxTime->tv_nsec += lNs;
+	while( pxTime->tv_nsec >= 1000000000L )
+	{
+		pxTime->tv_nsec -= 1000000000L;
+		pxTime->tv_sec++;
+	}
+}
+
+/*------------------------------------------------------------------*/
+static BaseType_t prvBefore( const struct timespec *pxNow, const struct timespec *pxDeadline )
+{
+	return ( pxNow->tv_sec < pxDeadline->tv_sec ) ||
+		   ( ( pxNow->tv_sec == pxDeadline->tv_sec ) && ( pxNow->tv_nsec < pxDeadline->tv_nsec ) );
+}
+
+/*------------------------------------------------------------------*/
+static int64_t prvHostNs( void )
+{
+	struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( int64_t ) xNow.tv_sec * 1000000000LL + xNow.tv_nsec;
+}
+
+/*------------------------------------------------------------------*/
+static void *prvTickThread( void *pvArg )
+{
+	const long lTickNs = 1000000000L / configTICK_RATE_HZ;
+	TaskHandle_t xIdle = xTaskGetIdleTaskHandle();
+	struct timespec xDeadline, xNow;
+
+	( void ) pvArg;
+	pthread_sigmask( SIG_BLOCK, &xPreemptSet, NULL );
+	clock_gettime( CLOCK_MONOTONIC, &xDeadline );
+
+	for( ;; )
+	{
+		if( ulSimSpeed != 0 )
+		{
+			/* Absolute deadlines, so the simulated clock does not drift. */
+			prvAddNs( &xDeadline, lTickNs / ( long ) ulSimSpeed );
+			while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &xDeadline, NULL ) == EINTR )
+			{
+			}
+		}
+		else
+		{
+			/* Virtual time: skip ahead while only the idle task is ready,
+			 * but never run slower than real time. Not while the idle task
+			 * has the scheduler suspended (tickless idle), the ticks would
+			 * only pile up as pended ticks. */
+			clock_gettime( CLOCK_MONOTONIC, &xDeadline );
+			prvAddNs( &xDeadline, lTickNs );
+			do
+			{
+				if( ( xTaskGetCurrentTaskHandle() == xIdle ) && ( xPreemptPending == pdFALSE ) &&
+					( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING ) )
+				{
+					break;
+				}
+				prvSleepNs( portSIM_IDLE_POLL_NS );
+				clock_gettime( CLOCK_MONOTONIC, &xNow );
+			} while( prvBefore( &xNow, &xDeadline ) );
+		}
+
+		pthread_mutex_lock( &xPortLock );
+
+		if( xInterruptsDisabled == pdFALSE )
+		{
+			if( xTaskGetCurrentTaskHandle() == xIdle )
+			{
+				ulSimIdleTicks++;
+			}
+
+			xInsideInterrupt = pdTRUE;
+			if( xTaskIncrementTick() != pdFALSE )
+			{
+				xIsrYieldPending = pdTRUE;
+			}
+			if( pxSimTickIsr != NULL )
+			{
+				pxSimTickIsr();
+			}
+			xInsideInterrupt = pdFALSE;
+
+			if( xIsrYieldPending != pdFALSE )
+			{
+				xIsrYieldPending = pdFALSE;
+				xPreemptPending = pdTRUE;
+				pthread_kill( prvThreadOf( xTaskGetCurrentTaskHandle() )->xThread, portSIM_PREEMPT_SIGNAL );
+			}
+
+			__atomic_add_fetch( &ulSimTimeSeq, 1UL, __ATOMIC_SEQ_CST );
+			ulSimTicks++;
+			llSimTickHostNs = prvHostNs();
+			__atomic_add_fetch( &ulSimTimeSeq, 1UL, __ATOMIC_SEQ_CST );
+
+			if( ( ulSimRunTicks != 0 ) && ( ulSimTicks >= ulSimRunTicks ) )
+			{
+				xInterruptsDisabled = pdTRUE;
+				xSchedulerEnded = pdTRUE;
+				pthread_cond_signal( &xEndCond );
+				pthread_mutex_unlock( &xPortLock );
+				return NULL;
+			}
+		}
+
+		pthread_mutex_unlock( &xPortLock );
+	}
+}
+
+/*------------------------------------------------------------------*/
+static void prvPreemptHandler( int iSignal )
+{
+	( void ) iSignal;
+
+	/* Only delivered while the thread is not holding xPortLock. */
+	prvLock();
+	if( xSchedulerEnded == pdFALSE )
+	{
+		prvSwitchContext();
+	}
+	prvUnlock();
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+	Thread_t *pxThread;
+	pthread_attr_t xAttr;
+
+	/* Keep the Thread_t at the top of the FreeRTOS stack. */
+	pxThread = ( Thread_t * ) ( ( ( uintptr_t ) pxTopOfStack - sizeof( Thread_t ) ) & ~( uintptr_t ) portBYTE_ALIGNMENT_MASK );
+	memset( pxThread, 0, sizeof( Thread_t ) );
+	pxThread->pxCode = pxCode;
+	pxThread->pvParameters = pvParameters;
+	pthread_cond_init( &pxThread->xCond, NULL );
+
+	pthread_attr_init( &xAttr );
+	pthread_attr_setstacksize( &xAttr, portSIM_THREAD_STACK );
+	configASSERT( pthread_create( &pxThread->xThread, &xAttr, prvThreadEntry, pxThread ) == 0 );
+	pthread_attr_destroy( &xAttr );
+
+	return ( StackType_t * ) pxThread;
+}
+
+/*------------------------------------------------------------------*/
+BaseType_t xPortStartScheduler( void )
+{
+	pthread_t xTickThread;
+	struct sigaction xAction;
+	Thread_t *pxFirst;
+
+	memset( &xAction, 0, sizeof( xAction ) );
+	xAction.sa_handler = prvPreemptHandler;
+	sigemptyset( &xAction.sa_mask );
+	sigaction( portSIM_PREEMPT_SIGNAL, &xAction, NULL );
+
+	prvLock();
+
+	xInterruptsDisabled = pdFALSE;
+	uxCriticalNesting = 0;
+	configASSERT( pthread_create( &xTickThread, NULL, prvTickThread, NULL ) == 0 );
+
+	/* Start the first task and wait for the end of the simulation. */
+	pxFirst = prvThreadOf( xTaskGetCurrentTaskHandle() );
+	pxFirst->bRun = pdTRUE;
+	pthread_cond_signal( &pxFirst->xCond );
+
+	while( xSchedulerEnded == pdFALSE )
+	{
+		pthread_cond_wait( &xEndCond, &xPortLock );
+	}
+
+	/* Tasks stay parked; the caller reports and exits the process. */
+	pthread_mutex_unlock( &xPortLock );
+	pthread_join( xTickThread, NULL );
+
+	return 0;
+}
+
+/*------------------------------------------------------------------*/
+void vPortEndScheduler( void )
+{
+	/* Called from a task: wake up vTaskStartScheduler() and park. */
+	prvLock();
+	xInterruptsDisabled = pdTRUE;
+	xSchedulerEnded = pdTRUE;
+	pthread_cond_signal( &xEndCond );
+	prvUnlock();
+
+	for( ;; )
+	{
+		pause();
+	}
+}
+
+/*------------------------------------------------------------------*/
+void vPortYield( void )
+{
+	if( xInsideInterrupt != pdFALSE )
+	{
+		xIsrYieldPending = pdTRUE;
+	}
+	else if( uxCriticalNesting > 0 )
+	{
+		/* Like PendSV, taken when the critical section ends. */
+		xPendingYield = pdTRUE;
+	}
+	else
+	{
+		prvLock();
+		prvSwitchContext();
+		prvUnlock();
+	}
+}
+
+/*------------------------------------------------------------------*/
+void vPortYieldFromISR( BaseType_t xSwitchRequired )
+{
+	if( xSwitchRequired != pdFALSE )
+	{
+		vPortYield();
+	}
+}
+
+/*------------------------------------------------------------------*/
+void vPortEnterCritical( void )
+{
+	if( xInsideInterrupt != pdFALSE )
+	{
+		/* Interrupt code already holds the lock. */
+		return;
+	}
+
+	if( uxCriticalNesting == 0 )
+	{
+		prvLock();
+	}
+	uxCriticalNesting++;
+}
+
+/*------------------------------------------------------------------*/
+void vPortExitCritical( void )
+{
+	if( xInsideInterrupt != pdFALSE )
+	{
+		return;
+	}
+
+	configASSERT( uxCriticalNesting > 0 );
+	uxCriticalNesting--;
+
+	if( uxCriticalNesting == 0 )
+	{
+		if( ( xPendingYield != pdFALSE ) && ( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED ) )
+		{
+			prvSwitchContext();
+		}
+		prvUnlock();
+	}
+}
+
+/*------------------------------------------------------------------*/
+void vPortDisableInterrupts( void )
+{
+	/* Only used by the kernel before the scheduler starts and by
+	 * configASSERT(); ticks are simply not delivered. */
+	xInterruptsDisabled = pdTRUE;
+}
+
+/*------------------------------------------------------------------*/
+void vPortEnableInterrupts( void )
+{
+	xInterruptsDisabled = pdFALSE;
+}
+
+/*------------------------------------------------------------------*/
+UBaseType_t uxPortSetInterruptMask( void )
+{
+	if( xInsideInterrupt != pdFALSE )
+	{
+		return 0;
+	}
+
+	/* Task code using the FROM_ISR forms behaves as a critical section. */
+	vPortEnterCritical();
+	return 1;
+}
+
+/*------------------------------------------------------------------*/
+void vPortClearInterruptMask( UBaseType_t uxMask )
+{
+	if( uxMask != 0 )
+	{
+		vPortExitCritical();
+	}
+}
+
+/*------------------------------------------------------------------*/
+BaseType_t xPortIsInsideInterrupt( void )
+{
+	return xInsideInterrupt;
+}
+
+/*------------------------------------------------------------------*/
+void vPortCleanUpTCB( void *pxTCB )
+{
+	Thread_t *pxThread = prvThreadOf( ( TaskHandle_t ) pxTCB );
+
+	/* The task deleted itself earlier and is parked in prvSwitchTo(). */
+	prvLock();
+	pxThread->bDying = pdTRUE;
+	pthread_cond_signal( &pxThread->xCond );
+	prvUnlock();
+
+	pthread_join( pxThread->xThread, NULL );
+	pthread_cond_destroy( &pxThread->xCond );
+}
+
+/*------------------------------------------------------------------*/
+void vPortSimSetSpeed( uint32_t ulSpeed )
+{
+	ulSimSpeed = ulSpeed;
+}
+
+/*------------------------------------------------------------------*/
+void vPortSimSetTickIsr( PortSimIsr_t pxIsr )
+{
+	pxSimTickIsr = pxIsr;
+}
+
+/*------------------------------------------------------------------*/
+void vPortSimSetRunTicks( uint32_t ulTicks )
+{
+	ulSimRunTicks = ulTicks;
+}
+
+/*------------------------------------------------------------------*/
+void vPortSimGetTicks( uint32_t *pulTicks, uint32_t *pulIdleTicks )
+{
+	*pulTicks = ulSimTicks;
+	*pulIdleTicks = ulSimIdleTicks;
+}
+
+/*------------------------------------------------------------------*/
+__attribute__(( constructor )) static void prvPortSimInit( void )
+{
+	sigemptyset( &xPreemptSet );
+	sigaddset( &xPreemptSet, portSIM_PREEMPT_SIGNAL );
+
+	/* The main thread never takes part in preemption. */
+	pthread_sigmask( SIG_BLOCK, &xPreemptSet, NULL );
+
+	/* Tick 0 starts now, so time stamps taken by appInit() come first. */
+	llSimTickHostNs = prvHostNs();
+}
+
+/*------------------------------------------------------------------*/
+uint64_t ullPortSimGetTimeNs( void )
+{
+	const int64_t llTickNs = 1000000000LL / configTICK_RATE_HZ;
+	int64_t llSince;
+	uint32_t ulSeq, ulTicks;
+
+	do
+	{
+		ulSeq = __atomic_load_n( &ulSimTimeSeq, __ATOMIC_SEQ_CST );
+		ulTicks = ulSimTicks;
+		llSince = prvHostNs() - llSimTickHostNs;
+	} while( ( ( ulSeq & 1UL ) != 0UL ) || ( ulSeq != __atomic_load_n( &ulSimTimeSeq, __ATOMIC_SEQ_CST ) ) );
+
+	/* Host time since the tick, at the simulation speed, never reaching
+	 * the next tick: skipped (virtual) ticks take no host time at all. */
+	if( ulSimSpeed > 1 )
+	{
+		llSince *= ( int64_t ) ulSimSpeed;
+	}
+	if( llSince < 0 )
+	{
+		llSince = 0;
+	}
+	if( llSince >= llTickNs )
+	{
+		llSince = llTickNs - 1;
+	}
+
+	return ( uint64_t ) ulTicks * ( uint64_t ) llTickNs + ( uint64_t ) llSince;
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
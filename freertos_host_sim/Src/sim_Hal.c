@@ -0,0 +1,751 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_host_sim
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    sim_Hal.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    STM32 HAL stubs for the host simulation.
+
+    GPIO writes update the simulated output register and record an edge
+    (tick, port, pin, level) whenever a level changes. A GPIO batch
+    (gpio_Batch, SIM_GPIO_BATCH when the project has it) is committed
+    under one lock, as the BSRR store does. Console output,
+    whether from printf() or from the log drain task, ends up in
+    xUartTxWrite() and is stored in memory. The recorders are guarded
+    with the FROM_ISR critical section, which the port maps to its
+    interrupt lock, so they may be used from tasks and from interrupts
+    without a task ever being preempted while holding them.
+
+    The scripted user button is sampled on each tick; an edge the EXTI
+    line 13 triggers on (rising, unless HAL_GPIO_Init() says otherwise)
+    sets its pending bit and, while the application has EXTI15_10_IRQn
+    enabled, runs its handler from the tick interrupt.
+
+    The RTC calendar (rtc_Clock) starts at rtcCLOCK_START_EPOCH and
+    follows the simulated tick count.
+
+    The flash region (flash_Region) is an image in memory, kept in a
+    file when one is given so it survives from one run to the next.
+    Writes only clear bits, as on the flash. A power cut can be set
+    on the n-th write: a little over half of it is written and the
+    process ends.
+
+    The led timers (led_Pwm) are played on the GPIO output from the
+    tick interrupt, so their edges are recorded like any other. A
+    period shorter than two ticks cannot be seen at the tick rate; the
+    led is then held on when it is on for at least half of the period
+    (brightness) and off otherwise.
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Demo includes. */
+#include "uart_Tx.h"
+#include "low_Power.h"
+#include "rtc_Clock.h"
+#include "cycle_Counter.h"
+#include "flash_Region.h"
+#include "led_Pwm.h"
+#if( SIM_GPIO_BATCH == 1 )
+	#include "gpio_Batch.h"
+#endif
+#include "sim_Hal.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define simLED_PWM_COUNT			3
+#define simTICK_US					( 1000000UL / configTICK_RATE_HZ )
+
+// ------ internal data declaration ------------------------------------
+typedef struct
+{
+	uint32_t ulStart;
+	uint32_t ulEnd;
+} SimPress_t;
+
+typedef struct
+{
+	GPIO_TypeDef *pxPort;
+	uint16_t usPin;
+	uint32_t ulPeriodUs;
+	uint32_t ulOnUs;
+	uint32_t ulStart;
+} SimLedPwm_t;
+
+// ------ internal functions declaration -------------------------------
+static void prvSimRecordEdges( GPIO_TypeDef *GPIOx, uint32_t ulOld, uint32_t ulNew );
+static uint32_t prvSimTick( void );
+static void prvSimFlashSave( uint32_t ulOffset, size_t xLength );
+static void prvSimLedPwmOutput( uint32_t ulTick );
+
+// ------ internal data definition -------------------------------------
+static SimGpioEdge_t xSimEdge[ simGPIO_EDGE_COUNT ];
+static size_t xSimEdgeCount = 0;
+static uint32_t ulSimEdgeLost = 0;
+
+static char cSimConsole[ simCONSOLE_SIZE ];
+static size_t xSimConsoleCount = 0;
+static uint32_t ulSimConsoleLost = 0;
+static int bSimEcho = 1;
+
+static SimPress_t xSimPress[ simBUTTON_PRESS_COUNT ];
+static size_t xSimPressCount = 0;
+
+static UartTxStats_t xSimUartStats;
+
+/* EXTI pending bits and trigger edges, and whether EXTI15_10_IRQn is
+ * enabled. MX_GPIO_Init() sets USER_Btn to the rising edge. */
+static volatile uint32_t ulSimExtiPending = 0;
+static volatile uint32_t ulSimExtiRising = USER_Btn_Pin;
+static volatile uint32_t ulSimExtiFalling = 0;
+static volatile int bSimExtiEnabled = 0;
+
+/* Calendar at tick 0, moved by vRtcClockSetEpoch(). */
+static uint32_t ulSimRtcBase = rtcCLOCK_START_EPOCH;
+
+/* Led timers, only driving the outputs after vLedPwmInit(). */
+static SimLedPwm_t xSimLedPwm[ simLED_PWM_COUNT ] =
+{
+	{ LD1_GPIO_Port, LD1_Pin, 0, 0, 0 },
+	{ LD2_GPIO_Port, LD2_Pin, 0, 0, 0 },
+	{ LD3_GPIO_Port, LD3_Pin, 0, 0, 0 }
+};
+static volatile int bSimLedPwm = 0;
+
+/* Flash region image, its file, and the write with the power cut. */
+static uint8_t ucSimFlash[ flashREGION_SECTORS * flashREGION_SECTOR_SIZE ];
+static FILE *pxSimFlashFile = NULL;
+static uint32_t ulSimFlashWrites = 0, ulSimFlashErases = 0, ulSimFlashCut = 0;
+
+// ------ external data definition -------------------------------------
+GPIO_TypeDef xSimGpio[ simGPIO_PORTS ];
+UART_HandleTypeDef huart3;
+uint32_t SystemCoreClock = 180000000UL;
+
+/* Bounds of .rodata the linker script gives log_Token.c. The range is
+ * empty on the host, so token mode queues every string as text. */
+const char _srodata[ 1 ] = { 0 };
+extern const char _erodata[ 1 ] __attribute__(( alias( "_srodata" ) ));
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+/* Write a part of the flash image through to its file, if any */
+static void prvSimFlashSave( uint32_t ulOffset, size_t xLength )
+{
+	if( pxSimFlashFile != NULL )
+	{
+		fseek( pxSimFlashFile, ( long ) ulOffset, SEEK_SET );
+		fwrite( &ucSimFlash[ ulOffset ], 1, xLength, pxSimFlashFile );
+		fflush( pxSimFlashFile );
+	}
+}
+
+/*------------------------------------------------------------------*/
+static uint32_t prvSimTick( void )
+{
+	return ( uint32_t ) xTaskGetTickCount();
+}
+
+/*------------------------------------------------------------------*/
+static void prvSimRecordEdges( GPIO_TypeDef *GPIOx, uint32_t ulOld, uint32_t ulNew )
+{
+	/* Called with the recorders locked. */
+	uint32_t ulChanged = ( ulOld ^ ulNew ) & 0xFFFFUL;
+	uint8_t ucPin;
+
+	for( ucPin = 0; ulChanged != 0; ucPin++, ulChanged >>= 1 )
+	{
+		if( ( ulChanged & 1UL ) == 0 )
+		{
+			continue;
+		}
+		if( xSimEdgeCount < simGPIO_EDGE_COUNT )
+		{
+			xSimEdge[ xSimEdgeCount ].ulTick = prvSimTick();
+			xSimEdge[ xSimEdgeCount ].ucPort = ( uint8_t ) ( GPIOx - xSimGpio );
+			xSimEdge[ xSimEdgeCount ].ucPin = ucPin;
+			xSimEdge[ xSimEdgeCount ].ucLevel = ( uint8_t ) ( ( ulNew >> ucPin ) & 1UL );
+			xSimEdgeCount++;
+		}
+		else
+		{
+			ulSimEdgeLost++;
+		}
+	}
+}
+
+/*------------------------------------------------------------------*/
+static void prvSimLedPwmOutput( uint32_t ulTick )
+{
+	SimLedPwm_t *pxLed;
+	uint32_t ulPhase;
+	GPIO_PinState xLevel;
+	size_t x;
+
+	for( x = 0; x < simLED_PWM_COUNT; x++ )
+	{
+		pxLed = &xSimLedPwm[ x ];
+		if( ( pxLed->ulOnUs == 0 ) || ( pxLed->ulPeriodUs == 0 ) )
+		{
+			xLevel = GPIO_PIN_RESET;
+		}
+		else if( pxLed->ulOnUs >= pxLed->ulPeriodUs )
+		{
+			xLevel = GPIO_PIN_SET;
+		}
+		else if( pxLed->ulPeriodUs < ( 2UL * simTICK_US ) )
+		{
+			xLevel = ( ( 2UL * pxLed->ulOnUs ) >= pxLed->ulPeriodUs ) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+		}
+		else
+		{
+			ulPhase = ( ( ulTick - pxLed->ulStart ) * simTICK_US ) % pxLed->ulPeriodUs;
+			xLevel = ( ulPhase < pxLed->ulOnUs ) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+		}
+		HAL_GPIO_WritePin( pxLed->pxPort, pxLed->usPin, xLevel );
+	}
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+void HAL_GPIO_Init( GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init )
+{
+	UBaseType_t uxSaved;
+	uint32_t ulPin = GPIO_Init->Pin;
+
+	/* Only the EXTI trigger edges are simulated. */
+	( void ) GPIOx;
+
+	uxSaved = taskENTER_CRITICAL_FROM_ISR();
+	ulSimExtiRising &= ~ulPin;
+	ulSimExtiFalling &= ~ulPin;
+	if( ( GPIO_Init->Mode & 0x10000000U ) != 0 )
+	{
+		if( ( GPIO_Init->Mode & 0x00100000U ) != 0 )
+		{
+			ulSimExtiRising |= ulPin;
+		}
+		if( ( GPIO_Init->Mode & 0x00200000U ) != 0 )
+		{
+			ulSimExtiFalling |= ulPin;
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSaved );
+}
+
+/*------------------------------------------------------------------*/
+GPIO_PinState HAL_GPIO_ReadPin( GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin )
+{
+	return ( ( GPIOx->IDR & GPIO_Pin ) != 0 ) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+/*------------------------------------------------------------------*/
+void HAL_GPIO_WritePin( GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState )
+{
+	UBaseType_t uxSaved;
+	uint32_t ulOld;
+
+	uxSaved = taskENTER_CRITICAL_FROM_ISR();
+	ulOld = GPIOx->ODR;
+	if( PinState != GPIO_PIN_RESET )
+	{
+		GPIOx->ODR = ulOld | GPIO_Pin;
+	}
+	else
+	{
+		GPIOx->ODR = ulOld & ~( uint32_t ) GPIO_Pin;
+	}
+	prvSimRecordEdges( GPIOx, ulOld, GPIOx->ODR );
+	taskEXIT_CRITICAL_FROM_ISR( uxSaved );
+}
+
+/*------------------------------------------------------------------*/
+void HAL_GPIO_TogglePin( GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin )
+{
+	UBaseType_t uxSaved;
+	uint32_t ulOld;
+
+	uxSaved = taskENTER_CRITICAL_FROM_ISR();
+	ulOld = GPIOx->ODR;
+	GPIOx->ODR = ulOld ^ GPIO_Pin;
+	prvSimRecordEdges( GPIOx, ulOld, GPIOx->ODR );
+	taskEXIT_CRITICAL_FROM_ISR( uxSaved );
+}
+
+#if( SIM_GPIO_BATCH == 1 )
+/*------------------------------------------------------------------*/
+void vGpioBatchCommit( const GpioBatch_t *pxBatch )
+{
+	UBaseType_t uxSaved;
+	uint32_t ulOld, ulSet, ulReset, ul;
+	GPIO_TypeDef *GPIOx;
+
+	uxSaved = taskENTER_CRITICAL_FROM_ISR();
+	for( ul = 0; ul < pxBatch->ulPorts; ul++ )
+	{
+		/* BSRR: a pin both set and reset is set. */
+		GPIOx = pxBatch->pxPort[ ul ];
+		ulSet = pxBatch->ulBsrr[ ul ] & 0xFFFFUL;
+		ulReset = ( pxBatch->ulBsrr[ ul ] >> 16 ) & ~ulSet;
+		ulOld = GPIOx->ODR;
+		GPIOx->ODR = ( ulOld | ulSet ) & ~ulReset;
+		prvSimRecordEdges( GPIOx, ulOld, GPIOx->ODR );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSaved );
+}
+#endif
+
+/*------------------------------------------------------------------*/
+HAL_StatusTypeDef HAL_UART_Transmit( UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout )
+{
+	( void ) huart;
+	( void ) Timeout;
+
+	xUartTxWrite( ( const char * ) pData, Size );
+	return HAL_OK;
+}
+
+/*------------------------------------------------------------------*/
+void HAL_NVIC_SetPriority( IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority )
+{
+	( void ) IRQn;
+	( void ) PreemptPriority;
+	( void ) SubPriority;
+}
+
+/*------------------------------------------------------------------*/
+void HAL_NVIC_EnableIRQ( IRQn_Type IRQn )
+{
+	if( IRQn == EXTI15_10_IRQn )
+	{
+		bSimExtiEnabled = 1;
+	}
+}
+
+/*------------------------------------------------------------------*/
+void HAL_NVIC_DisableIRQ( IRQn_Type IRQn )
+{
+	if( IRQn == EXTI15_10_IRQn )
+	{
+		bSimExtiEnabled = 0;
+	}
+}
+
+/*------------------------------------------------------------------*/
+void HAL_NVIC_ClearPendingIRQ( IRQn_Type IRQn )
+{
+	/* The handler only runs from the edge itself, nothing is left pending. */
+	( void ) IRQn;
+}
+
+/*------------------------------------------------------------------*/
+void vSimExtiClearIT( uint16_t GPIO_Pin )
+{
+	UBaseType_t uxSaved;
+
+	uxSaved = taskENTER_CRITICAL_FROM_ISR();
+	ulSimExtiPending &= ~( uint32_t ) GPIO_Pin;
+	taskEXIT_CRITICAL_FROM_ISR( uxSaved );
+}
+
+/*------------------------------------------------------------------*/
+void HAL_GPIO_EXTI_IRQHandler( uint16_t GPIO_Pin )
+{
+	if( ( ulSimExtiPending & GPIO_Pin ) != 0 )
+	{
+		ulSimExtiPending &= ~( uint32_t ) GPIO_Pin;
+		HAL_GPIO_EXTI_Callback( GPIO_Pin );
+	}
+}
+
+/*------------------------------------------------------------------*/
+__attribute__(( weak )) void HAL_GPIO_EXTI_Callback( uint16_t GPIO_Pin )
+{
+	( void ) GPIO_Pin;
+}
+
+/*------------------------------------------------------------------*/
+void EXTI15_10_IRQHandler( void )
+{
+	/* As in Core/Src/stm32f4xx_it.c. */
+	HAL_GPIO_EXTI_IRQHandler( USER_Btn_Pin );
+}
+
+/*------------------------------------------------------------------*/
+uint32_t HAL_GetTick( void )
+{
+	return prvSimTick();
+}
+
+/*------------------------------------------------------------------*/
+void Error_Handler( void )
+{
+	configASSERT( 0 );
+}
+
+/*------------------------------------------------------------------*/
+void vUartTxInit( void )
+{
+}
+
+/*------------------------------------------------------------------*/
+size_t xUartTxWrite( const char *pcData, size_t xLength )
+{
+	UBaseType_t uxSaved;
+	size_t xCopy;
+
+	uxSaved = taskENTER_CRITICAL_FROM_ISR();
+	xCopy = simCONSOLE_SIZE - xSimConsoleCount;
+	if( xCopy > xLength )
+	{
+		xCopy = xLength;
+	}
+	memcpy( &cSimConsole[ xSimConsoleCount ], pcData, xCopy );
+	xSimConsoleCount += xCopy;
+	ulSimConsoleLost += ( uint32_t ) ( xLength - xCopy );
+	xSimUartStats.ulBytes += ( uint32_t ) xLength;
+	xSimUartStats.ulTransfers++;
+	taskEXIT_CRITICAL_FROM_ISR( uxSaved );
+
+	/* write() rather than stdio: a task may be preempted anywhere. */
+	if( bSimEcho != 0 )
+	{
+		( void ) write( STDOUT_FILENO, pcData, xLength );
+	}
+
+	return xLength;
+}
+
+/*------------------------------------------------------------------*/
+void vUartTxGetStats( UartTxStats_t *pxStats )
+{
+	UBaseType_t uxSaved;
+
+	uxSaved = taskENTER_CRITICAL_FROM_ISR();
+	*pxStats = xSimUartStats;
+	taskEXIT_CRITICAL_FROM_ISR( uxSaved );
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulUartTxIdle( void )
+{
+	return 1UL;
+}
+
+/*------------------------------------------------------------------*/
+void vLowPowerInit( void )
+{
+}
+
+/*------------------------------------------------------------------*/
+void vLowPowerSuppressTicksAndSleep( uint32_t ulExpectedIdleTime )
+{
+	/* No STOP mode here: return and let the kernel keep ticking. The
+	 * tick thread already skips idle time in virtual time mode. */
+	( void ) ulExpectedIdleTime;
+}
+
+/*------------------------------------------------------------------*/
+void vRtcClockInit( void )
+{
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulRtcClockReady( void )
+{
+	return 1UL;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulRtcClockEpoch( void )
+{
+	/* The calendar follows the simulated time. */
+	return ulSimRtcBase + ( uint32_t )( xTaskGetTickCount() / configTICK_RATE_HZ );
+}
+
+/*------------------------------------------------------------------*/
+void vRtcClockSetEpoch( uint32_t ulEpoch )
+{
+	ulSimRtcBase = ulEpoch - ( uint32_t )( xTaskGetTickCount() / configTICK_RATE_HZ );
+}
+
+/*------------------------------------------------------------------*/
+void vCycleCounterInit( void )
+{
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulCycleCounterGet( void )
+{
+	/* Simulated time scaled to SystemCoreClock, so reports read as on
+	 * target and virtual time gaps do not show up as latency. */
+	return ( uint32_t )( ullPortSimGetTimeNs() * ( SystemCoreClock / 1000000UL ) / 1000ULL );
+}
+
+/*------------------------------------------------------------------*/
+void vFlashRegionInit( void )
+{
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulFlashRegionErase( uint32_t ulSector )
+{
+	configASSERT( ulSector < flashREGION_SECTORS );
+
+	memset( &ucSimFlash[ ulSector * flashREGION_SECTOR_SIZE ], 0xFF, flashREGION_SECTOR_SIZE );
+	prvSimFlashSave( ulSector * flashREGION_SECTOR_SIZE, flashREGION_SECTOR_SIZE );
+	ulSimFlashErases++;
+
+	return 1UL;
+}
+
+/*------------------------------------------------------------------*/
+uint32_t ulFlashRegionWrite( uint32_t ulSector, uint32_t ulOffset, const void *pvData, size_t xLength )
+{
+	const uint8_t *pucData = ( const uint8_t * ) pvData;
+	uint32_t ulBase;
+	size_t x;
+
+	configASSERT( ulSector < flashREGION_SECTORS );
+	configASSERT( ( ( ulOffset | xLength ) & 3UL ) == 0 );
+	configASSERT( ( ulOffset + xLength ) <= flashREGION_SECTOR_SIZE );
+
+	ulBase = ( ulSector * flashREGION_SECTOR_SIZE ) + ulOffset;
+	ulSimFlashWrites++;
+
+	/* Power cut: the words up to one past the half make it, so a
+	 * record is usually left torn. */
+	if( ulSimFlashWrites == ulSimFlashCut )
+	{
+		xLength = ( ( xLength / 2 ) + 4 ) & ~( size_t ) 3;
+	}
+
+	for( x = 0; x < xLength; x++ )
+	{
+		ucSimFlash[ ulBase + x ] &= pucData[ x ];
+	}
+	prvSimFlashSave( ulBase, xLength );
+
+	if( ulSimFlashWrites == ulSimFlashCut )
+	{
+		fprintf( stderr, "\n== flash: power cut during write %u\n", ulSimFlashWrites );
+		fflush( stderr );
+		_exit( 3 );
+	}
+
+	return 1UL;
+}
+
+/*------------------------------------------------------------------*/
+void vFlashRegionRead( uint32_t ulSector, uint32_t ulOffset, void *pvData, size_t xLength )
+{
+	configASSERT( ulSector < flashREGION_SECTORS );
+	configASSERT( ( ulOffset + xLength ) <= flashREGION_SECTOR_SIZE );
+
+	memcpy( pvData, &ucSimFlash[ ( ulSector * flashREGION_SECTOR_SIZE ) + ulOffset ], xLength );
+}
+
+/*------------------------------------------------------------------*/
+void vLedPwmInit( void )
+{
+	size_t x;
+
+	for( x = 0; x < simLED_PWM_COUNT; x++ )
+	{
+		HAL_GPIO_WritePin( xSimLedPwm[ x ].pxPort, xSimLedPwm[ x ].usPin, GPIO_PIN_RESET );
+	}
+	bSimLedPwm = 1;
+}
+
+/*------------------------------------------------------------------*/
+void vLedPwmSet( GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, uint32_t ulPeriodUs, uint32_t ulOnUs )
+{
+	UBaseType_t uxSaved;
+	size_t x;
+
+	for( x = 0; x < simLED_PWM_COUNT; x++ )
+	{
+		if( ( xSimLedPwm[ x ].pxPort == GPIOx ) && ( xSimLedPwm[ x ].usPin == GPIO_Pin ) )
+		{
+			break;
+		}
+	}
+	configASSERT( x < simLED_PWM_COUNT );
+
+	/* A new setting starts a period, as the update event does. */
+	uxSaved = taskENTER_CRITICAL_FROM_ISR();
+	xSimLedPwm[ x ].ulPeriodUs = ulPeriodUs;
+	xSimLedPwm[ x ].ulOnUs = ulOnUs;
+	xSimLedPwm[ x ].ulStart = prvSimTick();
+	taskEXIT_CRITICAL_FROM_ISR( uxSaved );
+
+	/* The output follows at once, not at the next tick. */
+	if( bSimLedPwm != 0 )
+	{
+		prvSimLedPwmOutput( prvSimTick() );
+	}
+}
+
+/*------------------------------------------------------------------*/
+void vSimHalInit( int bEcho )
+{
+	bSimEcho = bEcho;
+
+	/* MX_GPIO_Init(): LEDs off, button released. */
+	memset( xSimGpio, 0, sizeof( xSimGpio ) );
+}
+
+/*------------------------------------------------------------------*/
+void vSimButtonAddPress( uint32_t ulStart, uint32_t ulLength )
+{
+	if( xSimPressCount < simBUTTON_PRESS_COUNT )
+	{
+		xSimPress[ xSimPressCount ].ulStart = ulStart;
+		xSimPress[ xSimPressCount ].ulEnd = ulStart + ulLength;
+		xSimPressCount++;
+	}
+}
+
+/*------------------------------------------------------------------*/
+void vSimHalTickIsr( void )
+{
+	uint32_t ulTick = prvSimTick();
+	UBaseType_t uxSaved;
+	uint32_t ulOld, ulNew;
+	size_t x;
+	int bPressed = 0;
+
+	for( x = 0; x < xSimPressCount; x++ )
+	{
+		if( ( ulTick >= xSimPress[ x ].ulStart ) && ( ulTick < xSimPress[ x ].ulEnd ) )
+		{
+			bPressed = 1;
+		}
+	}
+
+	/* The NUCLEO user button reads high while pressed. */
+	uxSaved = taskENTER_CRITICAL_FROM_ISR();
+	ulOld = USER_Btn_GPIO_Port->IDR;
+	ulNew = bPressed ? ( ulOld | USER_Btn_Pin ) : ( ulOld & ~( uint32_t ) USER_Btn_Pin );
+	USER_Btn_GPIO_Port->IDR = ulNew;
+	taskEXIT_CRITICAL_FROM_ISR( uxSaved );
+
+	/* Trigger edge: EXTI line 13 pending, run its handler if enabled. */
+	if( ( ( ( ulNew & ~ulOld & ulSimExtiRising ) | ( ~ulNew & ulOld & ulSimExtiFalling ) ) & USER_Btn_Pin ) != 0 )
+	{
+		ulSimExtiPending |= USER_Btn_Pin;
+		if( bSimExtiEnabled != 0 )
+		{
+			EXTI15_10_IRQHandler();
+		}
+	}
+
+	if( bSimLedPwm != 0 )
+	{
+		prvSimLedPwmOutput( ulTick );
+	}
+}
+
+/*------------------------------------------------------------------*/
+void vSimFlashOpen( const char *pcFile, uint32_t ulCutWrite )
+{
+	/* A new flash region is erased. */
+	memset( ucSimFlash, 0xFF, sizeof( ucSimFlash ) );
+	ulSimFlashCut = ulCutWrite;
+
+	if( pcFile != NULL )
+	{
+		pxSimFlashFile = fopen( pcFile, "r+b" );
+		if( pxSimFlashFile != NULL )
+		{
+			if( fread( ucSimFlash, 1, sizeof( ucSimFlash ), pxSimFlashFile ) != sizeof( ucSimFlash ) )
+			{
+				fprintf( stderr, "== flash: %s is shorter than the region, the rest is erased\n", pcFile );
+			}
+		}
+		else
+		{
+			pxSimFlashFile = fopen( pcFile, "w+b" );
+		}
+
+		if( pxSimFlashFile == NULL )
+		{
+			perror( pcFile );
+			exit( 2 );
+		}
+		prvSimFlashSave( 0, sizeof( ucSimFlash ) );
+	}
+}
+
+/*------------------------------------------------------------------*/
+void vSimFlashGetStats( uint32_t *pulWrites, uint32_t *pulErases )
+{
+	*pulWrites = ulSimFlashWrites;
+	*pulErases = ulSimFlashErases;
+}
+
+/*------------------------------------------------------------------*/
+size_t xSimGetGpioEdges( const SimGpioEdge_t **ppxEdges, uint32_t *pulLost )
+{
+	*ppxEdges = xSimEdge;
+	*pulLost = ulSimEdgeLost;
+	return xSimEdgeCount;
+}
+
+/*------------------------------------------------------------------*/
+size_t xSimGetConsole( const char **ppcData, uint32_t *pulLost )
+{
+	*ppcData = cSimConsole;
+	*pulLost = ulSimConsoleLost;
+	return xSimConsoleCount;
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/
@@ -0,0 +1,292 @@
+/* Copyright 2022, Juan Manuel Cruz.
+ * All rights reserved.
+ *
+ * This file is part of Project => freertos_host_sim
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+/*--------------------------------------------------------------------*-
+
+    sim_main.c (Released 2022-06)
+
+--------------------------------------------------------------------
+
+    Entry point of the host simulation of one freertos_app_* project.
+
+    Does what Core/Src/main.c does after the CubeMX initialisation
+    (console engine, log drain task, appInit()), starts the scheduler
+    for the requested number of ticks and reports what was recorded.
+
+    usage: sim_<project> [-t ticks] [-s speed] [-q] [-b tick[:length],...]
+                         [-c console.txt] [-g gpio.csv] [-T trace.bin]
+                         [-f flash.bin] [-x write]
+
+      -t  ticks to simulate (default 10000, 0 = forever)
+      -s  times faster than real time (default 1, 0 = virtual time)
+      -q  do not echo the console to stdout
+      -b  user button presses (default length 100 ticks)
+      -c  write the recorded console to a file
+      -g  write the recorded GPIO edges as CSV (tick,port,pin,level)
+      -T  write the trace recorder buffer (build with
+          DEFS=-DtraceRECORDER_ENABLE=1), see Tools/trace_to_json.py
+      -f  keep the flash region in a file, from one run to the next
+      -x  power cut during that flash write (1 = first)
+
+    See readme.txt for project information.
+
+-*--------------------------------------------------------------------*/
+
+
+// ------ Includes -------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Demo includes. */
+#include "supporting_Functions.h"
+#include "uart_Tx.h"
+#include "run_Stats.h"
+#include "low_Power.h"
+#include "rtc_Clock.h"
+#include "trace_Recorder.h"
+
+/* Application includes. */
+#include "app.h"
+
+/* Simulation includes. */
+#include "sim_Hal.h"
+
+// ------ Macros and definitions ---------------------------------------
+#define simDEFAULT_TICKS		10000UL
+#define simDEFAULT_PRESS		100UL
+
+// ------ internal data declaration ------------------------------------
+
+// ------ internal functions declaration -------------------------------
+static void prvSimUsage( const char *pcName );
+static void prvSimParseButton( char *pcList );
+static ssize_t prvSimStdoutWrite( void *pvCookie, const char *pcData, size_t xLength );
+static void prvSimReport( double dSeconds, const char *pcConsoleFile, const char *pcGpioFile, const char *pcTraceFile );
+
+// ------ internal data definition -------------------------------------
+static const char *pcSimPortName = "ABCDEFGH";
+
+// ------ external data definition -------------------------------------
+
+// ------ internal functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+static void prvSimUsage( const char *pcName )
+{
+	fprintf( stderr, "usage: %s [-t ticks] [-s speed] [-q] [-b tick[:length],...] [-c console.txt] [-g gpio.csv] [-T trace.bin] [-f flash.bin] [-x write]\n", pcName );
+	exit( 2 );
+}
+
+/*------------------------------------------------------------------*/
+static void prvSimParseButton( char *pcList )
+{
+	char *pcItem, *pcLength;
+
+	for( pcItem = strtok( pcList, "," ); pcItem != NULL; pcItem = strtok( NULL, "," ) )
+	{
+		pcLength = strchr( pcItem, ':' );
+		vSimButtonAddPress( strtoul( pcItem, NULL, 0 ),
+							( pcLength != NULL ) ? strtoul( pcLength + 1, NULL, 0 ) : simDEFAULT_PRESS );
+	}
+}
+
+/*------------------------------------------------------------------*/
+static ssize_t prvSimStdoutWrite( void *pvCookie, const char *pcData, size_t xLength )
+{
+	( void ) pvCookie;
+
+	/* printf() on the target ends in _write() -> USART3: same here. */
+	return ( ssize_t ) xUartTxWrite( pcData, xLength );
+}
+
+/*------------------------------------------------------------------*/
+static void prvSimReport( double dSeconds, const char *pcConsoleFile, const char *pcGpioFile, const char *pcTraceFile )
+{
+	const SimGpioEdge_t *pxEdge;
+	const char *pcConsole;
+	const void *pvTrace;
+	uint32_t ulTrace, ulFlashWrites, ulFlashErases;
+	uint32_t ulTicks, ulIdleTicks, ulEdgeLost, ulConsoleLost;
+	uint32_t ulToggles[ simGPIO_PORTS ][ 16 ];
+	size_t xEdges, xConsole, x;
+	FILE *pxFile;
+	int iPort, iPin;
+
+	vPortSimGetTicks( &ulTicks, &ulIdleTicks );
+	xEdges = xSimGetGpioEdges( &pxEdge, &ulEdgeLost );
+	xConsole = xSimGetConsole( &pcConsole, &ulConsoleLost );
+
+	if( pcConsoleFile != NULL && ( pxFile = fopen( pcConsoleFile, "wb" ) ) != NULL )
+	{
+		fwrite( pcConsole, 1, xConsole, pxFile );
+		fclose( pxFile );
+	}
+
+	if( pcGpioFile != NULL && ( pxFile = fopen( pcGpioFile, "w" ) ) != NULL )
+	{
+		fprintf( pxFile, "tick,port,pin,level\n" );
+		for( x = 0; x < xEdges; x++ )
+		{
+			fprintf( pxFile, "%u,%c,%u,%u\n", pxEdge[ x ].ulTick, pcSimPortName[ pxEdge[ x ].ucPort ],
+					 pxEdge[ x ].ucPin, pxEdge[ x ].ucLevel );
+		}
+		fclose( pxFile );
+	}
+
+	ulTrace = ulTraceRecorderGet( &pvTrace );
+	if( pcTraceFile != NULL )
+	{
+		if( ulTrace == 0 )
+		{
+			fprintf( stderr, "== trace: recorder disabled, build with DEFS=-DtraceRECORDER_ENABLE=1\n" );
+		}
+		else if( ( pxFile = fopen( pcTraceFile, "wb" ) ) != NULL )
+		{
+			fwrite( pvTrace, 1, ulTrace, pxFile );
+			fclose( pxFile );
+			fprintf( stderr, "== trace: %u bytes written to %s\n", ulTrace, pcTraceFile );
+		}
+	}
+
+	memset( ulToggles, 0, sizeof( ulToggles ) );
+	for( x = 0; x < xEdges; x++ )
+	{
+		ulToggles[ pxEdge[ x ].ucPort ][ pxEdge[ x ].ucPin ]++;
+	}
+
+	fprintf( stderr, "\n== simulation: %u ticks in %.3f s (%.1fx real time), idle %.1f%%\n",
+			 ulTicks, dSeconds, ( dSeconds > 0.0 ) ? ( ulTicks / 1000.0 ) / dSeconds : 0.0,
+			 ( ulTicks != 0 ) ? ( 100.0 * ulIdleTicks ) / ulTicks : 0.0 );
+	fprintf( stderr, "== console: %zu bytes%s\n", xConsole, ( ulConsoleLost != 0 ) ? " (buffer full)" : "" );
+	fprintf( stderr, "== gpio: %zu edges%s\n", xEdges, ( ulEdgeLost != 0 ) ? " (buffer full)" : "" );
+	vSimFlashGetStats( &ulFlashWrites, &ulFlashErases );
+	if( ( ulFlashWrites | ulFlashErases ) != 0 )
+	{
+		fprintf( stderr, "== flash: %u writes, %u sector erases\n", ulFlashWrites, ulFlashErases );
+	}
+	for( iPort = 0; iPort < simGPIO_PORTS; iPort++ )
+	{
+		for( iPin = 0; iPin < 16; iPin++ )
+		{
+			if( ulToggles[ iPort ][ iPin ] != 0 )
+			{
+				fprintf( stderr, "==   P%c%-2d %u edges\n", pcSimPortName[ iPort ], iPin, ulToggles[ iPort ][ iPin ] );
+			}
+		}
+	}
+}
+
+// ------ external functions definition --------------------------------
+
+/*------------------------------------------------------------------*/
+int main( int argc, char *argv[] )
+{
+	cookie_io_functions_t xStdout = { NULL, prvSimStdoutWrite, NULL, NULL };
+	const char *pcConsoleFile = NULL, *pcGpioFile = NULL, *pcTraceFile = NULL, *pcFlashFile = NULL;
+	unsigned long ulTicks = simDEFAULT_TICKS, ulSpeed = 1, ulFlashCut = 0;
+	struct timespec xStart, xEnd;
+	int bEcho = 1;
+	int iOption;
+
+	while( ( iOption = getopt( argc, argv, "t:s:qb:c:g:T:f:x:" ) ) != -1 )
+	{
+		switch( iOption )
+		{
+			case 't': ulTicks = strtoul( optarg, NULL, 0 ); break;
+			case 's': ulSpeed = strtoul( optarg, NULL, 0 ); break;
+			case 'q': bEcho = 0; break;
+			case 'b': prvSimParseButton( optarg ); break;
+			case 'c': pcConsoleFile = optarg; break;
+			case 'g': pcGpioFile = optarg; break;
+			case 'T': pcTraceFile = optarg; break;
+			case 'f': pcFlashFile = optarg; break;
+			case 'x': ulFlashCut = strtoul( optarg, NULL, 0 ); break;
+			default: prvSimUsage( argv[ 0 ] );
+		}
+	}
+
+	vSimHalInit( bEcho );
+	vSimFlashOpen( pcFlashFile, ( uint32_t ) ulFlashCut );
+	stdout = fopencookie( NULL, "w", xStdout );
+	setvbuf( stdout, NULL, _IONBF, 0 );
+
+	vPortSimSetSpeed( ( uint32_t ) ulSpeed );
+	vPortSimSetRunTicks( ( uint32_t ) ulTicks );
+	vPortSimSetTickIsr( vSimHalTickIsr );
+
+	/* Same order as USER CODE 2 in Core/Src/main.c. */
+	vUartTxInit();
+	vLogDrainStart();
+	vRunStatsStart();
+	vRtcClockInit();
+#if( configUSE_TICKLESS_IDLE == 1 )
+	vLowPowerInit();
+#endif
+	appInit();
+
+	clock_gettime( CLOCK_MONOTONIC, &xStart );
+	vTaskStartScheduler();
+	clock_gettime( CLOCK_MONOTONIC, &xEnd );
+
+	prvSimReport( ( xEnd.tv_sec - xStart.tv_sec ) + ( xEnd.tv_nsec - xStart.tv_nsec ) / 1e9,
+				  pcConsoleFile, pcGpioFile, pcTraceFile );
+
+	/* Task threads are still parked inside the scheduler. */
+	fflush( stderr );
+	_exit( 0 );
+}
+
+/*------------------------------------------------------------------*/
+void vSimAssertCalled( const char *pcFile, unsigned long ulLine )
+{
+	fprintf( stderr, "\n== configASSERT failed: %s:%lu\n", pcFile, ulLine );
+	_exit( 1 );
+}
+
+/*------------------------------------------------------------------*/
+void vApplicationMallocFailedHook( void )
+{
+	vSimAssertCalled( __FILE__, __LINE__ );
+}
+
+/*------------------------------------------------------------------*-
+  ---- END OF FILE -------------------------------------------------
+-*------------------------------------------------------------------*/